@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// ns per instruction of short prepared operations, the case the small-vl path of the masked element loops is for.
+// usage: small_vl [iterations]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector_functions.h>
+
+using namespace softvector;
+
+constexpr unsigned VLEN = 128;
+constexpr unsigned RUNS = 6;
+
+alignas(64) static uint8_t V[32 * VLEN / 8];
+
+// best of RUNS runs, the minimum is the least disturbed by the host
+template <typename fn_t> double ns_per_call(fn_t fn, unsigned iterations) {
+    double best = 0;
+    for(unsigned run = 0; run < RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for(unsigned i = 0; i < iterations; i++) {
+            fn();
+            asm volatile("" ::: "memory");
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+        if(run == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 10000000;
+    V[0] = 0x5a;
+    vtype_t vtype(uint64_t{(0b010 << 3) | 0b001}); // e32 m2, vlmax 8
+    auto vadd_vv = prepare_vector_vector_op<VLEN, uint32_t>(0b000000, OPIVV, vtype, true, 8, 16, 24);
+    auto vadd_vv_masked = prepare_vector_vector_op<VLEN, uint32_t>(0b000000, OPIVV, vtype, false, 8, 16, 24);
+    auto vadd_vi = prepare_vector_imm_op<VLEN, uint32_t>(0b000000, OPIVI, vtype, true, 8, 16);
+    auto vfadd_vv = prepare_fp_vector_vector_op<VLEN, uint32_t>(0b000000, OPFVV, vtype, true, 8, 16, 24);
+    printf("VLEN=%u e32 m2, best of %u runs of %u, ns per instruction\n", VLEN, RUNS, iterations);
+    printf("%4s %10s %17s %10s %10s\n", "vl", "vadd.vv", "vadd.vv masked", "vadd.vi", "vfadd.vv");
+    for(uint64_t vl : {1, 2, 4, 8}) {
+        double vv = ns_per_call([&] { vadd_vv(V, vl, 0); }, iterations);
+        double vv_masked = ns_per_call([&] { vadd_vv_masked(V, vl, 0); }, iterations);
+        double vi = ns_per_call([&] { vadd_vi(V, vl, 0, 3); }, iterations);
+        double fvv = ns_per_call([&] { vfadd_vv(V, vl, 0); }, iterations);
+        printf("%4u %10.2f %17.2f %10.2f %10.2f\n", static_cast<unsigned>(vl), vv, vv_masked, vi, fvv);
+    }
+    return 0;
+}
@@ -90,27 +90,29 @@ template <typename T> T sig1(T);
 template <> inline uint32_t sig1(uint32_t x) { return rotr(x, 17) ^ rotr(x, 19) ^ shr(x, 10); }
 template <> inline uint64_t sig1(uint64_t x) { return rotr(x, 19) ^ rotr(x, 61) ^ shr(x, 6); }
 
-template <typename dest_elem_t, typename src_elem_t> dest_elem_t brev(src_elem_t vs2) {
-    constexpr dest_elem_t bits = sizeof(src_elem_t) * 8;
-    dest_elem_t result = 0;
-    for(size_t i = 0; i < bits; ++i) {
-        result <<= 1;
-        result |= (vs2 & 1);
-        vs2 >>= 1;
-    }
-    return result;
+// the bytes of x in reverse order, the host byte swap instructions
+template <typename T> T byte_swap(T x) {
+    if constexpr(sizeof(T) == 1)
+        return x;
+    else if constexpr(sizeof(T) == 2)
+        return __builtin_bswap16(x);
+    else if constexpr(sizeof(T) == 4)
+        return __builtin_bswap32(x);
+    else if constexpr(sizeof(T) == 8)
+        return __builtin_bswap64(x);
+    else
+        return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(x))) << 64 | __builtin_bswap64(static_cast<uint64_t>(x >> 64));
 }
+// the bits of each byte reversed by swapping nibbles, bit pairs and bits of all bytes at once
 template <typename dest_elem_t, typename src_elem_t> dest_elem_t brev8(src_elem_t vs2) {
-    constexpr unsigned byte_count = sizeof(src_elem_t);
-    dest_elem_t result = 0;
-    for(size_t i = 0; i < byte_count; ++i) {
-        dest_elem_t byte = (vs2 >> (i * 8)) & 0xFF;
-        byte = ((byte & 0xF0) >> 4) | ((byte & 0x0F) << 4);
-        byte = ((byte & 0xCC) >> 2) | ((byte & 0x33) << 2);
-        byte = ((byte & 0xAA) >> 1) | ((byte & 0x55) << 1);
-        result |= byte << (i * 8);
-    }
-    return result;
+    constexpr src_elem_t bytes = static_cast<src_elem_t>(~src_elem_t{0}) / 0xFF; // 0x01 in every byte
+    vs2 = ((vs2 >> 4) & bytes * 0x0F) | ((vs2 & bytes * 0x0F) << 4);
+    vs2 = ((vs2 >> 2) & bytes * 0x33) | ((vs2 & bytes * 0x33) << 2);
+    vs2 = ((vs2 >> 1) & bytes * 0x55) | ((vs2 & bytes * 0x55) << 1);
+    return vs2;
+}
+template <typename dest_elem_t, typename src_elem_t> dest_elem_t brev(src_elem_t vs2) {
+    return brev8<dest_elem_t>(byte_swap(vs2));
 }
 } // namespace softvector
 #endif // CRYPTO_UTIL_H
\ No newline at end of file
@@ -48,19 +48,9 @@ namespace softvector {
 
 vtype_t::vtype_t(uint32_t vtype_val) { underlying = (uint64_t)(vtype_val & 0x8000) << 32 | (vtype_val & ~0x8000); }
 vtype_t::vtype_t(uint64_t vtype_val) { underlying = vtype_val; }
-bool vtype_t::vill() { return underlying >> 63; }
-bool vtype_t::vma() { return (underlying >> 7) & 1; }
-bool vtype_t::vta() { return (underlying >> 6) & 1; }
-unsigned vtype_t::sew() {
-    uint8_t vsew = (underlying >> 3) & 0b111;
-    // pow(2, 3 + vsew);
-    return 1 << (3 + vsew);
-}
-double vtype_t::lmul() {
-    uint8_t vlmul = underlying & 0b111;
-    assert(vlmul != 0b100); // reserved encoding
-    int8_t signed_vlmul = (vlmul >> 2) ? 0b11111000 | vlmul : vlmul;
-    return pow(2, signed_vlmul);
+double vtype_t::lmul() const {
+    assert((underlying & 0b111) != 0b100); // reserved encoding
+    return ldexp(1.0, lmul_log2());
 }
 
 mask_bit_reference& mask_bit_reference::operator=(const bool new_value) {
@@ -86,123 +76,49 @@ vmask_view read_vmask(uint8_t* V, uint16_t VLEN, uint16_t elem_count, uint8_t re
     return {mask_start, elem_count};
 }
 
-std::function<uint128_t(uint128_t, uint128_t, uint128_t)> get_crypto_funct(unsigned funct6, unsigned vs1) {
+std::add_pointer_t<uint128_t(uint128_t, uint128_t, uint128_t)> find_crypto_funct(unsigned funct6, unsigned vs1) noexcept {
     switch(funct6) {
     case 0b101000: // VAES.VV
     case 0b101001: // VAES.VS
         switch(vs1) {
         case 0b00000: // VAESDM
-            return [](uint128_t state, uint128_t rkey, uint128_t) {
-                uint128_t sr = aes_shift_rows_inv(state);
-                uint128_t sb = aes_subbytes_inv(sr);
-                uint128_t ark = sb ^ rkey;
-                uint128_t mix = aes_mixcolumns_inv(ark);
-                return mix;
-            };
+            return crypto_funct<0b101000, 0b00000>;
         case 0b00001: // VAESDF
-            return [](uint128_t state, uint128_t rkey, uint128_t) {
-                uint128_t sr = aes_shift_rows_inv(state);
-                uint128_t sb = aes_subbytes_inv(sr);
-                uint128_t ark = sb ^ rkey;
-                return ark;
-            };
+            return crypto_funct<0b101000, 0b00001>;
         case 0b00010: // VAESEM
-            return [](uint128_t state, uint128_t rkey, uint128_t) {
-                uint128_t sb = aes_subbytes_fwd(state);
-                uint128_t sr = aes_shift_rows_fwd(sb);
-                uint128_t mix = aes_mixcolumns_fwd(sr);
-                uint128_t ark = mix ^ rkey;
-                return ark;
-            };
+            return crypto_funct<0b101000, 0b00010>;
         case 0b00011: // VAESEF
-            return [](uint128_t state, uint128_t rkey, uint128_t) {
-                uint128_t sb = aes_subbytes_fwd(state);
-                uint128_t sr = aes_shift_rows_fwd(sb);
-                uint128_t ark = sr ^ rkey;
-                return ark;
-            };
+            return crypto_funct<0b101000, 0b00011>;
         case 0b00111: // VAESZ
-            return [](uint128_t state, uint128_t rkey, uint128_t) {
-                uint128_t ark = state ^ rkey;
-                return ark;
-            };
+            return crypto_funct<0b101000, 0b00111>;
         case 0b10000: // VSM4R
-            throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+            return nullptr;
         case 0b10001: // VGMUL
-            return [](uint128_t vd, uint128_t vs2, uint128_t) {
-                uint128_t Y = brev8<uint128_t>(vd);
-                uint128_t H = brev8<uint128_t>(vs2);
-                uint128_t Z = 0;
-                for(size_t bit = 0; bit < 128; bit++) {
-                    if((Y >> bit) & 1)
-                        Z ^= H;
-                    bool reduce = (H >> 127) & 1;
-                    H = H << 1;
-                    if(reduce)
-                        H ^= 0x87;
-                }
-                uint128_t result = brev8<uint128_t>(Z);
-                return result;
-            };
+            return crypto_funct<0b101000, 0b10001>;
         default:
-            throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+            return nullptr;
         }
     case 0b100000: // VSM3ME
     case 0b100001: // VSM4K
-        throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+        return nullptr;
     case 0b100010: // VAESKF1
-        return [](uint128_t vd, uint128_t vs2, uint128_t r) {
-            uint32_t k0 = (vs2 >> 32 * 0) & std::numeric_limits<uint32_t>::max();
-            uint32_t k1 = (vs2 >> 32 * 1) & std::numeric_limits<uint32_t>::max();
-            uint32_t k2 = (vs2 >> 32 * 2) & std::numeric_limits<uint32_t>::max();
-            uint32_t k3 = (vs2 >> 32 * 3) & std::numeric_limits<uint32_t>::max();
-            uint32_t w0 = aes_subword_fwd(aes_rotword(k3)) ^ aes_decode_rcon(r) ^ k0;
-            uint32_t w1 = w0 ^ k1;
-            uint32_t w2 = w1 ^ k2;
-            uint32_t w3 = w2 ^ k3;
-            uint128_t result = (uint128_t(w3) << 96) | (uint128_t(w2) << 64) | (uint128_t(w1) << 32) | (uint128_t(w0));
-            return result;
-        };
+        return crypto_funct<0b100010, 0>;
     case 0b101010: // VAESKF2
-        return [](uint128_t vd, uint128_t vs2, uint128_t r) {
-            uint32_t k0 = (vs2 >> 32 * 0) & std::numeric_limits<uint32_t>::max();
-            uint32_t k1 = (vs2 >> 32 * 1) & std::numeric_limits<uint32_t>::max();
-            uint32_t k2 = (vs2 >> 32 * 2) & std::numeric_limits<uint32_t>::max();
-            uint32_t k3 = (vs2 >> 32 * 3) & std::numeric_limits<uint32_t>::max();
-            uint32_t rkb0 = (vd >> 32 * 0) & std::numeric_limits<uint32_t>::max();
-            uint32_t rkb1 = (vd >> 32 * 1) & std::numeric_limits<uint32_t>::max();
-            uint32_t rkb2 = (vd >> 32 * 2) & std::numeric_limits<uint32_t>::max();
-            uint32_t rkb3 = (vd >> 32 * 3) & std::numeric_limits<uint32_t>::max();
-            uint32_t w0 = r & 1 ? aes_subword_fwd(k3) ^ rkb0 : aes_subword_fwd(aes_rotword(k3)) ^ aes_decode_rcon((r >> 1) - 1) ^ rkb0;
-            uint32_t w1 = w0 ^ rkb1;
-            uint32_t w2 = w1 ^ rkb2;
-            uint32_t w3 = w2 ^ rkb3;
-            uint128_t result = (uint128_t(w3) << 96) | (uint128_t(w2) << 64) | (uint128_t(w1) << 32) | (uint128_t(w0));
-            return result;
-        };
+        return crypto_funct<0b101010, 0>;
     case 0b101011: // VSM3C
-        throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+        return nullptr;
     case 0b101100: // VGHSH
-        return [](uint128_t Y, uint128_t vs2, uint128_t X) {
-            auto H = brev8<uint128_t>(vs2);
-            uint128_t Z = 0;
-            uint128_t S = brev8<uint128_t>(Y ^ X);
-            for(size_t bit = 0; bit < 128; bit++) {
-                if((S >> bit) & 1)
-                    Z ^= H;
-                bool reduce = (H >> 127) & 1;
-                H = H << 1;
-                if(reduce)
-                    H ^= 0x87;
-            }
-            uint128_t result = brev8<uint128_t>(Z);
-            return result;
-        };
+        return crypto_funct<0b101100, 0>;
     case 0b101101: // VSHA2MS
     case 0b101110: // VSHA2CH
     case 0b101111: // VSHA2CL
     default:
-        throw new std::runtime_error("Unknown funct6 in get_crypto_funct");
+        return nullptr;
     }
 }
+std::function<uint128_t(uint128_t, uint128_t, uint128_t)> get_crypto_funct(unsigned funct6, unsigned vs1) {
+    if(auto fn = find_crypto_funct(funct6, vs1))
+        return fn;
+    throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+}
 } // namespace softvector
\ No newline at end of file
@@ -48,11 +48,42 @@ struct vtype_t {
     uint64_t underlying;
     vtype_t(uint32_t vtype_val);
     vtype_t(uint64_t vtype_val);
-    unsigned sew();
-    double lmul();
-    bool vill();
-    bool vma();
-    bool vta();
+    unsigned sew() const { return 1U << (3 + ((underlying >> 3) & 0b111)); }
+    // log2 of LMUL, -3 (mf8) to 3 (m8)
+    int lmul_log2() const { return static_cast<int>((underlying & 0b111) ^ 0b100) - 0b100; }
+    double lmul() const;
+    bool vill() const { return underlying >> 63; }
+    bool vma() const { return (underlying >> 7) & 1; }
+    bool vta() const { return (underlying >> 6) & 1; }
+    // number of elements of eew bits in a register group of the current LMUL
+    uint64_t vlmax(unsigned vlen, unsigned eew) const {
+        return (lmul_log2() < 0 ? vlen >> -lmul_log2() : static_cast<uint64_t>(vlen) << lmul_log2()) / eew;
+    }
+};
+// vtype decoded once per vsetvl into the integer geometry the kernels need, LMUL is lmul_num / lmul_den
+struct vconfig_t {
+    vtype_t vtype;
+    uint64_t vlmax;
+    unsigned sew;
+    unsigned sew_bytes;
+    unsigned lmul_num;
+    unsigned lmul_den;
+    // log2 of EMUL = EEW / SEW * LMUL for EEW 8, 16, 32 and 64, values outside -3..3 are not a legal register group
+    int8_t emul_log2[4];
+    bool vma;
+    bool vta;
+    vconfig_t(vtype_t vtype, unsigned vlen)
+    : vtype(vtype)
+    , vlmax(vtype.vlmax(vlen, vtype.sew()))
+    , sew(vtype.sew())
+    , sew_bytes(vtype.sew() / 8)
+    , lmul_num(vtype.lmul_log2() < 0 ? 1 : 1U << vtype.lmul_log2())
+    , lmul_den(vtype.lmul_log2() < 0 ? 1U << -vtype.lmul_log2() : 1)
+    , vma(vtype.vma())
+    , vta(vtype.vta()) {
+        for(int eew_log2 = 0; eew_log2 < 4; eew_log2++)
+            emul_log2[eew_log2] = eew_log2 - static_cast<int>((vtype.underlying >> 3) & 0b111) + vtype.lmul_log2();
+    }
 };
 class mask_bit_reference {
     uint8_t* start;
@@ -69,9 +100,47 @@ struct vmask_view {
     size_t elem_count;
     mask_bit_reference operator[](size_t) const;
 };
+// outcome of a noexcept vector operation, lets the caller raise the trap instead of unwinding through the kernels
+struct vstatus_t {
+    enum code_t : uint8_t { OK, ILLEGAL_INSTRUCTION, FAULT };
+    code_t code;
+    // vxsat flag of fixed-point operations
+    bool vxsat;
+    // position of the instruction that raised the status if several instructions are executed in one call
+    uint16_t op_idx;
+    // element index of the first faulting access, only valid for FAULT
+    uint64_t fault_idx;
+    static constexpr vstatus_t ok(bool vxsat = false) { return {OK, vxsat, 0, 0}; }
+    static constexpr vstatus_t illegal(uint16_t op_idx = 0) { return {ILLEGAL_INSTRUCTION, false, op_idx, 0}; }
+    static constexpr vstatus_t fault(uint64_t idx, uint16_t op_idx = 0) { return {FAULT, false, op_idx, idx}; }
+    explicit operator bool() const { return code == OK; }
+};
+// decoded form of a single vector instruction, created once by one of the prepare_* functions and executed any number
+// of times afterwards without decoding funct6/funct3 again. It is only valid as long as vtype does not change.
+template <unsigned VLEN> struct prepared_op {
+    // scalar carries rs1/imm for the .vx/.vi/.vf forms, rm the rounding mode (frm for FP, vxrm for fixed-point)
+    using exec_fn_t = vstatus_t (*)(uint8_t* V, const prepared_op& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t rm) noexcept;
+    // nullptr if the encoding passed to prepare_* is not supported
+    exec_fn_t exec = nullptr;
+    void (*elem_fn)() = nullptr;
+    vconfig_t cfg;
+    bool vm = false;
+    unsigned vd = 0;
+    unsigned vs2 = 0;
+    unsigned vs1 = 0;
+    // rm is taken from vxrm instead of frm
+    bool fixed_point = false;
+    // memory operations keep the access callback in elem_fn, the segment size in vs1 and pass core to the callback
+    void* core = nullptr;
+    vstatus_t operator()(uint8_t* V, uint64_t vl, uint64_t vstart, uint64_t scalar = 0, uint8_t rm = 0) const noexcept {
+        return exec ? exec(V, *this, vl, vstart, scalar, rm) : vstatus_t::illegal();
+    }
+};
 vmask_view read_vmask(uint8_t* V, uint16_t VLEN, uint16_t elem_count, uint8_t reg_idx = 0);
 template <unsigned VLEN> vmask_view read_vmask(uint8_t* V, uint16_t elem_count, uint8_t reg_idx = 0);
 std::function<uint128_t(uint128_t, uint128_t, uint128_t)> get_crypto_funct(unsigned funct6, unsigned vs1);
+// same as get_crypto_funct but returns nullptr for unsupported encodings instead of throwing
+uint128_t (*find_crypto_funct(unsigned funct6, unsigned vs1) noexcept)(uint128_t, uint128_t, uint128_t);
 
 template <typename dest_elem_t, typename src_elem_t = dest_elem_t> dest_elem_t brev(src_elem_t vs2);
 template <typename dest_elem_t, typename src_elem_t = dest_elem_t> dest_elem_t brev8(src_elem_t vs2);
@@ -84,49 +153,132 @@ template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t>
 uint64_t vector_load_store_index(void* core, std::function<bool(void*, uint64_t, uint64_t, uint8_t*)> load_store_fn, uint8_t* V,
                                  uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2,
                                  uint8_t segment_size);
+// memory access callback of the try_* variants, returns false if the access faults
+using load_store_fn_t = bool (*)(void* core, uint64_t addr, uint64_t length, uint8_t* data) noexcept;
+template <unsigned VLEN, typename eew_t>
+vstatus_t try_vector_load_store(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm,
+                                uint8_t vd, uint64_t rs1, uint8_t segment_size, int64_t stride = 0, bool use_stride = false) noexcept;
+template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t>
+vstatus_t try_vector_load_store_index(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
+                                      bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2, uint8_t segment_size) noexcept;
+// unit-stride (segment) load or store, depending on load_store_fn, the base address is passed as scalar on execution
+template <unsigned VLEN, typename eew_t>
+prepared_op<VLEN> prepare_load_store_op(void* core, load_store_fn_t load_store_fn, vtype_t vtype, bool vm, unsigned vd,
+                                        uint8_t segment_size = 1) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
 void vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                       unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = src2_elem_t>
+void vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+prepared_op<VLEN> prepare_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                           unsigned vs1) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
 void vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                    unsigned vs2, typename std::make_signed<src1_elem_t>::type imm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = src2_elem_t>
+void vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                   typename std::make_signed<src1_elem_t>::type imm);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+prepared_op<VLEN> prepare_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept;
 template <unsigned VLEN, typename elem_t>
 void vector_vector_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd,
                          unsigned vs2, unsigned vs1, signed carry);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void vector_vector_carry(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1, signed carry);
 template <unsigned VLEN, typename elem_t>
 void vector_imm_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
                       typename std::make_signed<elem_t>::type imm, signed carry);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void vector_imm_carry(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
+                      typename std::make_signed<elem_t>::type imm, signed carry);
+// vadc/vsbc and vmadc/vmsbc of the same operands in one pass for multi-precision arithmetic: the sums (differences) go to vd, the
+// carry (borrow) outs to the mask register vcarry. The sources are read before the results are written, so vcarry may be v0 to feed
+// the next step of the chain. funct6 selects VADC or VSBC
+template <unsigned VLEN, typename elem_t>
+void vector_vector_carry_chain(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry,
+                               unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void vector_vector_carry_chain(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry, unsigned vs2,
+                               unsigned vs1);
+template <unsigned VLEN, typename elem_t>
+void vector_imm_carry_chain(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry,
+                            unsigned vs2, typename std::make_signed<elem_t>::type imm);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void vector_imm_carry_chain(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry, unsigned vs2,
+                            typename std::make_signed<elem_t>::type imm);
 template <unsigned VLEN, typename scr_elem_t>
 void vector_vector_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1);
 template <unsigned VLEN, typename scr_elem_t>
 void vector_imm_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm);
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t>
 void vector_unary_op(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2);
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src2_elem_t = dest_elem_t>
+void vector_unary_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2);
 template <unsigned VLEN, typename elem_t>
 void mask_vector_vector_op(uint8_t* V, unsigned funct, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                            unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void mask_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                                unsigned vs1) noexcept;
 template <unsigned VLEN, typename elem_t>
 void mask_vector_imm_op(uint8_t* V, unsigned funct, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                         unsigned vs2, typename std::make_signed<elem_t>::type imm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void mask_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                        typename std::make_signed<elem_t>::type imm);
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept;
+template <unsigned VLEN, typename elem_t>
 void carry_vector_vector_op(uint8_t* V, unsigned funct, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                             unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void carry_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1);
 template <unsigned VLEN, typename elem_t>
 void carry_vector_imm_op(uint8_t* V, unsigned funct, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                          typename std::make_signed<elem_t>::type imm);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void carry_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                         typename std::make_signed<elem_t>::type imm);
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
 bool sat_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
                           unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = dest_elem_t>
+bool sat_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm, unsigned vd, unsigned vs2,
+                          unsigned vs1);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+prepared_op<VLEN> prepare_sat_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                               unsigned vs1) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
 bool sat_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
                        unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = dest_elem_t>
+bool sat_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm, unsigned vd, unsigned vs2,
+                       typename std::make_signed<src1_elem_t>::type imm);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+prepared_op<VLEN> prepare_sat_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src_elem_t = dest_elem_t>
 void vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                    unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+void vector_red_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+prepared_op<VLEN> prepare_vector_red_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                        unsigned vs1) noexcept;
 template <unsigned VLEN>
 void mask_mask_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3>
+void mask_mask_op(uint8_t* V, uint64_t vl, uint64_t vstart, unsigned vd, unsigned vs2, unsigned vs1);
 template <unsigned VLEN> uint64_t vcpop(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vs2);
 template <unsigned VLEN> uint64_t vfirst(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vs2);
 template <unsigned VLEN> void mask_set_op(uint8_t* V, unsigned enc, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2);
+template <unsigned VLEN, unsigned ENC> void mask_set_op(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2);
 template <unsigned VLEN, typename src_elem_t>
 void viota(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2);
 template <unsigned VLEN, typename src_elem_t> void vid(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd);
@@ -149,38 +301,106 @@ template <unsigned VLEN> void vector_whole_move(uint8_t* V, unsigned vd, unsigne
 template <unsigned VLEN, typename dest_elem_t, typename src_elem_t = dest_elem_t>
 void fp_vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                       unsigned vs2, unsigned vs1, uint8_t rm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+void fp_vector_red_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                      uint8_t rm);
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+prepared_op<VLEN> prepare_fp_vector_red_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                           unsigned vs1) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
 void fp_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                          unsigned vs2, unsigned vs1, uint8_t rm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = src2_elem_t>
+void fp_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                         uint8_t rm);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+prepared_op<VLEN> prepare_fp_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                              unsigned vs1) noexcept;
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
 void fp_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                       unsigned vs2, src1_elem_t imm, uint8_t rm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+          typename src1_elem_t = src2_elem_t>
+void fp_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, src1_elem_t imm,
+                      uint8_t rm);
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+prepared_op<VLEN> prepare_fp_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept;
 template <unsigned VLEN, typename elem_t>
 void fp_vector_unary_op(uint8_t* V, unsigned encoding_space, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm,
                         unsigned vd, unsigned vs2, uint8_t rm);
+template <unsigned VLEN, unsigned ENCODING_SPACE, unsigned UNARY_OP, typename elem_t>
+void fp_vector_unary_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm);
 template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
 void fp_vector_unary_w(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                        uint8_t rm);
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_w(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm);
 template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
 void fp_vector_unary_n(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                        uint8_t rm);
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_n(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm);
 template <unsigned VLEN, typename elem_t>
 void mask_fp_vector_vector_op(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                               unsigned vs1, uint8_t rm);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void mask_fp_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                              uint8_t rm);
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_fp_vector_vector_op(unsigned funct6, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                                   unsigned vs1) noexcept;
 template <unsigned VLEN, typename elem_t>
 void mask_fp_vector_imm_op(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                            elem_t imm, uint8_t rm);
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void mask_fp_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, elem_t imm,
+                           uint8_t rm);
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_fp_vector_imm_op(unsigned funct6, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept;
 template <unsigned VLEN, unsigned EGS>
 void vector_vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
                           unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned VS1, unsigned EGS>
+void vector_vector_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1);
 template <unsigned VLEN, unsigned EGS>
 void vector_scalar_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
                           unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned VS1, unsigned EGS>
+void vector_scalar_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2);
 template <unsigned VLEN, unsigned EGS>
 void vector_imm_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
                        uint8_t imm);
+template <unsigned VLEN, unsigned FUNCT6, unsigned EGS>
+void vector_imm_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, uint8_t imm);
 template <unsigned VLEN, unsigned EGS, typename elem_type_t>
 void vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1);
+template <unsigned VLEN, unsigned FUNCT6, unsigned EGS, typename elem_type_t>
+void vector_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1);
+// executes count prepared operations back to back, e.g. the vector instructions of a guest basic block. All of them have to be
+// prepared for the same vtype, scalars holds the scalar operand of each operation and may be nullptr if none takes one. Execution
+// stops at the first operation that does not return OK, its position is returned in op_idx. vstart applies to the first operation
+// only, vxsat and the softfloat exception flags are accumulated over the executed operations.
+template <unsigned VLEN>
+vstatus_t execute_block(uint8_t* V, const prepared_op<VLEN>* ops, const uint64_t* scalars, size_t count, uint64_t vl, uint64_t vstart,
+                        uint8_t frm, uint8_t vxrm) noexcept;
+// superinstructions for common instruction sequences of compiled RVV loops. They execute the whole sequence in one pass over
+// the elements and leave the same architectural state as the single instructions, also if an access faults. The op_idx of a
+// returned FAULT names the instruction of the sequence and fault_idx the element. Every instruction of the sequence starts at
+// vstart and leaves the elements below it untouched; a faulted sequence is resumed with the single instructions.
+// They are standalone helpers for a caller that recognized the sequence itself, not a fusion pass: execute_block does not substitute
+// them for prepared operations, and the intermediate registers (the loaded vs2, the compare result vd) are always written back, even
+// if no later instruction reads them.
+// vle<EEW> vs2, (rs1_load); vf<FUNCT6>.vf vd, scalar, vs2; vse<EEW> vd, (rs1_store) with EEW == SEW, e.g. vfmacc.vf
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t, typename load_fn_t, typename store_fn_t>
+vstatus_t fused_load_fp_store(void* core, load_fn_t load_fn, store_fn_t store_fn, uint8_t* V, uint64_t vl, uint64_t vstart,
+                              const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2, uint64_t rs1_load, elem_t scalar,
+                              uint64_t rs1_store, uint8_t rm);
+// vle<EEW>[ff] vs2, (rs1); vms<FUNCT6>.vx vd, vs2, scalar; vfirst.m rd, vd with EEW == SEW (strlen, memchr), first receives rd.
+// For the fault-only-first load vl is reduced to the faulting element unless it is element 0
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t, typename load_fn_t>
+vstatus_t fused_load_compare_first(void* core, load_fn_t load_fn, uint8_t* V, uint64_t& vl, uint64_t vstart, const vconfig_t& cfg, bool vm,
+                                   unsigned vd, unsigned vs2, uint64_t rs1, elem_t scalar, bool fault_only_first, uint64_t& first);
 } // namespace softvector
 #include "vector_functions.hpp"
 #endif /* VECTOR_FUNCTIONS_H */
@@ -37,6 +37,7 @@ extern "C" {
 }
 #include "softfloat_types.h"
 #include "specialize.h"
+#include <array>
 #include <cassert>
 #include <crypto_util.h>
 #include <cstddef>
@@ -47,11 +48,15 @@ extern "C" {
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector_functions.h>
 #ifndef VECTOR_FUNCTIONS_H
 #error __FILE__ should only be included from vector_functions.h
 #endif
 #include <math.h>
+#if defined(__BMI2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 #ifdef __SIZEOF_INT128__
 template <> struct std::make_signed<__uint128_t> { using type = __int128_t; };
@@ -85,6 +90,60 @@ template <unsigned VLEN> vmask_view read_vmask(uint8_t* V, uint16_t vlmax, uint8
     assert(mask_start + vlmax / 8 <= V + VLEN * RFS / 8);
     return {mask_start, vlmax};
 }
+// word-granular access to a mask register, element idx is bit idx % 64 of word idx / 64
+template <unsigned VLEN> struct vmask_word_view {
+    static constexpr size_t word_count = (VLEN + 63) / 64;
+    uint8_t* start;
+    uint64_t get(size_t word_idx) const {
+        assert(word_idx < word_count);
+        uint64_t val = 0;
+        if constexpr(VLEN % 64 == 0)
+            std::memcpy(&val, start + word_idx * 8, 8);
+        else
+            std::memcpy(&val, start + word_idx * 8, std::min<size_t>(8, VLEN / 8 - word_idx * 8));
+        return val;
+    }
+    // only the bits set in sel are replaced
+    void set(size_t word_idx, uint64_t val, uint64_t sel) const {
+        assert(word_idx < word_count);
+        uint64_t new_val = (get(word_idx) & ~sel) | (val & sel);
+        if constexpr(VLEN % 64 == 0)
+            std::memcpy(start + word_idx * 8, &new_val, 8);
+        else
+            std::memcpy(start + word_idx * 8, &new_val, std::min<size_t>(8, VLEN / 8 - word_idx * 8));
+    }
+};
+template <unsigned VLEN> vmask_word_view<VLEN> get_vmask_words(uint8_t* V, uint8_t reg_idx = 0) {
+    uint8_t* mask_start = V + VLEN / 8 * reg_idx;
+    assert(mask_start + VLEN / 8 <= V + VLEN * RFS / 8);
+    return {mask_start};
+}
+// bits of word word_idx that belong to the elements [first, last)
+inline uint64_t mask_word_select(size_t word_idx, uint64_t first, uint64_t last) {
+    uint64_t lo = std::max<uint64_t>(first, word_idx * 64);
+    uint64_t hi = std::min<uint64_t>(last, word_idx * 64 + 64);
+    if(hi <= lo)
+        return 0;
+    uint64_t len = hi - lo;
+    return (len == 64 ? ~uint64_t(0) : (uint64_t(1) << len) - 1) << (lo - word_idx * 64);
+}
+// calls body(idx) for the active elements in [vstart, vl) in ascending order and stops early if it returns false. Fully active words
+// are walked as a plain range, all others only visit their set bits so sparse masks cost per active element rather than per element
+template <unsigned VLEN, typename body_t> bool for_each_active(uint8_t* V, uint64_t vl, uint64_t vstart, body_t body) {
+    auto mask_words = get_vmask_words<VLEN>(V);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t active = mask_words.get(word) & mask_word_select(word, vstart, vl);
+        if(active == ~uint64_t(0)) {
+            for(size_t idx = word * 64; idx < word * 64 + 64; idx++)
+                if(!body(idx))
+                    return false;
+        } else
+            for(; active; active &= active - 1)
+                if(!body(word * 64 + __builtin_ctzll(active)))
+                    return false;
+    }
+    return true;
+}
 
 template <typename elem_t> constexpr elem_t shift_mask() {
     static_assert(std::numeric_limits<elem_t>::is_integer, "shift_mask only supports integer types");
@@ -97,6 +156,72 @@ template <typename T> constexpr T agnostic_behavior(T val) {
     return val;
 #endif
 }
+// true if agnostic elements keep their value, the tail and masked-off updates are no-ops then
+constexpr bool agnostic_undisturbed() {
+#ifdef AGNOSTIC_ONES
+    return false;
+#else
+    return true;
+#endif
+}
+// masked operations with at most small_vl elements test their mask bits in the first byte of v0 directly instead of going through
+// the out-of-line vmask_view lookup per element
+constexpr uint64_t small_vl = 8;
+// the element loop of such an operation writing vd, result(vd_elem, idx) gives the value of active element idx
+template <unsigned VLEN, typename dest_elem_t, typename result_t>
+void small_vl_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, unsigned vd, result_t result) {
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    unsigned mask = V[0];
+    for(size_t idx = vstart; idx < vl; idx++)
+        if(mask >> idx & 1)
+            vd_elems[idx] = result(vd_elems[idx], idx);
+        else if(!agnostic_undisturbed() && cfg.vma)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+    if(!agnostic_undisturbed() && cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+// packs 64 bytes holding 0 or 1 into a mask word, eight at a time by gathering the low bits into the top byte of a product
+inline uint64_t pack_mask_bytes(const uint8_t* flags) {
+    uint64_t word = 0;
+    for(unsigned byte = 0; byte < 8; byte++) {
+        uint64_t chunk;
+        std::memcpy(&chunk, flags + byte * 8, 8);
+        word |= (chunk * 0x0102040810204080) >> 56 << (byte * 8);
+    }
+    return word;
+}
+// writes the results of a mask producing operation for one word of vd, inactive elements stay undisturbed unless mask agnostic
+// elements are filled with ones
+template <unsigned VLEN>
+void merge_mask_word(const vmask_word_view<VLEN>& vd_words, size_t word, uint64_t results, uint64_t body, uint64_t active, bool vma) {
+    if(!agnostic_undisturbed() && vma)
+        vd_words.set(word, results | (body & ~active), body);
+    else
+        vd_words.set(word, results, active);
+}
+template <unsigned VLEN> void mask_tail_agnostic(const vmask_word_view<VLEN>& vd_words, uint64_t vl, bool vta) {
+    if(!agnostic_undisturbed() && vta)
+        for(size_t word = vl / 64; word < vd_words.word_count; word++)
+            vd_words.set(word, ~uint64_t(0), mask_word_select(word, vl, VLEN));
+}
+// expands the 8 bits of a mask byte into lanes that are all ones for active and all zeros for inactive elements
+template <typename lane_t> void expand_vmask_byte(uint8_t mask_byte, lane_t* lanes) {
+    // bit i of the mask byte selects bit i of byte i, adding 0x7f moves it to the top bit without carrying into the next byte
+    uint64_t spread = ((mask_byte * 0x0101010101010101ULL & 0x8040201008040201ULL) + 0x7f7f7f7f7f7f7f7fULL) >> 7 & 0x0101010101010101ULL;
+    int8_t bytes[8];
+    spread *= 0xff;
+    memcpy(bytes, &spread, sizeof(bytes));
+    for(size_t i = 0; i < 8; i++)
+        lanes[i] = static_cast<lane_t>(bytes[i]);
+}
+// expand_vmask_byte for the first count bits of v0
+template <unsigned VLEN, typename lane_t> void expand_vmask(uint8_t* V, uint64_t count, lane_t* lanes) {
+    for(size_t byte = 0; byte < count / 8; byte++)
+        expand_vmask_byte(V[byte], lanes + byte * 8);
+    for(size_t idx = count & ~uint64_t(7); idx < count; idx++)
+        lanes[idx] = lane_t(0) - lane_t(V[idx / 8] >> (idx % 8) & 1);
+}
 
 enum FUNCT3 {
     OPIVV = 0b000,
@@ -127,550 +252,1704 @@ template <typename TO, typename FROM> constexpr TO sext(FROM val) {
     return static_cast<std::make_signed_t<TO>>(static_cast<std::make_signed_t<FROM>>(val));
 };
 
-template <unsigned VLEN, typename eew_t>
-uint64_t vector_load_store(void* core, std::function<bool(void*, uint64_t, uint64_t, uint8_t*)> load_store_fn, uint8_t* V, uint64_t vl,
-                           uint64_t vstart, vtype_t vtype, bool vm, uint8_t vd, uint64_t rs1, uint8_t segment_size, int64_t stride,
-                           bool use_stride) {
-    unsigned vlmax = VLEN * vtype.lmul() / vtype.sew();
+template <unsigned VLEN, typename eew_t, typename load_store_fn_t>
+vstatus_t vector_load_store_loop(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
+                                 bool vm, uint8_t vd, uint64_t rs1, uint8_t segment_size, int64_t stride, bool use_stride) {
+    unsigned vlmax = vtype.vlmax(VLEN, vtype.sew());
     auto emul_stride = std::max<unsigned>(vlmax, VLEN / (sizeof(eew_t) * 8));
     auto vd_view = get_vreg<VLEN, eew_t>(V, vd, emul_stride * segment_size);
     vmask_view mask_reg = read_vmask(V, VLEN, vlmax);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active) {
-            signed stride_offset = stride * idx;
-            auto seg_offset = use_stride ? 0 : segment_size * sizeof(eew_t) * idx;
-            for(size_t s_idx = 0; s_idx < segment_size; s_idx++) {
-                eew_t* addressed_elem = &vd_view[idx + emul_stride * s_idx];
-                uint64_t addr = rs1 + stride_offset + seg_offset + s_idx * sizeof(eew_t);
-                if(!load_store_fn(core, addr, sizeof(eew_t), reinterpret_cast<uint8_t*>(addressed_elem)))
-                    return idx;
+    uint64_t fault_idx = 0;
+    auto access = [&](size_t idx) {
+        signed stride_offset = stride * idx;
+        auto seg_offset = use_stride ? 0 : segment_size * sizeof(eew_t) * idx;
+        for(size_t s_idx = 0; s_idx < segment_size; s_idx++) {
+            eew_t* addressed_elem = &vd_view[idx + emul_stride * s_idx];
+            uint64_t addr = rs1 + stride_offset + seg_offset + s_idx * sizeof(eew_t);
+            if(!load_store_fn(core, addr, sizeof(eew_t), reinterpret_cast<uint8_t*>(addressed_elem))) {
+                fault_idx = idx;
+                return false;
             }
-        } else if(vtype.vma())
-            for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
-                vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
-    }
+        }
+        return true;
+    };
+    if(!vm && (agnostic_undisturbed() || !vtype.vma())) {
+        if(!for_each_active<VLEN>(V, vl, vstart, access))
+            return vstatus_t::fault(fault_idx);
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active) {
+                if(!access(idx))
+                    return vstatus_t::fault(fault_idx);
+            } else if(vtype.vma())
+                for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
+                    vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
+        }
     if(vtype.vta())
         for(size_t idx = vl; idx < vlmax; idx++)
             for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
                 vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
-    return 0;
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename eew_t>
+uint64_t vector_load_store(void* core, std::function<bool(void*, uint64_t, uint64_t, uint8_t*)> load_store_fn, uint8_t* V, uint64_t vl,
+                           uint64_t vstart, vtype_t vtype, bool vm, uint8_t vd, uint64_t rs1, uint8_t segment_size, int64_t stride,
+                           bool use_stride) {
+    auto status =
+        vector_load_store_loop<VLEN, eew_t>(core, load_store_fn, V, vl, vstart, vtype, vm, vd, rs1, segment_size, stride, use_stride);
+    return status.code == vstatus_t::FAULT ? status.fault_idx : 0;
+}
+template <unsigned VLEN, typename eew_t>
+vstatus_t try_vector_load_store(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm,
+                                uint8_t vd, uint64_t rs1, uint8_t segment_size, int64_t stride, bool use_stride) noexcept {
+    return vector_load_store_loop<VLEN, eew_t>(core, load_store_fn, V, vl, vstart, vtype, vm, vd, rs1, segment_size, stride, use_stride);
 }
 // eew for index registers, sew for data register
-template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t>
-uint64_t vector_load_store_index(void* core, std::function<bool(void*, uint64_t, uint64_t, uint8_t*)> load_store_fn, uint8_t* V,
-                                 uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2,
-                                 uint8_t segment_size) {
+template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t, typename load_store_fn_t>
+vstatus_t vector_load_store_index_loop(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
+                                       bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2, uint8_t segment_size) {
     // All load stores are ordered in this implementation
-    unsigned vlmax = VLEN * vtype.lmul() / vtype.sew();
+    unsigned vlmax = vtype.vlmax(VLEN, vtype.sew());
     auto emul_stride = std::max<unsigned>(vlmax, VLEN / (sizeof(sew_t) * 8));
     auto vd_view = get_vreg<VLEN, sew_t>(V, vd, emul_stride * segment_size);
     auto vs2_view = get_vreg<VLEN, eew_t>(V, vs2, vlmax);
     vmask_view mask_reg = read_vmask(V, VLEN, vlmax);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active) {
-            uint64_t index_offset = vs2_view[idx] & std::numeric_limits<std::conditional_t<XLEN == 32, uint32_t, uint64_t>>::max();
-            for(size_t s_idx = 0; s_idx < segment_size; s_idx++) {
-                sew_t* addressed_elem = &vd_view[idx + emul_stride * s_idx];
-                uint64_t addr = rs1 + index_offset + s_idx * sizeof(sew_t);
-                if(!load_store_fn(core, addr, sizeof(sew_t), reinterpret_cast<uint8_t*>(addressed_elem)))
-                    return idx;
+    uint64_t fault_idx = 0;
+    auto access = [&](size_t idx) {
+        uint64_t index_offset = vs2_view[idx] & std::numeric_limits<std::conditional_t<XLEN == 32, uint32_t, uint64_t>>::max();
+        for(size_t s_idx = 0; s_idx < segment_size; s_idx++) {
+            sew_t* addressed_elem = &vd_view[idx + emul_stride * s_idx];
+            uint64_t addr = rs1 + index_offset + s_idx * sizeof(sew_t);
+            if(!load_store_fn(core, addr, sizeof(sew_t), reinterpret_cast<uint8_t*>(addressed_elem))) {
+                fault_idx = idx;
+                return false;
             }
-        } else if(vtype.vma())
-            for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
-                vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
-    }
+        }
+        return true;
+    };
+    if(!vm && (agnostic_undisturbed() || !vtype.vma())) {
+        if(!for_each_active<VLEN>(V, vl, vstart, access))
+            return vstatus_t::fault(fault_idx);
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active) {
+                if(!access(idx))
+                    return vstatus_t::fault(fault_idx);
+            } else if(vtype.vma())
+                for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
+                    vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
+        }
     if(vtype.vta())
         for(size_t idx = vl; idx < vlmax; idx++)
             for(size_t s_idx = 0; s_idx < segment_size; s_idx++)
                 vd_view[idx + emul_stride * s_idx] = agnostic_behavior(vd_view[idx + emul_stride * s_idx]);
-    return 0;
+    return vstatus_t::ok();
+}
+template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t>
+uint64_t vector_load_store_index(void* core, std::function<bool(void*, uint64_t, uint64_t, uint8_t*)> load_store_fn, uint8_t* V,
+                                 uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2,
+                                 uint8_t segment_size) {
+    auto status =
+        vector_load_store_index_loop<XLEN, VLEN, eew_t, sew_t>(core, load_store_fn, V, vl, vstart, vtype, vm, vd, rs1, vs2, segment_size);
+    return status.code == vstatus_t::FAULT ? status.fault_idx : 0;
+}
+template <unsigned XLEN, unsigned VLEN, typename eew_t, typename sew_t>
+vstatus_t try_vector_load_store_index(void* core, load_store_fn_t load_store_fn, uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
+                                      bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2, uint8_t segment_size) noexcept {
+    return vector_load_store_index_loop<XLEN, VLEN, eew_t, sew_t>(core, load_store_fn, V, vl, vstart, vtype, vm, vd, rs1, vs2,
+                                                                  segment_size);
+}
+template <unsigned VLEN, typename eew_t>
+vstatus_t load_store_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t) noexcept {
+    auto load_store_fn = reinterpret_cast<load_store_fn_t>(op.elem_fn);
+    return vector_load_store_loop<VLEN, eew_t>(op.core, load_store_fn, V, vl, vstart, op.cfg.vtype, op.vm, op.vd, scalar, op.vs1, 0, false);
+}
+template <unsigned VLEN, typename eew_t>
+prepared_op<VLEN> prepare_load_store_op(void* core, load_store_fn_t load_store_fn, vtype_t vtype, bool vm, unsigned vd,
+                                        uint8_t segment_size) noexcept {
+    prepared_op<VLEN> op{load_store_exec<VLEN, eew_t>, reinterpret_cast<void (*)()>(load_store_fn), vconfig_t(vtype, VLEN), vm, vd, 0,
+                         segment_size};
+    op.core = core;
+    return op;
+}
+template <unsigned...> constexpr bool unsupported_encoding = false;
+// element operation selected at compile time, the body of the lambdas returned by get_funct
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+dest_elem_t funct(dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b000000) // VADD
+            return vs2 + vs1;
+        else if constexpr(FUNCT6 == 0b000001) // VANDN
+            return vs2 & ~vs1;
+        else if constexpr(FUNCT6 == 0b000010) // VSUB
+            return vs2 - vs1;
+        else if constexpr(FUNCT6 == 0b000011) // VRSUB
+            return vs1 - vs2;
+        else if constexpr(FUNCT6 == 0b000100) // VMINU
+            return std::min<src2_elem_t>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b000101) // VMIN
+            return std::min<std::make_signed_t<src2_elem_t>>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b000110) // VMAXU
+            return std::max<src2_elem_t>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b000111) // VMAX
+            return std::max<std::make_signed_t<src2_elem_t>>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b001001) // VAND
+            return vs1 & vs2;
+        else if constexpr(FUNCT6 == 0b001010) // VOR
+            return vs1 | vs2;
+        else if constexpr(FUNCT6 == 0b001011) // VXOR
+            return vs1 ^ vs2;
+        else if constexpr(FUNCT6 == 0b010000) // VADC
+            return vs2 + vs1;
+        else if constexpr(FUNCT6 == 0b010010) // VSBC
+            return static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2) -
+                                                                static_cast<std::make_signed_t<src1_elem_t>>(vs1));
+        else if constexpr(FUNCT6 == 0b010100) { // VROR
+            constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
+            auto shamt = vs1 & shift_mask<src1_elem_t>();
+            return (vs2 >> shamt) | (vs2 << (bits - shamt));
+        } else if constexpr(FUNCT6 == 0b010101) { // VROL
+            if constexpr(FUNCT3 == OPIVI)
+                return funct<0b010100, FUNCT3, dest_elem_t, dest_elem_t, dest_elem_t>(vd, vs2, vs1);
+            else {
+                constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
+                auto shamt = vs1 & shift_mask<src1_elem_t>();
+                return (vs2 << shamt) | (vs2 >> (bits - shamt));
+            }
+        } else if constexpr(FUNCT6 == 0b100101) // VSLL
+            return vs2 << (vs1 & shift_mask<src2_elem_t>());
+        else if constexpr(FUNCT6 == 0b101000) // VSRL
+            return vs2 >> (vs1 & shift_mask<src2_elem_t>());
+        else if constexpr(FUNCT6 == 0b101001) // VSRA
+            return static_cast<std::make_signed_t<src2_elem_t>>(vs2) >> (vs1 & shift_mask<src2_elem_t>());
+        else if constexpr(FUNCT6 == 0b101100) // VNSRL
+            return vs2 >> (vs1 & shift_mask<src2_elem_t>());
+        else if constexpr(FUNCT6 == 0b101101) // VNSRA
+            return static_cast<std::make_signed_t<src2_elem_t>>(vs2) >> (vs1 & shift_mask<src2_elem_t>());
+        else if constexpr(FUNCT6 == 0b110101) // VWSLL
+            return static_cast<dest_elem_t>(vs2) << (vs1 & (shift_mask<dest_elem_t>()));
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        if constexpr(FUNCT6 == 0b100000) { // VDIVU
+            if(vs1 == 0)
+                return -1;
+            else
+                return vs2 / vs1;
+        } else if constexpr(FUNCT6 == 0b100001) { // VDIV
+            if(vs1 == 0)
+                return -1;
+            else if(vs2 == std::numeric_limits<std::make_signed_t<src2_elem_t>>::min() &&
+                    static_cast<std::make_signed_t<src1_elem_t>>(vs1) == -1)
+                return vs2;
+            else
+                return static_cast<std::make_signed_t<src2_elem_t>>(vs2) / static_cast<std::make_signed_t<src1_elem_t>>(vs1);
+        } else if constexpr(FUNCT6 == 0b100010) { // VREMU
+            if(vs1 == 0)
+                return vs2;
+            else
+                return vs2 % vs1;
+        } else if constexpr(FUNCT6 == 0b100011) { // VREM
+            if(vs1 == 0)
+                return vs2;
+            else if(vs2 == std::numeric_limits<std::make_signed_t<src2_elem_t>>::min() &&
+                    static_cast<std::make_signed_t<src1_elem_t>>(vs1) == -1)
+                return 0;
+            else
+                return static_cast<std::make_signed_t<src2_elem_t>>(vs2) % static_cast<std::make_signed_t<src1_elem_t>>(vs1);
+        } else if constexpr(FUNCT6 == 0b100100) // VMULHU
+            return (static_cast<twice_t<src2_elem_t>>(vs2) * static_cast<twice_t<src2_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
+        else if constexpr(FUNCT6 == 0b100101) // VMUL
+            return static_cast<std::make_signed_t<src2_elem_t>>(vs2) * static_cast<std::make_signed_t<src1_elem_t>>(vs1);
+        else if constexpr(FUNCT6 == 0b100110) // VMULHSU
+            return (sext<twice_t<src2_elem_t>>(vs2) * static_cast<twice_t<src2_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
+        else if constexpr(FUNCT6 == 0b100111) { // VMULH
+            if constexpr(std::is_same_v<dest_elem_t, src2_elem_t> && std::is_same_v<dest_elem_t, src1_elem_t>) {
+                // multiplied as signed, the unsigned SEW 8 operands promote to int and 0xff80 * 0xff80 overflows it
+                using signed_twice_t = std::make_signed_t<twice_t<src2_elem_t>>;
+                return static_cast<twice_t<src2_elem_t>>(sext<signed_twice_t>(vs2) * sext<signed_twice_t>(vs1)) >> sizeof(dest_elem_t) * 8;
+            } else
+                return (sext<twice_t<src2_elem_t>>(vs2) * sext<twice_t<src1_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
+        } else if constexpr(FUNCT6 == 0b101001) // VMADD
+            return vs1 * vd + vs2;
+        else if constexpr(FUNCT6 == 0b101011) // VNMSUB
+            return -1 * (vs1 * vd) + vs2;
+        else if constexpr(FUNCT6 == 0b101101) // VMACC
+            return vs1 * vs2 + vd;
+        else if constexpr(FUNCT6 == 0b101111) // VNMSAC
+            return -1 * (vs1 * vs2) + vd;
+        else if constexpr(FUNCT6 == 0b110000) // VWADDU
+            return static_cast<dest_elem_t>(vs2) + static_cast<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110001) // VWADD
+            return sext<dest_elem_t>(vs2) + sext<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110010) // VWSUBU
+            return static_cast<dest_elem_t>(vs2) - static_cast<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110011) // VWSUB
+            return sext<dest_elem_t>(vs2) - sext<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110100) // VWADDU.W
+            return static_cast<dest_elem_t>(vs2) + static_cast<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110101) // VWADD.W
+            return sext<dest_elem_t>(vs2) + sext<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110110) // VWSUBU.W
+            return static_cast<dest_elem_t>(vs2) - static_cast<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b110111) // VWSUB.W
+            return sext<dest_elem_t>(vs2) - sext<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b111000) // VWMULU
+            return (static_cast<dest_elem_t>(vs2) * static_cast<dest_elem_t>(vs1));
+        else if constexpr(FUNCT6 == 0b111010) // VWMULSU
+            return sext<dest_elem_t>(vs2) * static_cast<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b111011) // VWMUL
+            return sext<dest_elem_t>(vs2) * sext<dest_elem_t>(vs1);
+        else if constexpr(FUNCT6 == 0b111100) // VWMACCU
+            return static_cast<dest_elem_t>(vs1) * static_cast<dest_elem_t>(vs2) + vd;
+        else if constexpr(FUNCT6 == 0b111101) // VWMACC
+            return sext<dest_elem_t>(vs1) * sext<dest_elem_t>(vs2) + vd;
+        else if constexpr(FUNCT6 == 0b111110) // VWMACCUS
+            return static_cast<dest_elem_t>(vs1) * sext<dest_elem_t>(vs2) + vd;
+        else if constexpr(FUNCT6 == 0b111111) // VWMACCSU
+            return sext<dest_elem_t>(vs1) * static_cast<dest_elem_t>(vs2) + vd;
+        else if constexpr(FUNCT6 == 0b001100) { // VCLMUL
+            dest_elem_t output = 0;
+            for(size_t i = 0; i <= sizeof(dest_elem_t) * 8 - 1; i++) {
+                if((vs2 >> i) & 1)
+                    output = output ^ (vs1 << i);
+            }
+            return output;
+        } else if constexpr(FUNCT6 == 0b001101) { // VCLMULH
+            dest_elem_t output = 0;
+            for(size_t i = 1; i < sizeof(dest_elem_t) * 8; i++) {
+                if((vs2 >> i) & 1)
+                    output = output ^ (vs1 >> (sizeof(dest_elem_t) * 8 - i));
+            }
+            return output;
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in funct");
 }
 template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
-std::function<dest_elem_t(dest_elem_t, src2_elem_t, src1_elem_t)> get_funct(unsigned funct6, unsigned funct3) {
+std::add_pointer_t<dest_elem_t(dest_elem_t, src2_elem_t, src1_elem_t)> find_funct(unsigned funct6, unsigned funct3) noexcept {
     if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
         switch(funct6) {
         case 0b000000: // VADD
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 + vs1; };
+            return funct<0b000000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000001: // VANDN
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 & ~vs1; };
+            return funct<0b000001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000010: // VSUB
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 - vs1; };
+            return funct<0b000010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000011: // VRSUB
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 - vs2; };
+            return funct<0b000011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000100: // VMINU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return std::min<src2_elem_t>(vs2, vs1); };
+            return funct<0b000100, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000101: // VMIN
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return std::min<std::make_signed_t<src2_elem_t>>(vs2, vs1); };
+            return funct<0b000101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000110: // VMAXU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return std::max<src2_elem_t>(vs2, vs1); };
+            return funct<0b000110, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000111: // VMAX
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return std::max<std::make_signed_t<src2_elem_t>>(vs2, vs1); };
+            return funct<0b000111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001001: // VAND
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 & vs2; };
+            return funct<0b001001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001010: // VOR
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 | vs2; };
+            return funct<0b001010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001011: // VXOR
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 ^ vs2; };
+            return funct<0b001011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b010000: // VADC
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 + vs1; };
+            return funct<0b010000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b010010: // VSBC
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2) -
-                                                                    static_cast<std::make_signed_t<src1_elem_t>>(vs1));
-            };
+            return funct<0b010010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b010100: // VROR
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
-                auto shamt = vs1 & shift_mask<src1_elem_t>();
-                return (vs2 >> shamt) | (vs2 << (bits - shamt));
-            };
-        case 0b010101: { // VROL
+            return funct<0b010100, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
+        case 0b010101: // VROL
             if(funct3 == OPIVI)
-                return get_funct<dest_elem_t>(0b010100, funct3);
-            else
-                return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                    constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
-                    auto shamt = vs1 & shift_mask<src1_elem_t>();
-                    return (vs2 << shamt) | (vs2 >> (bits - shamt));
-                };
-        }
+                return funct<0b010101, OPIVI, dest_elem_t, src2_elem_t, src1_elem_t>;
+            return funct<0b010101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100101: // VSLL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 << (vs1 & shift_mask<src2_elem_t>()); };
+            return funct<0b100101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101000: // VSRL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 >> (vs1 & shift_mask<src2_elem_t>()); };
+            return funct<0b101000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101001: // VSRA
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<std::make_signed_t<src2_elem_t>>(vs2) >> (vs1 & shift_mask<src2_elem_t>());
-            };
+            return funct<0b101001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101100: // VNSRL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs2 >> (vs1 & shift_mask<src2_elem_t>()); };
+            return funct<0b101100, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101101: // VNSRA
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<std::make_signed_t<src2_elem_t>>(vs2) >> (vs1 & shift_mask<src2_elem_t>());
-            };
+            return funct<0b101101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110101: // VWSLL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs2) << (vs1 & (shift_mask<dest_elem_t>()));
-            };
+            return funct<0b110101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_funct");
+            return nullptr;
         }
     else if(funct3 == OPMVV || funct3 == OPMVX)
         switch(funct6) {
         case 0b100000: // VDIVU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) -> dest_elem_t {
-                if(vs1 == 0)
-                    return -1;
-                else
-                    return vs2 / vs1;
-            };
+            return funct<0b100000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100001: // VDIV
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) -> dest_elem_t {
-                if(vs1 == 0)
-                    return -1;
-                else if(vs2 == std::numeric_limits<std::make_signed_t<src2_elem_t>>::min() &&
-                        static_cast<std::make_signed_t<src1_elem_t>>(vs1) == -1)
-                    return vs2;
-                else
-                    return static_cast<std::make_signed_t<src2_elem_t>>(vs2) / static_cast<std::make_signed_t<src1_elem_t>>(vs1);
-            };
+            return funct<0b100001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100010: // VREMU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) -> dest_elem_t {
-                if(vs1 == 0)
-                    return vs2;
-                else
-                    return vs2 % vs1;
-            };
+            return funct<0b100010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100011: // VREM
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) -> dest_elem_t {
-                if(vs1 == 0)
-                    return vs2;
-                else if(vs2 == std::numeric_limits<std::make_signed_t<src2_elem_t>>::min() &&
-                        static_cast<std::make_signed_t<src1_elem_t>>(vs1) == -1)
-                    return 0;
-                else
-                    return static_cast<std::make_signed_t<src2_elem_t>>(vs2) % static_cast<std::make_signed_t<src1_elem_t>>(vs1);
-            };
+            return funct<0b100011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100100: // VMULHU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return (static_cast<twice_t<src2_elem_t>>(vs2) * static_cast<twice_t<src2_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
-            };
+            return funct<0b100100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100101: // VMUL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<std::make_signed_t<src2_elem_t>>(vs2) * static_cast<std::make_signed_t<src1_elem_t>>(vs1);
-            };
+            return funct<0b100101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100110: // VMULHSU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return (sext<twice_t<src2_elem_t>>(vs2) * static_cast<twice_t<src2_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
-            };
+            return funct<0b100110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100111: // VMULH
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return (sext<twice_t<src2_elem_t>>(vs2) * sext<twice_t<src1_elem_t>>(vs1)) >> sizeof(dest_elem_t) * 8;
-            };
+            return funct<0b100111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101001: // VMADD
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 * vd + vs2; };
+            return funct<0b101001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101011: // VNMSUB
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return -1 * (vs1 * vd) + vs2; };
+            return funct<0b101011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101101: // VMACC
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return vs1 * vs2 + vd; };
+            return funct<0b101101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101111: // VNMSAC
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return -1 * (vs1 * vs2) + vd; };
+            return funct<0b101111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110000: // VWADDU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs2) + static_cast<dest_elem_t>(vs1);
-            };
+            return funct<0b110000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110001: // VWADD
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) + sext<dest_elem_t>(vs1); };
+            return funct<0b110001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110010: // VWSUBU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs2) - static_cast<dest_elem_t>(vs1);
-            };
+            return funct<0b110010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110011: // VWSUB
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) - sext<dest_elem_t>(vs1); };
+            return funct<0b110011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110100: // VWADDU.W
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs2) + static_cast<dest_elem_t>(vs1);
-            };
+            return funct<0b110100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110101: // VWADD.W
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) + sext<dest_elem_t>(vs1); };
+            return funct<0b110101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110110: // VWSUBU.W
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs2) - static_cast<dest_elem_t>(vs1);
-            };
+            return funct<0b110110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110111: // VWSUB.W
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) - sext<dest_elem_t>(vs1); };
+            return funct<0b110111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111000: // VWMULU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return (static_cast<dest_elem_t>(vs2) * static_cast<dest_elem_t>(vs1));
-            };
+            return funct<0b111000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111010: // VWMULSU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) * static_cast<dest_elem_t>(vs1); };
+            return funct<0b111010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111011: // VWMUL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs2) * sext<dest_elem_t>(vs1); };
+            return funct<0b111011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111100: // VWMACCU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs1) * static_cast<dest_elem_t>(vs2) + vd;
-            };
+            return funct<0b111100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111101: // VWMACC
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) { return sext<dest_elem_t>(vs1) * sext<dest_elem_t>(vs2) + vd; };
+            return funct<0b111101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111110: // VWMACCUS
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return static_cast<dest_elem_t>(vs1) * sext<dest_elem_t>(vs2) + vd;
-            };
+            return funct<0b111110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111111: // VWMACCSU
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return sext<dest_elem_t>(vs1) * static_cast<dest_elem_t>(vs2) + vd;
-            };
+            return funct<0b111111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001100: // VCLMUL
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t output = 0;
-                for(size_t i = 0; i <= sizeof(dest_elem_t) * 8 - 1; i++) {
-                    if((vs2 >> i) & 1)
-                        output = output ^ (vs1 << i);
-                }
-                return output;
-            };
+            return funct<0b001100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001101: // VCLMULH
-            return [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t output = 0;
-                for(size_t i = 1; i < sizeof(dest_elem_t) * 8; i++) {
-                    if((vs2 >> i) & 1)
-                        output = output ^ (vs1 >> (sizeof(dest_elem_t) * 8 - i));
-                }
-                return output;
-            };
+            return funct<0b001101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_funct");
+            return nullptr;
         }
     else
-        throw new std::runtime_error("Unknown funct3 in get_funct");
-}
-template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-void vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                      unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]);
-        else if(vtype.vma())
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-    }
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-}
-template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-void vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                   unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm);
-        else if(vtype.vma())
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-    }
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-}
-template <unsigned VLEN, typename elem_t>
-void vector_vector_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd,
-                         unsigned vs2, unsigned vs1, signed carry) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, elem_t>(V, vd, vlmax);
-    auto fn = get_funct<elem_t, elem_t, elem_t>(funct6, funct3);
-    for(size_t idx = vstart; idx < vl; idx++)
-        vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]) + carry * mask_reg[idx];
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-}
-template <unsigned VLEN, typename elem_t>
-void vector_imm_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
-                      typename std::make_signed<elem_t>::type imm, signed carry) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, elem_t>(V, vd, vlmax);
-    auto fn = get_funct<elem_t, elem_t, elem_t>(funct6, funct3);
-    for(size_t idx = vstart; idx < vl; idx++)
-        vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm) + carry * mask_reg[idx];
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        return nullptr;
 }
-template <unsigned VLEN, typename scr_elem_t>
-void vector_vector_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, scr_elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = vs1_view[idx];
-        else
-            vd_view[idx] = vs2_view[idx];
-    }
+// the get_*_ptr factories throw for unknown encodings like get_* but return the plain function pointer the loops and prepared operations
+// call directly, get_* keep returning std::function for existing callers
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::add_pointer_t<dest_elem_t(dest_elem_t, src2_elem_t, src1_elem_t)> get_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_funct");
 }
-template <unsigned VLEN, typename scr_elem_t>
-void vector_imm_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = imm;
-        else
-            vd_view[idx] = vs2_view[idx];
-    }
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::function<dest_elem_t(dest_elem_t, src2_elem_t, src1_elem_t)> get_funct(unsigned funct6, unsigned funct3) {
+    return get_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
 }
-template <typename elem_t> std::function<bool(elem_t, elem_t)> get_mask_funct(unsigned funct6, unsigned funct3) {
+// LANES elements as a GCC vector, the compiler lowers it to the widest host vectors available (SSE, AVX2, AVX-512, NEON)
+template <typename elem_t, size_t LANES = 64 / sizeof(elem_t)> struct simd_vec {
+    typedef elem_t type __attribute__((vector_size(LANES * sizeof(elem_t))));
+    static constexpr size_t lanes = LANES;
+};
+template <typename vec_t> using simd_elem_t = std::decay_t<decltype(std::declval<vec_t>()[0])>;
+// lanes of a block for operands of mixed width, the widest operand fills 64 bytes
+template <typename dest_elem_t, typename src2_elem_t> constexpr size_t simd_block = 64 / std::max(sizeof(dest_elem_t), sizeof(src2_elem_t));
+// the operations with a simd_funct implementation for these element types, same results as funct. Besides the single width operations
+// these are the widening additions, subtractions and multiplies, their .w forms with a wide vs2, vwsll and the narrowing shifts. The
+// divisions, .vv only for SEW 8 and 16, are computed by simd_divide_loop instead
+template <typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+constexpr bool has_simd_funct(unsigned funct6, unsigned funct3) {
+    constexpr bool single_width = std::is_same_v<dest_elem_t, src2_elem_t> && std::is_same_v<dest_elem_t, src1_elem_t>;
+    constexpr bool widening = sizeof(dest_elem_t) == 2 * sizeof(src2_elem_t) && std::is_same_v<src2_elem_t, src1_elem_t>;
+    constexpr bool wide_vs2 = std::is_same_v<dest_elem_t, src2_elem_t> && sizeof(dest_elem_t) == 2 * sizeof(src1_elem_t);
+    constexpr bool narrowing = sizeof(src2_elem_t) == 2 * sizeof(dest_elem_t) && std::is_same_v<dest_elem_t, src1_elem_t>;
     if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
         switch(funct6) {
-        case 0b011000: // VMSEQ
-            return [](elem_t vs2, elem_t vs1) { return vs2 == vs1; };
-        case 0b011001: // VMSNE
-            return [](elem_t vs2, elem_t vs1) { return vs2 != vs1; };
-        case 0b011010: // VMSLTU
-            return [](elem_t vs2, elem_t vs1) { return vs2 < vs1; };
-        case 0b011011: // VMSLT
-            return [](elem_t vs2, elem_t vs1) {
-                return static_cast<std::make_signed_t<elem_t>>(vs2) < static_cast<std::make_signed_t<elem_t>>(vs1);
-            };
-        case 0b011100: // VMSLEU
-            return [](elem_t vs2, elem_t vs1) { return vs2 <= vs1; };
-        case 0b011101: // VMSLE
-            return [](elem_t vs2, elem_t vs1) {
-                return static_cast<std::make_signed_t<elem_t>>(vs2) <= static_cast<std::make_signed_t<elem_t>>(vs1);
-            };
-        case 0b011110: // VMSGTU
-            return [](elem_t vs2, elem_t vs1) { return vs2 > vs1; };
-        case 0b011111: // VMSGT
-            return [](elem_t vs2, elem_t vs1) {
-                return static_cast<std::make_signed_t<elem_t>>(vs2) > static_cast<std::make_signed_t<elem_t>>(vs1);
-            };
-
+        case 0b000000: // VADD
+        case 0b000001: // VANDN
+        case 0b000010: // VSUB
+        case 0b000011: // VRSUB
+        case 0b000100: // VMINU
+        case 0b000101: // VMIN
+        case 0b000110: // VMAXU
+        case 0b000111: // VMAX
+        case 0b001001: // VAND
+        case 0b001010: // VOR
+        case 0b001011: // VXOR
+        case 0b100101: // VSLL
+        case 0b101000: // VSRL
+        case 0b101001: // VSRA
+            return single_width;
+        case 0b101100: // VNSRL
+        case 0b101101: // VNSRA
+            return narrowing;
+        case 0b110101: // VWSLL
+            return widening;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_mask_funct");
+            return false;
         }
-    else if(funct3 == OPMVV || funct3 == OPMVX)
+    if(funct3 == OPMVV || funct3 == OPMVX)
         switch(funct6) {
-        case 0b011000: // VMANDN
-            return [](elem_t vs2, elem_t vs1) { return vs2 & !vs1; };
-        case 0b011001: // VMAND
-            return [](elem_t vs2, elem_t vs1) { return vs2 & vs1; };
-        case 0b011010: // VMOR
-            return [](elem_t vs2, elem_t vs1) { return vs2 | vs1; };
-        case 0b011011: // VMXOR
-            return [](elem_t vs2, elem_t vs1) { return vs2 ^ vs1; };
-        case 0b011100: // VMORN
-            return [](elem_t vs2, elem_t vs1) { return vs2 | !vs1; };
-        case 0b011101: // VMNAND
-            return [](elem_t vs2, elem_t vs1) { return !(vs2 & vs1); };
-        case 0b011110: // VMNOR
-            return [](elem_t vs2, elem_t vs1) { return !(vs2 | vs1); };
-        case 0b011111: // VMXNOR
-            return [](elem_t vs2, elem_t vs1) { return !(vs2 ^ vs1); };
-        default:
-            throw new std::runtime_error("Unknown funct6 in get_mask_funct");
-        }
-    else
-        throw new std::runtime_error("Unknown funct3 in get_mask_funct");
-}
-template <unsigned VLEN, typename elem_t>
-void mask_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                           unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, VLEN, vd);
-    auto fn = get_mask_funct<elem_t>(funct6, funct3);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_mask_view[idx] = fn(vs2_view[idx], vs1_view[idx]);
-        else if(vtype.vma())
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+        case 0b100000: // VDIVU
+        case 0b100001: // VDIV
+        case 0b100010: // VREMU
+        case 0b100011: // VREM
+            return single_width && (funct3 == OPMVX || sizeof(dest_elem_t) <= 2);
+        case 0b100100: // VMULHU
+        case 0b100101: // VMUL
+        case 0b100110: // VMULHSU
+        case 0b100111: // VMULH
+        case 0b101001: // VMADD
+        case 0b101011: // VNMSUB
+        case 0b101101: // VMACC
+        case 0b101111: // VNMSAC
+            return single_width;
+        case 0b110000: // VWADDU
+        case 0b110001: // VWADD
+        case 0b110010: // VWSUBU
+        case 0b110011: // VWSUB
+        case 0b111000: // VWMULU
+        case 0b111010: // VWMULSU
+        case 0b111011: // VWMUL
+        case 0b111100: // VWMACCU
+        case 0b111101: // VWMACC
+        case 0b111110: // VWMACCUS
+        case 0b111111: // VWMACCSU
+            return widening;
+        case 0b110100: // VWADDU.W
+        case 0b110101: // VWADD.W
+        case 0b110110: // VWSUBU.W
+        case 0b110111: // VWSUB.W
+            return wide_vs2;
+        default:
+            return false;
+        }
+    return false;
+}
+// the shifts of simd_funct, a .vx/.vi shift count is passed as scalar to use the host shift by scalar
+constexpr bool has_simd_scalar_count(unsigned funct6, unsigned funct3) {
+    return (funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI) &&
+           (funct6 == 0b100101 || funct6 == 0b101000 || funct6 == 0b101001 || funct6 == 0b101100 || funct6 == 0b101101 ||
+            funct6 == 0b110101);
+}
+// the lanes of vec zero or sign extended (truncated) to the lanes of res, the host unpack/pack and extend instructions
+template <bool SIGNED, typename dest_vec_t, typename src_vec_t> void simd_convert(dest_vec_t& res, const src_vec_t& vec) {
+    if constexpr(sizeof(simd_elem_t<dest_vec_t>) > 2 * sizeof(simd_elem_t<src_vec_t>)) {
+        // GCC lowers an extension by 4 or 8 element wise, one doubling step at a time maps to the unpack instructions
+        constexpr size_t lanes = sizeof(src_vec_t) / sizeof(simd_elem_t<src_vec_t>);
+        typename simd_vec<twice_t<simd_elem_t<src_vec_t>>, lanes>::type twice;
+        simd_convert<SIGNED>(twice, vec);
+        simd_convert<SIGNED>(res, twice);
+    } else if constexpr(sizeof(simd_elem_t<src_vec_t>) > 2 * sizeof(simd_elem_t<dest_vec_t>)) {
+        // the same for a truncation, one halving step at a time maps to the pack instructions
+        constexpr size_t lanes = sizeof(src_vec_t) / sizeof(simd_elem_t<src_vec_t>);
+        typename simd_vec<twice_t<simd_elem_t<dest_vec_t>>, lanes>::type twice;
+        simd_convert<false>(twice, vec);
+        simd_convert<false>(res, twice);
+    } else if constexpr(SIGNED) {
+        constexpr size_t lanes = sizeof(src_vec_t) / sizeof(simd_elem_t<src_vec_t>);
+        using signed_src_vec_t = typename simd_vec<std::make_signed_t<simd_elem_t<src_vec_t>>, lanes>::type;
+        using signed_dest_vec_t = typename simd_vec<std::make_signed_t<simd_elem_t<dest_vec_t>>, lanes>::type;
+        res = (dest_vec_t)__builtin_convertvector((signed_src_vec_t)vec, signed_dest_vec_t);
+    } else
+        res = __builtin_convertvector(vec, dest_vec_t);
+}
+// vs1 is a vector or, for the shifts, a scalar count. The vectors are passed by reference, GCC warns about the ABI of 64 byte vectors
+// passed by value
+template <unsigned FUNCT6, unsigned FUNCT3, typename vec_t, typename src2_vec_t, typename src1_t>
+void simd_funct(vec_t& res, const src2_vec_t& vs2, const src1_t& vs1) {
+    using elem_t = simd_elem_t<vec_t>;
+    using src2_elem_t = simd_elem_t<src2_vec_t>;
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(elem_t);
+    using signed_vec_t = typename simd_vec<std::make_signed_t<elem_t>, lanes>::type;
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b000000) // VADD
+            res = vs2 + vs1;
+        else if constexpr(FUNCT6 == 0b000001) // VANDN
+            res = vs2 & ~vs1;
+        else if constexpr(FUNCT6 == 0b000010) // VSUB
+            res = vs2 - vs1;
+        else if constexpr(FUNCT6 == 0b000011) // VRSUB
+            res = vs1 - vs2;
+        else if constexpr(FUNCT6 == 0b000100) // VMINU
+            res = vs2 < vs1 ? vs2 : vs1;
+        else if constexpr(FUNCT6 == 0b000101) // VMIN
+            res = (signed_vec_t)vs2 < (signed_vec_t)vs1 ? vs2 : vs1;
+        else if constexpr(FUNCT6 == 0b000110) // VMAXU
+            res = vs2 > vs1 ? vs2 : vs1;
+        else if constexpr(FUNCT6 == 0b000111) // VMAX
+            res = (signed_vec_t)vs2 > (signed_vec_t)vs1 ? vs2 : vs1;
+        else if constexpr(FUNCT6 == 0b001001) // VAND
+            res = vs1 & vs2;
+        else if constexpr(FUNCT6 == 0b001010) // VOR
+            res = vs1 | vs2;
+        else if constexpr(FUNCT6 == 0b001011) // VXOR
+            res = vs1 ^ vs2;
+        else if constexpr(FUNCT6 == 0b100101) // VSLL
+            res = vs2 << (vs1 & shift_mask<elem_t>());
+        else if constexpr(FUNCT6 == 0b101000) // VSRL
+            res = vs2 >> (vs1 & shift_mask<elem_t>());
+        else if constexpr(FUNCT6 == 0b101001) // VSRA
+            res = (vec_t)((signed_vec_t)vs2 >> (vs1 & shift_mask<elem_t>()));
+        else if constexpr(FUNCT6 == 0b101100 || FUNCT6 == 0b101101) { // VNSRL, VNSRA
+            using signed_src2_vec_t = typename simd_vec<std::make_signed_t<src2_elem_t>, lanes>::type;
+            src2_vec_t shifted;
+            auto shift = [&](const auto& shamt) {
+                if constexpr(FUNCT6 == 0b101100)
+                    shifted = vs2 >> shamt;
+                else
+                    shifted = (src2_vec_t)((signed_src2_vec_t)vs2 >> shamt);
+            };
+            if constexpr(std::is_integral_v<src1_t>)
+                shift(vs1 & shift_mask<src2_elem_t>());
+            else {
+                src2_vec_t shamt;
+                simd_convert<false>(shamt, vs1);
+                shift(shamt & shift_mask<src2_elem_t>());
+            }
+            simd_convert<false>(res, shifted);
+        } else if constexpr(FUNCT6 == 0b110101) { // VWSLL
+            vec_t wide;
+            simd_convert<false>(wide, vs2);
+            if constexpr(std::is_integral_v<src1_t>)
+                res = wide << (vs1 & shift_mask<elem_t>());
+            else {
+                vec_t shamt;
+                simd_convert<false>(shamt, vs1);
+                res = wide << (shamt & shift_mask<elem_t>());
+            }
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        if constexpr(FUNCT6 == 0b100100 || FUNCT6 == 0b100110 || FUNCT6 == 0b100111) { // VMULHU, VMULHSU, VMULH
+            // SEW 8 to 32, the operands are extended to twice the width: the high half of the product modulo 2^(2 * SEW) is the result
+            // for either signedness
+            typename simd_vec<twice_t<elem_t>, lanes>::type wide_vs2, wide_vs1;
+            simd_convert<FUNCT6 != 0b100100>(wide_vs2, vs2);
+            simd_convert<FUNCT6 == 0b100111>(wide_vs1, vs1);
+            simd_convert<false>(res, (wide_vs2 * wide_vs1) >> (sizeof(elem_t) * 8));
+        } else if constexpr(FUNCT6 == 0b100101) // VMUL
+            res = vs2 * vs1;
+        else if constexpr(FUNCT6 == 0b101001) // VMADD, res holds vd
+            res = vs1 * res + vs2;
+        else if constexpr(FUNCT6 == 0b101011) // VNMSUB, res holds vd
+            res = vs2 - vs1 * res;
+        else if constexpr(FUNCT6 == 0b101101) // VMACC, res holds vd
+            res += vs1 * vs2;
+        else if constexpr(FUNCT6 == 0b101111) // VNMSAC, res holds vd
+            res -= vs1 * vs2;
+        else if constexpr(FUNCT6 >= 0b110000 && FUNCT6 <= 0b110111) {
+            // VWADDU, VWADD, VWSUBU, VWSUB and their .w forms: bit 0 of funct6 selects sign extension, bit 1 the subtraction and bit 2
+            // a vs2 that is already wide
+            constexpr bool sign_extend = FUNCT6 & 0b001;
+            vec_t wide_vs2, wide_vs1;
+            if constexpr(FUNCT6 & 0b100)
+                wide_vs2 = vs2;
+            else
+                simd_convert<sign_extend>(wide_vs2, vs2);
+            simd_convert<sign_extend>(wide_vs1, vs1);
+            if constexpr(FUNCT6 & 0b010)
+                res = wide_vs2 - wide_vs1;
+            else
+                res = wide_vs2 + wide_vs1;
+        } else if constexpr(FUNCT6 >= 0b111000) {
+            // VWMULU, VWMULSU, VWMUL and the multiply-adds VWMACCU, VWMACC, VWMACCUS, VWMACCSU where res holds vd. The products are
+            // lane wise, the host dot product instructions sum neighbouring lanes and do not apply
+            constexpr bool signed_vs2 = FUNCT6 == 0b111010 || FUNCT6 == 0b111011 || FUNCT6 == 0b111101 || FUNCT6 == 0b111110;
+            constexpr bool signed_vs1 = FUNCT6 == 0b111011 || FUNCT6 == 0b111101 || FUNCT6 == 0b111111;
+            vec_t wide_vs2, wide_vs1;
+            simd_convert<signed_vs2>(wide_vs2, vs2);
+            simd_convert<signed_vs1>(wide_vs1, vs1);
+            if constexpr(FUNCT6 >= 0b111100)
+                res += wide_vs1 * wide_vs2;
+            else
+                res = wide_vs2 * wide_vs1;
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_funct");
+}
+// the simd_funct operations that read vd, res holds its block on entry
+constexpr bool has_simd_accumulator(unsigned funct6, unsigned funct3) {
+    return (funct3 == OPMVV || funct3 == OPMVX) &&
+           (funct6 == 0b101001 || funct6 == 0b101011 || funct6 == 0b101101 || funct6 == 0b101111 || funct6 >= 0b111100);
+}
+// the lanes of the block at idx set to all ones if active in v0, taken from lanes if the caller has them cached
+template <typename vec_t> void simd_active_lanes(vec_t& active, const uint8_t* V, size_t idx, const simd_elem_t<vec_t>* lanes) {
+    constexpr size_t block = sizeof(vec_t) / sizeof(simd_elem_t<vec_t>);
+    if(lanes)
+        memcpy(&active, lanes + idx, sizeof(vec_t));
+    else {
+        simd_elem_t<vec_t> expanded[block];
+        for(size_t byte = 0; byte < block / 8; byte++)
+            expand_vmask_byte(V[idx / 8 + byte], expanded + byte * 8);
+        memcpy(&active, expanded, sizeof(vec_t));
+    }
+}
+// runs an element operation over the body [vstart, vl) of vd. The aligned blocks of BLOCK lanes are computed by block_fn(idx, res)
+// with host vectors and blended with vd through the expanded v0 bits if masked, taken from lanes if the caller has them cached.
+// elem_fn(idx) is the result of an active element before the first and after the last full block, or of every element if ELEMENT_WISE
+template <unsigned VLEN, size_t BLOCK, bool ELEMENT_WISE = false, typename dest_elem_t, typename block_fn_t, typename elem_fn_t>
+void simd_body_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, const dest_elem_t* lanes,
+                    block_fn_t block_fn, elem_fn_t elem_fn) {
+    using vec_t = typename simd_vec<dest_elem_t, BLOCK>::type;
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    bool undisturbed = agnostic_undisturbed() || !cfg.vma;
+    auto single = [&](size_t idx) {
+        if(vm || V[idx / 8] >> (idx % 8) & 1)
+            vd_elems[idx] = elem_fn(idx);
+        else if(!undisturbed)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+    };
+    if(ELEMENT_WISE || (sizeof(dest_elem_t) >= 4 && !vm && !lanes && undisturbed)) {
+        // expanding the mask costs more than walking the active elements for the few wide lanes of a block
+        if(!vm && undisturbed)
+            for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
+                vd_elems[idx] = elem_fn(idx);
+                return true;
+            });
+        else
+            for(size_t idx = vstart; idx < vl; idx++)
+                single(idx);
+    } else if constexpr(!ELEMENT_WISE) {
+        size_t idx = vstart;
+        for(; idx < vl && idx % BLOCK; idx++)
+            single(idx);
+        for(; idx + BLOCK <= vl; idx += BLOCK) {
+            vec_t res;
+            block_fn(idx, res);
+            if(!vm) {
+                vec_t active, prev;
+                simd_active_lanes(active, V, idx, lanes);
+                memcpy(&prev, vd_elems + idx, sizeof(vec_t));
+                res = (res & active) | ((undisturbed ? prev : ~vec_t{}) & ~active);
+            }
+            memcpy(vd_elems + idx, &res, sizeof(vec_t));
+        }
+        for(; idx < vl; idx++)
+            single(idx);
+    }
+    if(!agnostic_undisturbed() && cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+// multiply-shift constants of a divisor that is the same for all elements (Granlund, Montgomery: Division by Invariant Integers
+// using Multiplication, figures 4.1 and 5.2). They hold for every nonzero divisor, the signed quotient of MIN / -1 wraps to MIN.
+// A zero divisor uses the constants of 1 with zero_mask setting all bits of the quotient, n - q * d then leaves the remainder n
+template <typename elem_t, bool SIGNED> struct invariant_divisor {
+    using signed_t = std::make_signed_t<elem_t>;
+    static constexpr unsigned bits = sizeof(elem_t) * 8;
+    elem_t magic;
+    elem_t sign_mask;
+    elem_t zero_mask;
+    unsigned pre_shift;
+    unsigned post_shift;
+    explicit invariant_divisor(elem_t d) {
+        zero_mask = d == 0 ? std::numeric_limits<elem_t>::max() : 0;
+        sign_mask = SIGNED && static_cast<signed_t>(d) < 0 ? std::numeric_limits<elem_t>::max() : 0;
+        elem_t abs_d = d == 0 ? 1 : SIGNED ? (d ^ sign_mask) - sign_mask : d;
+        // ceil(log2(abs_d))
+        unsigned l = abs_d == 1 ? 0 : bits - (__builtin_clzll(static_cast<uint64_t>(abs_d - 1)) - (64 - bits));
+        if constexpr(SIGNED) {
+            l = std::max(l, 1U);
+            magic = static_cast<elem_t>((twice_t<elem_t>(1) << (bits + l - 1)) / abs_d + 1);
+            pre_shift = 0;
+            post_shift = l - 1;
+        } else {
+            magic = static_cast<elem_t>((((twice_t<elem_t>(1) << l) - abs_d) << bits) / abs_d + 1);
+            pre_shift = std::min(l, 1U);
+            post_shift = l == 0 ? 0 : l - 1;
+        }
+    }
+    elem_t quotient(elem_t n) const {
+        if constexpr(SIGNED) {
+            elem_t high = funct<0b100111, OPMVV, elem_t, elem_t, elem_t>(0, n, magic); // VMULH
+            elem_t q = static_cast<elem_t>(static_cast<signed_t>(n + high) >> post_shift) + (n >> (bits - 1));
+            return ((q ^ sign_mask) - sign_mask) | zero_mask;
+        } else {
+            elem_t high = funct<0b100100, OPMVV, elem_t, elem_t, elem_t>(0, n, magic); // VMULHU
+            return static_cast<elem_t>((high + ((n - high) >> pre_shift)) >> post_shift) | zero_mask;
+        }
+    }
+    // the same with host vectors, SEW 8 to 32
+    template <typename vec_t> void quotient(vec_t& q, const vec_t& n) const {
+        using signed_vec_t = typename simd_vec<signed_t, sizeof(vec_t) / sizeof(elem_t)>::type;
+        vec_t high;
+        if constexpr(SIGNED) {
+            simd_funct<0b100111, OPMVV>(high, n, magic - vec_t{});
+            q = (vec_t)((signed_vec_t)(n + high) >> post_shift) + (n >> (bits - 1));
+            q = ((q ^ sign_mask) - sign_mask) | zero_mask;
+        } else {
+            simd_funct<0b100100, OPMVV>(high, n, magic - vec_t{});
+            q = ((high + ((n - high) >> pre_shift)) >> post_shift) | zero_mask;
+        }
+    }
+};
+// the quotients of the lanes of n and d for SEW 8 and 16 through host float vectors, which divide where host integer vectors cannot.
+// n / d is a multiple of 1 / d and the rounding error of at most n / d * 2^-24 < 1 / d never reaches the next integer, so the
+// truncated float quotient is the exact one. MIN / -1 truncates back to MIN, zero divisors are replaced by 1 and set all bits
+template <bool SIGNED, typename vec_t> void simd_fp_quotient(vec_t& q, const vec_t& n, const vec_t& d) {
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(simd_elem_t<vec_t>);
+    using int_vec_t = typename simd_vec<int32_t, lanes>::type;
+    using float_vec_t = typename simd_vec<float, lanes>::type;
+    vec_t zero = (vec_t)(d == 0);
+    int_vec_t wide_n, wide_d;
+    simd_convert<SIGNED>(wide_n, n);
+    simd_convert<SIGNED>(wide_d, d - zero);
+    float_vec_t quotient = __builtin_convertvector(wide_n, float_vec_t) / __builtin_convertvector(wide_d, float_vec_t);
+    simd_convert<false>(q, __builtin_convertvector(quotient, int_vec_t));
+    q |= zero;
+}
+// VDIVU, VDIV, VREMU and VREM in place of simd_vector_loop. For the .vx form the divisor constants are computed once and the elements
+// are divided with multiplies and shifts, SEW 64 has no host vector multiply-high and is divided element wise with a 64x64->128 bit
+// multiply. The .vv form is divided through host floats for SEW 8 and 16, wider elements are divided one by one
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void simd_divide_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                      const elem_t* vs1_elems, elem_t scalar, const elem_t* lanes) {
+    constexpr bool remainder = FUNCT6 & 0b10;
+    constexpr size_t block = 64 / sizeof(elem_t);
+    using vec_t = typename simd_vec<elem_t, block>::type;
+    auto vs2_elems = reinterpret_cast<const elem_t*>(V + VLEN / 8 * vs2);
+    if(vs1_elems) {
+        auto elem_fn = [&](size_t idx) { return funct<FUNCT6, OPMVV, elem_t, elem_t, elem_t>(0, vs2_elems[idx], vs1_elems[idx]); };
+        if constexpr(sizeof(elem_t) <= 2) {
+            auto block_fn = [&](size_t idx, auto& res) {
+                vec_t n, d;
+                memcpy(&n, vs2_elems + idx, sizeof(vec_t));
+                memcpy(&d, vs1_elems + idx, sizeof(vec_t));
+                simd_fp_quotient<FUNCT6 & 1>(res, n, d);
+                if constexpr(remainder)
+                    res = n - res * d;
+            };
+            return simd_body_loop<VLEN, block>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+        } else
+            return simd_body_loop<VLEN, block, true>(V, vl, vstart, cfg, vm, vd, lanes, nullptr, elem_fn);
+    }
+    invariant_divisor<elem_t, FUNCT6 & 1> divisor(scalar);
+    auto block_fn = [&](size_t idx, auto& res) {
+        vec_t n;
+        memcpy(&n, vs2_elems + idx, sizeof(vec_t));
+        divisor.quotient(res, n);
+        if constexpr(remainder)
+            res = n - res * scalar;
+    };
+    auto elem_fn = [&](size_t idx) {
+        elem_t n = vs2_elems[idx];
+        elem_t q = divisor.quotient(n);
+        return remainder ? static_cast<elem_t>(n - q * scalar) : q;
+    };
+    simd_body_loop<VLEN, block, sizeof(elem_t) == 8>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+}
+// .vv (vs1_elems set) or .vx/.vi (scalar) form of a simd_funct operation
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void simd_vector_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                      const src1_elem_t* vs1_elems, src1_elem_t scalar, const dest_elem_t* lanes = nullptr) {
+    constexpr size_t block = simd_block<dest_elem_t, src2_elem_t>;
+    using vec_t = typename simd_vec<dest_elem_t, block>::type;
+    using src2_vec_t = typename simd_vec<src2_elem_t, block>::type;
+    using src1_vec_t = typename simd_vec<src1_elem_t, block>::type;
+    auto vd_elems = reinterpret_cast<const dest_elem_t*>(V + VLEN / 8 * vd);
+    auto vs2_elems = reinterpret_cast<const src2_elem_t*>(V + VLEN / 8 * vs2);
+    src1_vec_t broadcast = scalar - src1_vec_t{};
+    // no host vector multiplies 64 bit lanes into 128 bits, these multiply-highs are a scalar 64x64->128 bit multiply per element
+    constexpr bool element_wise = sizeof(dest_elem_t) == 8 && (FUNCT3 == OPMVV || FUNCT3 == OPMVX) &&
+                                  (FUNCT6 == 0b100100 || FUNCT6 == 0b100110 || FUNCT6 == 0b100111);
+    // generic, so the body is only instantiated if the blocks are computed with host vectors
+    auto block_fn = [&](size_t idx, auto& res) {
+        src2_vec_t src2;
+        src1_vec_t src1 = broadcast;
+        if constexpr(has_simd_accumulator(FUNCT6, FUNCT3))
+            memcpy(&res, vd_elems + idx, sizeof(vec_t));
+        memcpy(&src2, vs2_elems + idx, sizeof(src2_vec_t));
+        if(vs1_elems) {
+            memcpy(&src1, vs1_elems + idx, sizeof(src1_vec_t));
+            simd_funct<FUNCT6, FUNCT3>(res, src2, src1);
+        } else if constexpr(has_simd_scalar_count(FUNCT6, FUNCT3))
+            simd_funct<FUNCT6, FUNCT3>(res, src2, scalar);
+        else
+            simd_funct<FUNCT6, FUNCT3>(res, src2, src1);
+    };
+    auto elem_fn = [&](size_t idx) {
+        return funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vd_elems[idx], vs2_elems[idx],
+                                                                           vs1_elems ? vs1_elems[idx] : scalar);
+    };
+    simd_body_loop<VLEN, block, element_wise>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+using simd_vector_loop_t = void (*)(uint8_t*, uint64_t, uint64_t, const vconfig_t&, bool, unsigned, unsigned, const src1_elem_t*,
+                                    src1_elem_t, const dest_elem_t*);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+constexpr simd_vector_loop_t<VLEN, dest_elem_t, src1_elem_t> simd_vector_loop_for() {
+    if constexpr(!has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return nullptr;
+    else if constexpr((FUNCT3 == OPMVV || FUNCT3 == OPMVX) && FUNCT6 <= 0b100011) // VDIVU, VDIV, VREMU, VREM
+        return simd_divide_loop<VLEN, FUNCT6, dest_elem_t>;
+    else
+        return simd_vector_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>;
+}
+// the simd_vector_loop for an encoding, nullptr if there is none for the element types
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+simd_vector_loop_t<VLEN, dest_elem_t, src1_elem_t> find_simd_vector_loop(unsigned funct6, unsigned funct3) noexcept {
+    if(!has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return nullptr;
+    if(funct3 == OPMVV || funct3 == OPMVX)
+        switch(funct6) {
+        // the .vv and .vx divisions share simd_divide_loop
+        case 0b100000: // VDIVU
+            return simd_vector_loop_for<VLEN, 0b100000, OPMVX, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100001: // VDIV
+            return simd_vector_loop_for<VLEN, 0b100001, OPMVX, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100010: // VREMU
+            return simd_vector_loop_for<VLEN, 0b100010, OPMVX, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100011: // VREM
+            return simd_vector_loop_for<VLEN, 0b100011, OPMVX, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100100: // VMULHU
+            return simd_vector_loop_for<VLEN, 0b100100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100101: // VMUL
+            return simd_vector_loop_for<VLEN, 0b100101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100110: // VMULHSU
+            return simd_vector_loop_for<VLEN, 0b100110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100111: // VMULH
+            return simd_vector_loop_for<VLEN, 0b100111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101001: // VMADD
+            return simd_vector_loop_for<VLEN, 0b101001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101011: // VNMSUB
+            return simd_vector_loop_for<VLEN, 0b101011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101101: // VMACC
+            return simd_vector_loop_for<VLEN, 0b101101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101111: // VNMSAC
+            return simd_vector_loop_for<VLEN, 0b101111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110000: // VWADDU
+            return simd_vector_loop_for<VLEN, 0b110000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110001: // VWADD
+            return simd_vector_loop_for<VLEN, 0b110001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110010: // VWSUBU
+            return simd_vector_loop_for<VLEN, 0b110010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110011: // VWSUB
+            return simd_vector_loop_for<VLEN, 0b110011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110100: // VWADDU.W
+            return simd_vector_loop_for<VLEN, 0b110100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110101: // VWADD.W
+            return simd_vector_loop_for<VLEN, 0b110101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110110: // VWSUBU.W
+            return simd_vector_loop_for<VLEN, 0b110110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110111: // VWSUB.W
+            return simd_vector_loop_for<VLEN, 0b110111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111000: // VWMULU
+            return simd_vector_loop_for<VLEN, 0b111000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111010: // VWMULSU
+            return simd_vector_loop_for<VLEN, 0b111010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111011: // VWMUL
+            return simd_vector_loop_for<VLEN, 0b111011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111100: // VWMACCU
+            return simd_vector_loop_for<VLEN, 0b111100, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111101: // VWMACC
+            return simd_vector_loop_for<VLEN, 0b111101, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111110: // VWMACCUS
+            return simd_vector_loop_for<VLEN, 0b111110, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b111111: // VWMACCSU
+            return simd_vector_loop_for<VLEN, 0b111111, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        }
+    else
+        switch(funct6) {
+        case 0b000000: // VADD
+            return simd_vector_loop_for<VLEN, 0b000000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000001: // VANDN
+            return simd_vector_loop_for<VLEN, 0b000001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000010: // VSUB
+            return simd_vector_loop_for<VLEN, 0b000010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000011: // VRSUB
+            return simd_vector_loop_for<VLEN, 0b000011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000100: // VMINU
+            return simd_vector_loop_for<VLEN, 0b000100, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000101: // VMIN
+            return simd_vector_loop_for<VLEN, 0b000101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000110: // VMAXU
+            return simd_vector_loop_for<VLEN, 0b000110, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b000111: // VMAX
+            return simd_vector_loop_for<VLEN, 0b000111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001001: // VAND
+            return simd_vector_loop_for<VLEN, 0b001001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001010: // VOR
+            return simd_vector_loop_for<VLEN, 0b001010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001011: // VXOR
+            return simd_vector_loop_for<VLEN, 0b001011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b100101: // VSLL
+            return simd_vector_loop_for<VLEN, 0b100101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101000: // VSRL
+            return simd_vector_loop_for<VLEN, 0b101000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101001: // VSRA
+            return simd_vector_loop_for<VLEN, 0b101001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101100: // VNSRL
+            return simd_vector_loop_for<VLEN, 0b101100, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b101101: // VNSRA
+            return simd_vector_loop_for<VLEN, 0b101101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b110101: // VWSLL
+            return simd_vector_loop_for<VLEN, 0b110101, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        }
+    return nullptr;
+}
+// zero (sign) extension of vs2 for VZEXT.VF2/4/8 (VSEXT.VF2/4/8)
+template <unsigned VLEN, bool SIGNED, typename dest_elem_t, typename src2_elem_t>
+void simd_extend_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                      const dest_elem_t* lanes = nullptr) {
+    constexpr size_t block = simd_vec<dest_elem_t>::lanes;
+    using vec_t = typename simd_vec<dest_elem_t>::type;
+    using src2_vec_t = typename simd_vec<src2_elem_t, block>::type;
+    auto vs2_elems = reinterpret_cast<const src2_elem_t*>(V + VLEN / 8 * vs2);
+    auto block_fn = [&](size_t idx, vec_t& res) {
+        src2_vec_t src2;
+        memcpy(&src2, vs2_elems + idx, sizeof(src2_vec_t));
+        simd_convert<SIGNED>(res, src2);
+    };
+    auto elem_fn = [&](size_t idx) -> dest_elem_t {
+        if constexpr(SIGNED)
+            return sext<dest_elem_t>(vs2_elems[idx]);
+        else
+            return vs2_elems[idx];
+    };
+    simd_body_loop<VLEN, block>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+}
+template <unsigned VLEN, typename dest_elem_t>
+using simd_extend_loop_t = void (*)(uint8_t*, uint64_t, uint64_t, const vconfig_t&, bool, unsigned, unsigned, const dest_elem_t*);
+// the simd_extend_loop for a VSEXT/VZEXT encoding, nullptr for the other unary operations
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t>
+simd_extend_loop_t<VLEN, dest_elem_t> find_simd_extend_loop(unsigned unary_op) noexcept {
+    if constexpr(sizeof(dest_elem_t) > sizeof(src2_elem_t))
+        switch(unary_op) {
+        case 0b00111: // VSEXT.VF2
+        case 0b00101: // VSEXT.VF4
+        case 0b00011: // VSEXT.VF8
+            return simd_extend_loop<VLEN, true, dest_elem_t, src2_elem_t>;
+        case 0b00110: // VZEXT.VF2
+        case 0b00100: // VZEXT.VF4
+        case 0b00010: // VZEXT.VF8
+            return simd_extend_loop<VLEN, false, dest_elem_t, src2_elem_t>;
+        }
+    return nullptr;
+}
+// vlmax for the vsew/vlmul bits (vtype[4:0]) of a vtype, evaluated at compile time to instantiate the fixed-length kernels
+template <unsigned VLEN> constexpr uint64_t fixed_vlmax(unsigned sew_lmul) {
+    int lmul_log2 = static_cast<int>((sew_lmul & 0b111) ^ 0b100) - 0b100;
+    unsigned sew = 8U << ((sew_lmul >> 3) & 0b111);
+    return (lmul_log2 < 0 ? VLEN >> -lmul_log2 : static_cast<uint64_t>(VLEN) << lmul_log2) / sew;
+}
+// the fixed-length kernel of vsew/vlmul (vtype[4:0]). Only SEW 8 to 64 and the defined LMULs select a kernel, vill and the reserved
+// encodings never reach the element loops
+inline size_t fixed_kernel_index(vtype_t vtype) {
+    assert(!vtype.vill() && !(vtype.underlying & 0b100000) && (vtype.underlying & 0b111) != 0b100);
+    return vtype.underlying & 0b11111;
+}
+// kernels for a fully active register group (vstart == 0, vl == vlmax, unmasked): the trip count is a compile-time constant
+// and neither mask nor tail handling is left, so the compiler can unroll and vectorize the loop
+template <unsigned VLEN, uint64_t VLMAX, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_vector_fixed(uint8_t* V, funct_t fn, unsigned vd, unsigned vs2, unsigned vs1) {
+    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, VLMAX);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, VLMAX);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, VLMAX);
+    for(size_t idx = 0; idx < VLMAX; idx++)
+        vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t, size_t... SEW_LMUL>
+constexpr std::array<void (*)(uint8_t*, funct_t, unsigned, unsigned, unsigned), sizeof...(SEW_LMUL)>
+vector_vector_fixed_table(std::index_sequence<SEW_LMUL...>) {
+    return {((SEW_LMUL & 0b111) == 0b100
+                 ? nullptr
+                 : vector_vector_fixed<VLEN, fixed_vlmax<VLEN>(SEW_LMUL), dest_elem_t, src2_elem_t, src1_elem_t, funct_t>)...};
+}
+template <unsigned VLEN, uint64_t VLMAX, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_imm_fixed(uint8_t* V, funct_t fn, unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, VLMAX);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, VLMAX);
+    for(size_t idx = 0; idx < VLMAX; idx++)
+        vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t, size_t... SEW_LMUL>
+constexpr std::array<void (*)(uint8_t*, funct_t, unsigned, unsigned, typename std::make_signed<src1_elem_t>::type), sizeof...(SEW_LMUL)>
+vector_imm_fixed_table(std::index_sequence<SEW_LMUL...>) {
+    return {((SEW_LMUL & 0b111) == 0b100
+                 ? nullptr
+                 : vector_imm_fixed<VLEN, fixed_vlmax<VLEN>(SEW_LMUL), dest_elem_t, src2_elem_t, src1_elem_t, funct_t>)...};
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_vector_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                        unsigned vs1) {
+    // the fixed-length kernels only run for a fully active group: vstart == 0, vl == vlmax and unmasked. A masked, partial or resumed
+    // operation takes the element loops below. Operations with a kernel in find_simd_vector_loop do not get here, their callers pick the
+    // SIMD loop, which blends masked and partial blocks in simd_body_loop. A function pointer of the runtime or prepared paths would
+    // still be called per element, so only the compile-time operations, whose fn is inlined, have the kernels
+    if constexpr(!std::is_pointer_v<funct_t>)
+        if(vstart == 0 && vl == cfg.vlmax && vm) {
+            static constexpr auto fixed_kernels =
+                vector_vector_fixed_table<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, funct_t>(std::make_index_sequence<32>());
+            return fixed_kernels[fixed_kernel_index(cfg.vtype)](V, fn, vd, vs2, vs1);
+        }
+    if(!vm && vl <= small_vl) {
+        auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+        auto vs1_elems = reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1);
+        return small_vl_loop<VLEN, dest_elem_t>(V, vl, vstart, cfg, vd, [&](dest_elem_t vd_elem, size_t idx) {
+            return fn(vd_elem, vs2_elems[idx], vs1_elems[idx]);
+        });
+    }
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
+    if(!vm && (agnostic_undisturbed() || !cfg.vma)) {
+        for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
+            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]);
+            return true;
+        });
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active)
+                vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]);
+            else if(cfg.vma)
+                vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        }
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+}
+// masked form of vector_vector_loop for side effect free elementwise functions: every body element is computed and the result is
+// blended with the previous value through lanes, v0 expanded to dest_elem_t by expand_vmask, so the loop has no data dependent branch
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_vector_blend_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, const dest_elem_t* lanes,
+                              unsigned vd, unsigned vs2, unsigned vs1) {
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+    auto vs1_elems = reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1);
+    bool undisturbed = agnostic_undisturbed() || !cfg.vma;
+    auto blend = [&](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1, dest_elem_t lane) {
+        return (fn(vd, vs2, vs1) & lane) | ((undisturbed ? vd : agnostic_behavior(vd)) & ~lane);
+    };
+    // the full blocks go through local copies, so the compiler vectorizes them without having to check vd against the sources
+    constexpr size_t block = 64 / sizeof(dest_elem_t);
+    size_t idx = vstart;
+    for(; idx < vl && idx % block; idx++)
+        vd_elems[idx] = blend(vd_elems[idx], vs2_elems[idx], vs1_elems[idx], lanes[idx]);
+    for(; idx + block <= vl; idx += block) {
+        dest_elem_t vd_block[block];
+        src2_elem_t vs2_block[block];
+        src1_elem_t vs1_block[block];
+        memcpy(vd_block, vd_elems + idx, sizeof(vd_block));
+        memcpy(vs2_block, vs2_elems + idx, sizeof(vs2_block));
+        memcpy(vs1_block, vs1_elems + idx, sizeof(vs1_block));
+        for(size_t i = 0; i < block; i++)
+            vd_block[i] = blend(vd_block[i], vs2_block[i], vs1_block[i], lanes[idx + i]);
+        memcpy(vd_elems + idx, vd_block, sizeof(vd_block));
+    }
+    for(; idx < vl; idx++)
+        vd_elems[idx] = blend(vd_elems[idx], vs2_elems[idx], vs1_elems[idx], lanes[idx]);
+    if(!agnostic_undisturbed() && cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                      unsigned vs2, unsigned vs1) {
+    auto fn = get_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0,
+                         nullptr);
+    vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    if constexpr(has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return simd_vector_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>()(
+            V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0, nullptr);
+    auto fn = [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vd, vs2, vs1);
+    };
+    vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t) noexcept {
+    auto fn = reinterpret_cast<decltype(find_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+vstatus_t simd_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t) noexcept {
+    auto simd_loop = reinterpret_cast<simd_vector_loop_t<VLEN, dest_elem_t, src1_elem_t>>(op.elem_fn);
+    simd_loop(V, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * op.vs1), 0, nullptr);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                           unsigned vs1) noexcept {
+    auto fn = find_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return {simd_vector_vector_exec<VLEN, dest_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(simd_loop), vconfig_t(vtype, VLEN),
+                vm, vd, vs2, vs1};
+    return {vector_vector_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm,
+            vd, vs2, vs1};
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_imm_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                     typename std::make_signed<src1_elem_t>::type imm) {
+    // only a fully active group (vstart == 0, vl == vlmax, unmasked) of a compile-time operation takes the fixed-length kernels, see
+    // vector_vector_loop
+    if constexpr(!std::is_pointer_v<funct_t>)
+        if(vstart == 0 && vl == cfg.vlmax && vm) {
+            static constexpr auto fixed_kernels =
+                vector_imm_fixed_table<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, funct_t>(std::make_index_sequence<32>());
+            return fixed_kernels[fixed_kernel_index(cfg.vtype)](V, fn, vd, vs2, imm);
+        }
+    if(!vm && vl <= small_vl) {
+        auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+        return small_vl_loop<VLEN, dest_elem_t>(V, vl, vstart, cfg, vd,
+                                                [&](dest_elem_t vd_elem, size_t idx) { return fn(vd_elem, vs2_elems[idx], imm); });
+    }
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
+    if(!vm && (agnostic_undisturbed() || !cfg.vma)) {
+        for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
+            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm);
+            return true;
+        });
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active)
+                vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm);
+            else if(cfg.vma)
+                vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        }
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+}
+// masked form of vector_imm_loop, see vector_vector_blend_loop
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void vector_imm_blend_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, const dest_elem_t* lanes,
+                           unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+    bool undisturbed = agnostic_undisturbed() || !cfg.vma;
+    auto blend = [&](dest_elem_t vd, src2_elem_t vs2, dest_elem_t lane) {
+        return (fn(vd, vs2, imm) & lane) | ((undisturbed ? vd : agnostic_behavior(vd)) & ~lane);
+    };
+    constexpr size_t block = 64 / sizeof(dest_elem_t);
+    size_t idx = vstart;
+    for(; idx < vl && idx % block; idx++)
+        vd_elems[idx] = blend(vd_elems[idx], vs2_elems[idx], lanes[idx]);
+    for(; idx + block <= vl; idx += block) {
+        dest_elem_t vd_block[block];
+        src2_elem_t vs2_block[block];
+        memcpy(vd_block, vd_elems + idx, sizeof(vd_block));
+        memcpy(vs2_block, vs2_elems + idx, sizeof(vs2_block));
+        for(size_t i = 0; i < block; i++)
+            vd_block[i] = blend(vd_block[i], vs2_block[i], lanes[idx + i]);
+        memcpy(vd_elems + idx, vd_block, sizeof(vd_block));
+    }
+    for(; idx < vl; idx++)
+        vd_elems[idx] = blend(vd_elems[idx], vs2_elems[idx], lanes[idx]);
+    if(!agnostic_undisturbed() && cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                   unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+    auto fn = get_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, nullptr, imm, nullptr);
+    vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                   typename std::make_signed<src1_elem_t>::type imm) {
+    if constexpr(has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return simd_vector_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>()(V, vl, vstart, vconfig_t(vtype, VLEN),
+                                                                                                   vm, vd, vs2, nullptr, imm, nullptr);
+    auto fn = [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vd, vs2, vs1);
+    };
+    vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t) noexcept {
+    auto fn = reinterpret_cast<decltype(find_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    auto imm = static_cast<typename std::make_signed<src1_elem_t>::type>(scalar);
+    vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, imm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+vstatus_t simd_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t) noexcept {
+    auto simd_loop = reinterpret_cast<simd_vector_loop_t<VLEN, dest_elem_t, src1_elem_t>>(op.elem_fn);
+    simd_loop(V, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, nullptr, static_cast<src1_elem_t>(scalar), nullptr);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept {
+    auto fn = find_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return {simd_vector_imm_exec<VLEN, dest_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(simd_loop), vconfig_t(vtype, VLEN), vm,
+                vd, vs2, 0};
+    return {vector_imm_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd,
+            vs2, 0};
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void vector_vector_carry_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1,
+                              signed carry) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vs1_view = get_vreg<VLEN, elem_t>(V, vs1, vlmax);
+    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
+    auto vd_view = get_vreg<VLEN, elem_t>(V, vd, vlmax);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t carry_in = mask_words.get(word);
+        for(size_t idx = std::max<uint64_t>(vstart, word * 64); idx < std::min<uint64_t>(vl, word * 64 + 64); idx++)
+            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]) + carry * static_cast<signed>(carry_in >> (idx % 64) & 1);
     }
     if(vtype.vta())
-        for(size_t idx = vl; idx < VLEN; idx++)
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+        for(size_t idx = vl; idx < vlmax; idx++)
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
 template <unsigned VLEN, typename elem_t>
-void mask_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                        unsigned vs2, typename std::make_signed<elem_t>::type imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
+void vector_vector_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd,
+                         unsigned vs2, unsigned vs1, signed carry) {
+    auto fn = get_funct_ptr<elem_t, elem_t, elem_t>(funct6, funct3);
+    vector_vector_carry_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vd, vs2, vs1, carry);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void vector_vector_carry(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1, signed carry) {
+    auto fn = [](elem_t vd, elem_t vs2, elem_t vs1) { return funct<FUNCT6, FUNCT3, elem_t, elem_t, elem_t>(vd, vs2, vs1); };
+    vector_vector_carry_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vd, vs2, vs1, carry);
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void vector_imm_carry_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
+                           typename std::make_signed<elem_t>::type imm, signed carry) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    auto mask_words = get_vmask_words<VLEN>(V);
     auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, VLEN, vd);
-    auto fn = get_mask_funct<elem_t>(funct6, funct3);
+    auto vd_view = get_vreg<VLEN, elem_t>(V, vd, vlmax);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t carry_in = mask_words.get(word);
+        for(size_t idx = std::max<uint64_t>(vstart, word * 64); idx < std::min<uint64_t>(vl, word * 64 + 64); idx++)
+            vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm) + carry * static_cast<signed>(carry_in >> (idx % 64) & 1);
+    }
+    if(vtype.vta())
+        for(size_t idx = vl; idx < vlmax; idx++)
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+}
+template <unsigned VLEN, typename elem_t>
+void vector_imm_carry(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
+                      typename std::make_signed<elem_t>::type imm, signed carry) {
+    auto fn = get_funct_ptr<elem_t, elem_t, elem_t>(funct6, funct3);
+    vector_imm_carry_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vd, vs2, imm, carry);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void vector_imm_carry(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2,
+                      typename std::make_signed<elem_t>::type imm, signed carry) {
+    auto fn = [](elem_t vd, elem_t vs2, elem_t vs1) { return funct<FUNCT6, FUNCT3, elem_t, elem_t, elem_t>(vd, vs2, vs1); };
+    vector_imm_carry_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vd, vs2, imm, carry);
+}
+template <unsigned VLEN, typename scr_elem_t>
+void vector_vector_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
+    auto vs1_view = get_vreg<VLEN, scr_elem_t>(V, vs1, vlmax);
+    auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
+    auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
         if(mask_active)
-            vd_mask_view[idx] = fn(vs2_view[idx], imm);
-        else if(vtype.vma())
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+            vd_view[idx] = vs1_view[idx];
+        else
+            vd_view[idx] = vs2_view[idx];
     }
-    if(vtype.vta())
-        for(size_t idx = vl; idx < VLEN; idx++)
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+}
+template <unsigned VLEN, typename scr_elem_t>
+void vector_imm_merge(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
+    auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
+    auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool mask_active = vm ? 1 : mask_reg[idx];
+        if(mask_active)
+            vd_view[idx] = imm;
+        else
+            vd_view[idx] = vs2_view[idx];
+    }
+}
+template <unsigned FUNCT6, unsigned FUNCT3, typename elem_t> bool mask_funct(elem_t vs2, elem_t vs1) {
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b011000) // VMSEQ
+            return vs2 == vs1;
+        else if constexpr(FUNCT6 == 0b011001) // VMSNE
+            return vs2 != vs1;
+        else if constexpr(FUNCT6 == 0b011010) // VMSLTU
+            return vs2 < vs1;
+        else if constexpr(FUNCT6 == 0b011011) // VMSLT
+            return static_cast<std::make_signed_t<elem_t>>(vs2) < static_cast<std::make_signed_t<elem_t>>(vs1);
+        else if constexpr(FUNCT6 == 0b011100) // VMSLEU
+            return vs2 <= vs1;
+        else if constexpr(FUNCT6 == 0b011101) // VMSLE
+            return static_cast<std::make_signed_t<elem_t>>(vs2) <= static_cast<std::make_signed_t<elem_t>>(vs1);
+        else if constexpr(FUNCT6 == 0b011110) // VMSGTU
+            return vs2 > vs1;
+        else if constexpr(FUNCT6 == 0b011111) // VMSGT
+            return static_cast<std::make_signed_t<elem_t>>(vs2) > static_cast<std::make_signed_t<elem_t>>(vs1);
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in mask_funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        if constexpr(FUNCT6 == 0b011000) // VMANDN
+            return vs2 & !vs1;
+        else if constexpr(FUNCT6 == 0b011001) // VMAND
+            return vs2 & vs1;
+        else if constexpr(FUNCT6 == 0b011010) // VMOR
+            return vs2 | vs1;
+        else if constexpr(FUNCT6 == 0b011011) // VMXOR
+            return vs2 ^ vs1;
+        else if constexpr(FUNCT6 == 0b011100) // VMORN
+            return vs2 | !vs1;
+        else if constexpr(FUNCT6 == 0b011101) // VMNAND
+            return !(vs2 & vs1);
+        else if constexpr(FUNCT6 == 0b011110) // VMNOR
+            return !(vs2 | vs1);
+        else if constexpr(FUNCT6 == 0b011111) // VMXNOR
+            return !(vs2 ^ vs1);
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in mask_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in mask_funct");
+}
+template <typename elem_t> std::add_pointer_t<bool(elem_t, elem_t)> find_mask_funct(unsigned funct6, unsigned funct3) noexcept {
+    if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
+        switch(funct6) {
+        case 0b011000: // VMSEQ
+            return mask_funct<0b011000, OPIVV, elem_t>;
+        case 0b011001: // VMSNE
+            return mask_funct<0b011001, OPIVV, elem_t>;
+        case 0b011010: // VMSLTU
+            return mask_funct<0b011010, OPIVV, elem_t>;
+        case 0b011011: // VMSLT
+            return mask_funct<0b011011, OPIVV, elem_t>;
+        case 0b011100: // VMSLEU
+            return mask_funct<0b011100, OPIVV, elem_t>;
+        case 0b011101: // VMSLE
+            return mask_funct<0b011101, OPIVV, elem_t>;
+        case 0b011110: // VMSGTU
+            return mask_funct<0b011110, OPIVV, elem_t>;
+        case 0b011111: // VMSGT
+            return mask_funct<0b011111, OPIVV, elem_t>;
+
+        default:
+            return nullptr;
+        }
+    else if(funct3 == OPMVV || funct3 == OPMVX)
+        switch(funct6) {
+        case 0b011000: // VMANDN
+            return mask_funct<0b011000, OPMVV, elem_t>;
+        case 0b011001: // VMAND
+            return mask_funct<0b011001, OPMVV, elem_t>;
+        case 0b011010: // VMOR
+            return mask_funct<0b011010, OPMVV, elem_t>;
+        case 0b011011: // VMXOR
+            return mask_funct<0b011011, OPMVV, elem_t>;
+        case 0b011100: // VMORN
+            return mask_funct<0b011100, OPMVV, elem_t>;
+        case 0b011101: // VMNAND
+            return mask_funct<0b011101, OPMVV, elem_t>;
+        case 0b011110: // VMNOR
+            return mask_funct<0b011110, OPMVV, elem_t>;
+        case 0b011111: // VMXNOR
+            return mask_funct<0b011111, OPMVV, elem_t>;
+        default:
+            return nullptr;
+        }
+    else
+        return nullptr;
+}
+template <typename elem_t> std::add_pointer_t<bool(elem_t, elem_t)> get_mask_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_mask_funct<elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_mask_funct");
+}
+template <typename elem_t> std::function<bool(elem_t, elem_t)> get_mask_funct(unsigned funct6, unsigned funct3) {
+    return get_mask_funct_ptr<elem_t>(funct6, funct3);
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void mask_vector_vector_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                             unsigned vs1) {
+    auto vs1_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs1);
+    auto vs2_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
+    // integer compares have no side effects, so a whole word is compared into bytes and packed, masking happens on the packed word
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint8_t results[64] = {};
+        size_t first = std::max<uint64_t>(vstart, word * 64), last = std::min<uint64_t>(vl, word * 64 + 64);
+        if(last - first == 64) // fixed trip count, vectorizable once fn is inlined
+            for(unsigned lane = 0; lane < 64; lane++)
+                results[lane] = fn(vs2_elems[word * 64 + lane], vs1_elems[word * 64 + lane]);
+        else
+            for(size_t idx = first; idx < last; idx++)
+                results[idx % 64] = fn(vs2_elems[idx], vs1_elems[idx]);
+        uint64_t body = mask_word_select(word, vstart, vl);
+        merge_mask_word(vd_words, word, pack_mask_bytes(results), body, vm ? body : mask_words.get(word) & body, cfg.vma);
+    }
+    mask_tail_agnostic(vd_words, vl, cfg.vta);
+}
+template <unsigned VLEN, typename elem_t>
+void mask_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                           unsigned vs2, unsigned vs1) {
+    auto fn = get_mask_funct_ptr<elem_t>(funct6, funct3);
+    mask_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void mask_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    auto fn = [](elem_t vs2, elem_t vs1) { return mask_funct<FUNCT6, FUNCT3, elem_t>(vs2, vs1); };
+    mask_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, typename elem_t>
+vstatus_t mask_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t) noexcept {
+    auto fn = reinterpret_cast<decltype(find_mask_funct<elem_t>(0, 0))>(op.elem_fn);
+    mask_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                                unsigned vs1) noexcept {
+    auto fn = find_mask_funct<elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {mask_vector_vector_exec<VLEN, elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, vs1};
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void mask_vector_imm_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                          typename std::make_signed<elem_t>::type imm) {
+    auto vs2_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint8_t results[64] = {};
+        size_t first = std::max<uint64_t>(vstart, word * 64), last = std::min<uint64_t>(vl, word * 64 + 64);
+        if(last - first == 64) // fixed trip count, vectorizable once fn is inlined
+            for(unsigned lane = 0; lane < 64; lane++)
+                results[lane] = fn(vs2_elems[word * 64 + lane], imm);
+        else
+            for(size_t idx = first; idx < last; idx++)
+                results[idx % 64] = fn(vs2_elems[idx], imm);
+        uint64_t body = mask_word_select(word, vstart, vl);
+        merge_mask_word(vd_words, word, pack_mask_bytes(results), body, vm ? body : mask_words.get(word) & body, cfg.vma);
+    }
+    mask_tail_agnostic(vd_words, vl, cfg.vta);
+}
+template <unsigned VLEN, typename elem_t>
+void mask_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                        unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+    auto fn = get_mask_funct_ptr<elem_t>(funct6, funct3);
+    mask_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+void mask_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                        typename std::make_signed<elem_t>::type imm) {
+    auto fn = [](elem_t vs2, elem_t vs1) { return mask_funct<FUNCT6, FUNCT3, elem_t>(vs2, vs1); };
+    mask_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm);
+}
+template <unsigned VLEN, typename elem_t>
+vstatus_t mask_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t) noexcept {
+    auto fn = reinterpret_cast<decltype(find_mask_funct<elem_t>(0, 0))>(op.elem_fn);
+    auto imm = static_cast<typename std::make_signed<elem_t>::type>(scalar);
+    mask_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, imm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept {
+    auto fn = find_mask_funct<elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {mask_vector_imm_exec<VLEN, elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, 0};
+}
+template <unsigned UNARY_OP, typename dest_elem_t, typename src2_elem_t = dest_elem_t> dest_elem_t unary_fn(src2_elem_t vs2) {
+    if constexpr(UNARY_OP == 0b00111 || UNARY_OP == 0b00101 || UNARY_OP == 0b00011) // VSEXT.VF2, VSEXT.VF4, VSEXT.VF8
+        return static_cast<std::make_signed_t<src2_elem_t>>(vs2);
+    else if constexpr(UNARY_OP == 0b00110 || UNARY_OP == 0b00100 || UNARY_OP == 0b00010) // VZEXT.VF2, VZEXT.VF4, VZEXT.VF8
+        return vs2;
+    else if constexpr(UNARY_OP == 0b01000) // VBREV8
+        return brev8<dest_elem_t>(vs2);
+    else if constexpr(UNARY_OP == 0b01001) // VREV8
+        return byte_swap(vs2);
+    else if constexpr(UNARY_OP == 0b01010) // VBREV
+        return brev<dest_elem_t>(vs2);
+    else if constexpr(UNARY_OP == 0b01100 || UNARY_OP == 0b01101) { // VCLZ, VCTZ
+        // the 64 bit builtins on the zero extended element, undefined for 0. A marker bit next to an element of less than 64 bits
+        // bounds the count to SEW without a branch
+        constexpr unsigned bits = sizeof(src2_elem_t) * 8;
+        uint64_t value = vs2;
+        if constexpr(bits == 64) {
+            if(value == 0)
+                return static_cast<dest_elem_t>(bits);
+            return static_cast<dest_elem_t>(UNARY_OP == 0b01100 ? __builtin_clzll(value) : __builtin_ctzll(value));
+        } else if constexpr(UNARY_OP == 0b01100)
+            return static_cast<dest_elem_t>(__builtin_clzll(value << (64 - bits) | uint64_t(1) << (63 - bits)));
+        else
+            return static_cast<dest_elem_t>(__builtin_ctzll(value | uint64_t(1) << bits));
+    } else if constexpr(UNARY_OP == 0b01110) // VCPOP
+        return static_cast<dest_elem_t>(__builtin_popcountll(vs2));
+    else
+        static_assert(unsupported_encoding<UNARY_OP>, "Unknown funct in unary_fn");
 }
 template <typename dest_elem_t, typename src2_elem_t = dest_elem_t>
-std::function<dest_elem_t(src2_elem_t)> get_unary_fn(unsigned unary_op) {
+std::add_pointer_t<dest_elem_t(src2_elem_t)> find_unary_fn(unsigned unary_op) noexcept {
     switch(unary_op) {
     case 0b00111: // VSEXT.VF2
     case 0b00101: // VSEXT.VF4
     case 0b00011: // VSEXT.VF8
-        return [](src2_elem_t vs2) { return static_cast<std::make_signed_t<src2_elem_t>>(vs2); };
+        return unary_fn<0b00111, dest_elem_t, src2_elem_t>;
     case 0b00110: // VZEXT.VF2
     case 0b00100: // VZEXT.VF4
     case 0b00010: // VZEXT.VF8
-        return [](src2_elem_t vs2) { return vs2; };
+        return unary_fn<0b00110, dest_elem_t, src2_elem_t>;
     case 0b01000: // VBREV8
-        return [](src2_elem_t vs2) { return brev8<dest_elem_t>(vs2); };
-    case 0b01001: // VREV8
-        return [](src2_elem_t vs2) {
-            constexpr unsigned byte_count = sizeof(src2_elem_t);
-            dest_elem_t result = 0;
-            for(size_t i = 0; i < byte_count; ++i) {
-                result <<= 8;
-                result |= (vs2 & 0xFF);
-                vs2 >>= 8;
-            }
-            return result;
-        };
+        return unary_fn<0b01000, dest_elem_t, src2_elem_t>;
+    case 0b01001: // VREV8
+        return unary_fn<0b01001, dest_elem_t, src2_elem_t>;
     case 0b01010: // VBREV
-        return [](src2_elem_t vs2) { return brev<dest_elem_t>(vs2); };
+        return unary_fn<0b01010, dest_elem_t, src2_elem_t>;
     case 0b01100: // VCLZ
-        return [](src2_elem_t vs2) {
-            if(vs2 == 0) // builtin is undefined for value '0'
-                return static_cast<dest_elem_t>(sizeof(src2_elem_t) * 8);
-            if(std::is_same_v<src2_elem_t, unsigned int>)
-                return static_cast<dest_elem_t>(__builtin_clz(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long>)
-                return static_cast<dest_elem_t>(__builtin_clzl(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long long>)
-                return static_cast<dest_elem_t>(__builtin_clzll(vs2));
-            else {
-                constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
-                dest_elem_t count = 0;
-                for(size_t i = bits - 1; i >= 0; --i) {
-                    if((vs2 >> i) & 1)
-                        break;
-                    ++count;
-                }
-                return count;
-            }
-        };
+        return unary_fn<0b01100, dest_elem_t, src2_elem_t>;
     case 0b01101: // VCTZ
-        return [](src2_elem_t vs2) {
-            if(vs2 == 0) // builtin is undefined for value '0'
-                return static_cast<dest_elem_t>(sizeof(src2_elem_t) * 8);
-            if(std::is_same_v<src2_elem_t, unsigned int>)
-                return static_cast<dest_elem_t>(__builtin_ctz(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long>)
-                return static_cast<dest_elem_t>(__builtin_ctzl(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long long>)
-                return static_cast<dest_elem_t>(__builtin_ctzll(vs2));
-            else {
-                constexpr dest_elem_t bits = sizeof(src2_elem_t) * 8;
-                dest_elem_t count = 0;
-                while((vs2 & 1) == 0) {
-                    ++count;
-                    vs2 >>= 1;
-                }
-                return count;
-            }
-        };
+        return unary_fn<0b01101, dest_elem_t, src2_elem_t>;
     case 0b01110: // VCPOP
-        return [](src2_elem_t vs2) {
-            if(std::is_same_v<src2_elem_t, unsigned int>)
-                return static_cast<dest_elem_t>(__builtin_popcount(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long>)
-                return static_cast<dest_elem_t>(__builtin_popcountl(vs2));
-            else if(std::is_same_v<src2_elem_t, unsigned long long>)
-                return static_cast<dest_elem_t>(__builtin_popcountll(vs2));
-            else {
-                dest_elem_t count = 0;
-                while(vs2) {
-                    count += vs2 & 1;
-                    vs2 >>= 1;
-                }
-                return count;
-            }
-        };
+        return unary_fn<0b01110, dest_elem_t, src2_elem_t>;
     default:
-        throw new std::runtime_error("Unknown funct in get_unary_fn");
+        return nullptr;
     }
 }
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t>
+std::add_pointer_t<dest_elem_t(src2_elem_t)> get_unary_fn_ptr(unsigned unary_op) {
+    if(auto fn = find_unary_fn<dest_elem_t, src2_elem_t>(unary_op))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_unary_fn");
+}
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t>
+std::function<dest_elem_t(src2_elem_t)> get_unary_fn(unsigned unary_op) {
+    return get_unary_fn_ptr<dest_elem_t, src2_elem_t>(unary_op);
+}
+// the single width unary operations of unary_fn on host vectors. The byte reversal swaps the bytes of each 16 bit lane, then the halves
+// of the 32 and 64 bit lanes up to the element width. No bit of VBREV8 crosses a byte, so brev8 works on 64 bit lanes for any SEW
+template <unsigned UNARY_OP, typename vec_t> void simd_unary_fn(vec_t& res, const vec_t& vs2) {
+    using elem_t = simd_elem_t<vec_t>;
+    using u16_vec_t = typename simd_vec<uint16_t, sizeof(vec_t) / 2>::type;
+    using u32_vec_t = typename simd_vec<uint32_t, sizeof(vec_t) / 4>::type;
+    using u64_vec_t = typename simd_vec<uint64_t, sizeof(vec_t) / 8>::type;
+    if constexpr(UNARY_OP == 0b01000) { // VBREV8
+        u64_vec_t words = (u64_vec_t)vs2;
+        words = ((words >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((words & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        words = ((words >> 2) & 0x3333333333333333ULL) | ((words & 0x3333333333333333ULL) << 2);
+        words = ((words >> 1) & 0x5555555555555555ULL) | ((words & 0x5555555555555555ULL) << 1);
+        res = (vec_t)words;
+    } else if constexpr(UNARY_OP == 0b01001) { // VREV8
+        res = vs2;
+        if constexpr(sizeof(elem_t) >= 2) {
+            u16_vec_t halves = (u16_vec_t)res;
+            res = (vec_t)(halves << 8 | halves >> 8);
+        }
+        if constexpr(sizeof(elem_t) >= 4) {
+            u32_vec_t halves = (u32_vec_t)res;
+            res = (vec_t)(halves << 16 | halves >> 16);
+        }
+        if constexpr(sizeof(elem_t) == 8) {
+            u64_vec_t halves = (u64_vec_t)res;
+            res = (vec_t)(halves << 32 | halves >> 32);
+        }
+    } else if constexpr(UNARY_OP == 0b01010) { // VBREV
+        vec_t bytes_swapped;
+        simd_unary_fn<0b01001>(bytes_swapped, vs2);
+        simd_unary_fn<0b01000>(res, bytes_swapped);
+    } else if constexpr(UNARY_OP == 0b01100) { // VCLZ
+        // all bits below the leading one set, the complement has the leading zeros
+        vec_t smeared = vs2;
+        for(unsigned shift = 1; shift < sizeof(elem_t) * 8; shift *= 2)
+            smeared |= smeared >> shift;
+        simd_unary_fn<0b01110>(res, ~smeared);
+    } else if constexpr(UNARY_OP == 0b01101) // VCTZ
+        // the trailing zeros turned into ones and everything above cleared, all ones for 0
+        simd_unary_fn<0b01110>(res, ~vs2 & (vs2 - 1));
+    else if constexpr(UNARY_OP == 0b01110) { // VCPOP
+        // bit counts of the pairs, nibbles and bytes, then the byte counts summed up to the element width
+        constexpr elem_t bytes = static_cast<elem_t>(~elem_t{0}) / 0xFF;
+        res = vs2 - ((vs2 >> 1) & static_cast<elem_t>(bytes * 0x55));
+        res = (res & static_cast<elem_t>(bytes * 0x33)) + ((res >> 2) & static_cast<elem_t>(bytes * 0x33));
+        res = (res + (res >> 4)) & static_cast<elem_t>(bytes * 0x0F);
+        for(unsigned shift = 8; shift < sizeof(elem_t) * 8; shift *= 2)
+            res += res >> shift;
+        res &= 0x7F;
+    } else
+        static_assert(unsupported_encoding<UNARY_OP>, "Unknown funct in simd_unary_fn");
+}
+constexpr bool has_simd_unary_fn(unsigned unary_op) {
+    return (unary_op >= 0b01000 && unary_op <= 0b01010) || (unary_op >= 0b01100 && unary_op <= 0b01110); // VBREV8 to VBREV, VCLZ to VCPOP
+}
+template <unsigned VLEN, unsigned UNARY_OP, typename elem_t>
+void simd_unary_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                     const elem_t* lanes = nullptr) {
+    constexpr size_t block = simd_vec<elem_t>::lanes;
+    using vec_t = typename simd_vec<elem_t>::type;
+    auto vs2_elems = reinterpret_cast<const elem_t*>(V + VLEN / 8 * vs2);
+    auto block_fn = [&](size_t idx, vec_t& res) {
+        vec_t src2;
+        memcpy(&src2, vs2_elems + idx, sizeof(vec_t));
+        simd_unary_fn<UNARY_OP>(res, src2);
+    };
+    auto elem_fn = [&](size_t idx) { return unary_fn<UNARY_OP, elem_t>(vs2_elems[idx]); };
+    // for the few lanes of SEW 32 and 64 the host leading zero count per element beats smearing and counting the bits
+    constexpr bool element_wise = UNARY_OP == 0b01100 && sizeof(elem_t) >= 4;
+    simd_body_loop<VLEN, block, element_wise>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+}
+// the simd_extend_loop or simd_unary_loop for a unary encoding, nullptr for the other ones
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t>
-void vector_unary_op(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+simd_extend_loop_t<VLEN, dest_elem_t> find_simd_unary_loop(unsigned unary_op) noexcept {
+    if constexpr(std::is_same_v<dest_elem_t, src2_elem_t>)
+        switch(unary_op) {
+        case 0b01000: // VBREV8
+            return simd_unary_loop<VLEN, 0b01000, dest_elem_t>;
+        case 0b01001: // VREV8
+            return simd_unary_loop<VLEN, 0b01001, dest_elem_t>;
+        case 0b01010: // VBREV
+            return simd_unary_loop<VLEN, 0b01010, dest_elem_t>;
+        case 0b01100: // VCLZ
+            return simd_unary_loop<VLEN, 0b01100, dest_elem_t>;
+        case 0b01101: // VCTZ
+            return simd_unary_loop<VLEN, 0b01101, dest_elem_t>;
+        case 0b01110: // VCPOP
+            return simd_unary_loop<VLEN, 0b01110, dest_elem_t>;
+        default:
+            return nullptr;
+        }
+    else
+        return find_simd_extend_loop<VLEN, dest_elem_t, src2_elem_t>(unary_op);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename funct_t>
+void vector_unary_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_unary_fn<dest_elem_t, src2_elem_t>(unary_op);
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
         if(mask_active)
@@ -682,50 +1961,172 @@ void vector_unary_op(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart
         for(size_t idx = vl; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
-template <typename elem_t> std::function<bool(elem_t, elem_t, elem_t)> get_carry_funct(unsigned funct) {
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t>
+void vector_unary_op(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) {
+    auto fn = get_unary_fn_ptr<dest_elem_t, src2_elem_t>(unary_op);
+    if(auto simd_loop = find_simd_unary_loop<VLEN, dest_elem_t, src2_elem_t>(unary_op))
+        return simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, nullptr);
+    vector_unary_loop<VLEN, dest_elem_t, src2_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2);
+}
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src2_elem_t>
+void vector_unary_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) {
+    constexpr bool sign_extend = UNARY_OP == 0b00111 || UNARY_OP == 0b00101 || UNARY_OP == 0b00011; // VSEXT.VF2, VSEXT.VF4, VSEXT.VF8
+    constexpr bool zero_extend = UNARY_OP == 0b00110 || UNARY_OP == 0b00100 || UNARY_OP == 0b00010; // VZEXT.VF2, VZEXT.VF4, VZEXT.VF8
+    if constexpr((sign_extend || zero_extend) && sizeof(dest_elem_t) > sizeof(src2_elem_t))
+        return simd_extend_loop<VLEN, sign_extend, dest_elem_t, src2_elem_t>(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2);
+    if constexpr(has_simd_unary_fn(UNARY_OP) && std::is_same_v<dest_elem_t, src2_elem_t>)
+        return simd_unary_loop<VLEN, UNARY_OP, dest_elem_t>(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2);
+    auto fn = [](src2_elem_t vs2) { return unary_fn<UNARY_OP, dest_elem_t, src2_elem_t>(vs2); };
+    vector_unary_loop<VLEN, dest_elem_t, src2_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2);
+}
+// sum (difference) of vs2, vs1 and the carry (borrow) in, carry_out is set if it does not fit into elem_t
+template <unsigned FUNCT6, typename elem_t> elem_t add_with_carry(elem_t vs2, elem_t vs1, bool carry_in, bool& carry_out) {
+    elem_t res;
+    if constexpr(FUNCT6 == 0b010000 || FUNCT6 == 0b010001) // VADC, VMADC
+        carry_out = __builtin_add_overflow(vs2, vs1, &res) | __builtin_add_overflow(res, static_cast<elem_t>(carry_in), &res);
+    else if constexpr(FUNCT6 == 0b010010 || FUNCT6 == 0b010011) // VSBC, VMSBC
+        carry_out = __builtin_sub_overflow(vs2, vs1, &res) | __builtin_sub_overflow(res, static_cast<elem_t>(carry_in), &res);
+    else
+        static_assert(unsupported_encoding<FUNCT6>, "Unknown funct in add_with_carry");
+    return res;
+}
+template <unsigned FUNCT6, typename elem_t> bool carry_funct(elem_t vs2, elem_t vs1, elem_t carry) {
+    static_assert(FUNCT6 == 0b010001 || FUNCT6 == 0b010011, "Unknown funct in carry_funct"); // VMADC, VMSBC
+    bool carry_out;
+    add_with_carry<FUNCT6, elem_t>(vs2, vs1, carry, carry_out);
+    return carry_out;
+}
+template <typename elem_t> std::add_pointer_t<bool(elem_t, elem_t, elem_t)> find_carry_funct(unsigned funct) noexcept {
     switch(funct) {
     case 0b010001: // VMADC
-        return [](elem_t vs2, elem_t vs1, elem_t carry) {
-            return static_cast<elem_t>(vs2 + vs1 + carry) < std::max(vs1, vs2) || static_cast<elem_t>(vs2 + vs1) < std::max(vs1, vs2);
-        };
+        return carry_funct<0b010001, elem_t>;
     case 0b010011: // VMSBC
-        return [](elem_t vs2, elem_t vs1, elem_t carry) {
-            return vs2 < static_cast<elem_t>(vs1 + carry) || (vs1 == std::numeric_limits<elem_t>::max() && carry);
-        };
+        return carry_funct<0b010011, elem_t>;
     default:
-        throw new std::runtime_error("Unknown funct in get_carry_funct");
+        return nullptr;
+    }
+}
+template <typename elem_t> std::add_pointer_t<bool(elem_t, elem_t, elem_t)> get_carry_funct_ptr(unsigned funct) {
+    if(auto fn = find_carry_funct<elem_t>(funct))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_carry_funct");
+}
+template <typename elem_t> std::function<bool(elem_t, elem_t, elem_t)> get_carry_funct(unsigned funct) {
+    return get_carry_funct_ptr<elem_t>(funct);
+}
+// add (subtract) with carry (borrow) over [vstart, vl), the carry ins come from v0 if use_carry_in is set. With SUM the results go to
+// vd, with CARRY_OUT the carry outs are collected per mask word and written to vcarry after all elements of the word have been read,
+// so vcarry may be v0
+template <unsigned VLEN, unsigned FUNCT6, bool SUM, bool CARRY_OUT, typename elem_t, typename src1_t>
+void carry_chain_loop(uint8_t* V, src1_t src1, uint64_t vl, uint64_t vstart, vtype_t vtype, bool use_carry_in, unsigned vd,
+                      unsigned vcarry, unsigned vs2) {
+    // the sums must neither overwrite the carry ins in v0 nor share a register with the carry outs
+    assert(!SUM || (vd != 0 && (vcarry < vd || vcarry >= vd + (vtype.lmul_log2() > 0 ? 1U << vtype.lmul_log2() : 1U))));
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    auto carry_in_words = get_vmask_words<VLEN>(V);
+    auto carry_out_words = get_vmask_words<VLEN>(V, vcarry);
+    auto vs2_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs2);
+    auto vd_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vd);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t carry_in = use_carry_in ? carry_in_words.get(word) : 0;
+        uint64_t carry_out = 0;
+        for(size_t idx = std::max<uint64_t>(vstart, word * 64); idx < std::min<uint64_t>(vl, word * 64 + 64); idx++) {
+            bool out;
+            elem_t res = add_with_carry<FUNCT6, elem_t>(vs2_elems[idx], src1(idx), carry_in >> (idx % 64) & 1, out);
+            if constexpr(SUM)
+                vd_elems[idx] = res;
+            carry_out |= uint64_t(out) << (idx % 64);
+        }
+        if constexpr(CARRY_OUT)
+            carry_out_words.set(word, carry_out, mask_word_select(word, vstart, vl));
+    }
+    if(!agnostic_undisturbed()) {
+        if constexpr(SUM)
+            if(vtype.vta())
+                for(size_t idx = vl; idx < vlmax; idx++)
+                    vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+        // the tail of a mask result are all elements of the register beyond vl
+        if constexpr(CARRY_OUT)
+            for(size_t word = vl / 64; word < carry_out_words.word_count; word++)
+                carry_out_words.set(word, ~uint64_t(0), mask_word_select(word, vl, VLEN));
     }
 }
 template <unsigned VLEN, typename elem_t>
 void carry_vector_vector_op(uint8_t* V, unsigned funct, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                             unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, vlmax, vd);
-    auto fn = get_carry_funct<elem_t>(funct);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        elem_t carry = vm ? 0 : mask_reg[idx];
-        vd_mask_view[idx] = fn(vs2_view[idx], vs1_view[idx], carry);
+    switch(funct) {
+    case 0b010001: // VMADC
+        return carry_vector_vector_op<VLEN, 0b010001, elem_t>(V, vl, vstart, vtype, vm, vd, vs2, vs1);
+    case 0b010011: // VMSBC
+        return carry_vector_vector_op<VLEN, 0b010011, elem_t>(V, vl, vstart, vtype, vm, vd, vs2, vs1);
+    default:
+        throw new std::runtime_error("Unknown encoding in carry_vector_vector_op");
     }
-    for(size_t idx = vl; idx < vlmax; idx++)
-        vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void carry_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    static_assert(FUNCT6 == 0b010001 || FUNCT6 == 0b010011, "Unknown funct in carry_vector_vector_op"); // VMADC, VMSBC
+    auto vs1_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs1);
+    auto src1 = [vs1_elems](size_t idx) { return vs1_elems[idx]; };
+    carry_chain_loop<VLEN, FUNCT6, false, true, elem_t>(V, src1, vl, vstart, vtype, !vm, 0, vd, vs2);
 }
 template <unsigned VLEN, typename elem_t>
 void carry_vector_imm_op(uint8_t* V, unsigned funct, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                          typename std::make_signed<elem_t>::type imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, vlmax, vd);
-    auto fn = get_carry_funct<elem_t>(funct);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        elem_t carry = vm ? 0 : mask_reg[idx];
-        vd_mask_view[idx] = fn(vs2_view[idx], imm, carry);
+    switch(funct) {
+    case 0b010001: // VMADC
+        return carry_vector_imm_op<VLEN, 0b010001, elem_t>(V, vl, vstart, vtype, vm, vd, vs2, imm);
+    case 0b010011: // VMSBC
+        return carry_vector_imm_op<VLEN, 0b010011, elem_t>(V, vl, vstart, vtype, vm, vd, vs2, imm);
+    default:
+        throw new std::runtime_error("Unknown encoding in carry_vector_imm_op");
+    }
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void carry_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                         typename std::make_signed<elem_t>::type imm) {
+    static_assert(FUNCT6 == 0b010001 || FUNCT6 == 0b010011, "Unknown funct in carry_vector_imm_op"); // VMADC, VMSBC
+    auto src1 = [imm](size_t) { return static_cast<elem_t>(imm); };
+    carry_chain_loop<VLEN, FUNCT6, false, true, elem_t>(V, src1, vl, vstart, vtype, !vm, 0, vd, vs2);
+}
+template <unsigned VLEN, typename elem_t>
+void vector_vector_carry_chain(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry,
+                               unsigned vs2, unsigned vs1) {
+    switch(funct6) {
+    case 0b010000: // VADC
+        return vector_vector_carry_chain<VLEN, 0b010000, elem_t>(V, vl, vstart, vtype, vd, vcarry, vs2, vs1);
+    case 0b010010: // VSBC
+        return vector_vector_carry_chain<VLEN, 0b010010, elem_t>(V, vl, vstart, vtype, vd, vcarry, vs2, vs1);
+    default:
+        throw new std::runtime_error("Unknown encoding in vector_vector_carry_chain");
+    }
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void vector_vector_carry_chain(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry, unsigned vs2,
+                               unsigned vs1) {
+    static_assert(FUNCT6 == 0b010000 || FUNCT6 == 0b010010, "Unknown funct in vector_vector_carry_chain"); // VADC, VSBC
+    auto vs1_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs1);
+    auto src1 = [vs1_elems](size_t idx) { return vs1_elems[idx]; };
+    carry_chain_loop<VLEN, FUNCT6, true, true, elem_t>(V, src1, vl, vstart, vtype, true, vd, vcarry, vs2);
+}
+template <unsigned VLEN, typename elem_t>
+void vector_imm_carry_chain(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry,
+                            unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+    switch(funct6) {
+    case 0b010000: // VADC
+        return vector_imm_carry_chain<VLEN, 0b010000, elem_t>(V, vl, vstart, vtype, vd, vcarry, vs2, imm);
+    case 0b010010: // VSBC
+        return vector_imm_carry_chain<VLEN, 0b010010, elem_t>(V, vl, vstart, vtype, vd, vcarry, vs2, imm);
+    default:
+        throw new std::runtime_error("Unknown encoding in vector_imm_carry_chain");
     }
-    for(size_t idx = vl; idx < vlmax; idx++)
-        vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void vector_imm_carry_chain(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vcarry, unsigned vs2,
+                            typename std::make_signed<elem_t>::type imm) {
+    static_assert(FUNCT6 == 0b010000 || FUNCT6 == 0b010010, "Unknown funct in vector_imm_carry_chain"); // VADC, VSBC
+    auto src1 = [imm](size_t) { return static_cast<elem_t>(imm); };
+    carry_chain_loop<VLEN, FUNCT6, true, true, elem_t>(V, src1, vl, vstart, vtype, true, vd, vcarry, vs2);
 }
 template <typename T> bool get_rounding_increment(T v, uint64_t d, int64_t vxrm) {
     if(d == 0)
@@ -734,7 +2135,7 @@ template <typename T> bool get_rounding_increment(T v, uint64_t d, int64_t vxrm)
     case 0b00:
         return (v >> (d - 1)) & 1;
     case 0b01:
-        return ((v >> (d - 1)) & 1) && (((v & ((1 << (d - 1)) - 1)) != 0) || ((v >> d) & 1));
+        return ((v >> (d - 1)) & 1) && (((v & ((static_cast<T>(1) << (d - 1)) - 1)) != 0) || ((v >> d) & 1));
     case 0b10:
         return false;
     case 0b11:
@@ -746,257 +2147,887 @@ template <typename T> T roundoff(T v, uint64_t d, int64_t vxrm) {
     unsigned r = get_rounding_increment(v, d, vxrm);
     return (v >> d) + r;
 }
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+bool sat_funct(uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b100000) { // VSADDU
+            auto res = static_cast<twice_t<src1_elem_t>>(vs2) + static_cast<twice_t<src1_elem_t>>(vs1);
+            if(res > std::numeric_limits<dest_elem_t>::max()) {
+                vd = std::numeric_limits<dest_elem_t>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b100001) { // VSADD
+            auto res = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) +
+                       static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
+            if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+                return 1;
+            } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b100010) { // VSSUBU
+            if(vs2 < vs1) {
+                vd = 0;
+                return 1;
+            } else {
+                vd = vs2 - vs1;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b100011) { // VSSUB
+            auto res = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) -
+                       static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
+            if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+                return 1;
+            } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b100111) { // VSMUL
+            auto big_val = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) *
+                           static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
+            auto res = roundoff(big_val, vtype.sew() - 1, vxrm);
+            if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+                return 1;
+            } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b101010) { // VSSRL
+            vd = roundoff(vs2, vs1 & shift_mask<src1_elem_t>(), vxrm);
+            return 0;
+        } else if constexpr(FUNCT6 == 0b101011) { // VSSRA
+            vd = roundoff(static_cast<std::make_signed_t<src2_elem_t>>(vs2), vs1 & shift_mask<src1_elem_t>(), vxrm);
+            return 0;
+        } else if constexpr(FUNCT6 == 0b101110) { // VNCLIPU
+            auto res = roundoff(vs2, vs1 & shift_mask<src2_elem_t>(), vxrm);
+            if(res > std::numeric_limits<dest_elem_t>::max()) {
+                vd = std::numeric_limits<dest_elem_t>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else if constexpr(FUNCT6 == 0b101111) { // VNCLIP
+            auto res = roundoff(static_cast<std::make_signed_t<src2_elem_t>>(vs2), vs1 & shift_mask<src2_elem_t>(), vxrm);
+            if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+                return 1;
+            } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
+                vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
+                return 1;
+            } else {
+                vd = res;
+                return 0;
+            }
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in sat_funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        if constexpr(FUNCT6 == 0b001000) { // VAADDU
+            auto res = static_cast<dest_elem_t>(vs2) + static_cast<twice_t<src1_elem_t>>(vs1);
+            vd = roundoff(res, 1, vxrm);
+            return 0;
+        } else if constexpr(FUNCT6 == 0b001001) { // VAADD
+            auto res = sext<twice_t<src2_elem_t>>(vs2) + sext<twice_t<src1_elem_t>>(vs1);
+            vd = roundoff(res, 1, vxrm);
+            return 0;
+        } else if constexpr(FUNCT6 == 0b001010) { // VASUBU
+            auto res = static_cast<dest_elem_t>(vs2) - static_cast<twice_t<src1_elem_t>>(vs1);
+            vd = roundoff(res, 1, vxrm);
+            return 0;
+        } else if constexpr(FUNCT6 == 0b001011) { // VASUB
+            auto res = sext<twice_t<src2_elem_t>>(vs2) - sext<twice_t<src1_elem_t>>(vs1);
+            vd = roundoff(res, 1, vxrm);
+            return 0;
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in sat_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in sat_funct");
+}
 template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
-std::function<bool(uint64_t, vtype_t, dest_elem_t&, src2_elem_t, src1_elem_t)> get_sat_funct(unsigned funct6, unsigned funct3) {
+std::add_pointer_t<bool(uint64_t, vtype_t, dest_elem_t&, src2_elem_t, src1_elem_t)> find_sat_funct(unsigned funct6,
+                                                                                                   unsigned funct3) noexcept {
     if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
         switch(funct6) {
         case 0b100000: // VSADDU
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = static_cast<twice_t<src1_elem_t>>(vs2) + static_cast<twice_t<src1_elem_t>>(vs1);
-                if(res > std::numeric_limits<dest_elem_t>::max()) {
-                    vd = std::numeric_limits<dest_elem_t>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b100000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100001: // VSADD
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) +
-                           static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
-                if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                    return 1;
-                } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b100001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100010: // VSSUBU
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                if(vs2 < vs1) {
-                    vd = 0;
-                    return 1;
-                } else {
-                    vd = vs2 - vs1;
-                    return 0;
-                }
-            };
+            return sat_funct<0b100010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100011: // VSSUB
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) -
-                           static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
-                if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                    return 1;
-                } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b100011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100111: // VSMUL
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto big_val = static_cast<twice_t<std::make_signed_t<src2_elem_t>>>(static_cast<std::make_signed_t<src2_elem_t>>(vs2)) *
-                               static_cast<twice_t<std::make_signed_t<src1_elem_t>>>(static_cast<std::make_signed_t<src1_elem_t>>(vs1));
-                auto res = roundoff(big_val, vtype.sew() - 1, vxrm);
-                if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                    return 1;
-                } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b100111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101010: // VSSRL
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                vd = roundoff(vs2, vs1 & shift_mask<src1_elem_t>(), vxrm);
-                return 0;
-            };
+            return sat_funct<0b101010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101011: // VSSRA
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                vd = roundoff(static_cast<std::make_signed_t<src2_elem_t>>(vs2), vs1 & shift_mask<src1_elem_t>(), vxrm);
-                return 0;
-            };
+            return sat_funct<0b101011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101110: // VNCLIPU
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = roundoff(vs2, vs1 & shift_mask<src2_elem_t>(), vxrm);
-                if(res > std::numeric_limits<dest_elem_t>::max()) {
-                    vd = std::numeric_limits<dest_elem_t>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b101110, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101111: // VNCLIP
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = roundoff(static_cast<std::make_signed_t<src2_elem_t>>(vs2), vs1 & shift_mask<src2_elem_t>(), vxrm);
-                if(res < std::numeric_limits<std::make_signed_t<dest_elem_t>>::min()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                    return 1;
-                } else if(res > std::numeric_limits<std::make_signed_t<dest_elem_t>>::max()) {
-                    vd = std::numeric_limits<std::make_signed_t<dest_elem_t>>::max();
-                    return 1;
-                } else {
-                    vd = res;
-                    return 0;
-                }
-            };
+            return sat_funct<0b101111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_sat_funct");
+            return nullptr;
         }
     else if(funct3 == OPMVV || funct3 == OPMVX)
         switch(funct6) {
         case 0b001000: // VAADDU
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = static_cast<dest_elem_t>(vs2) + static_cast<twice_t<src1_elem_t>>(vs1);
-                vd = roundoff(res, 1, vxrm);
-                return 0;
-            };
+            return sat_funct<0b001000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001001: // VAADD
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = sext<twice_t<src2_elem_t>>(vs2) + sext<twice_t<src1_elem_t>>(vs1);
-                vd = roundoff(res, 1, vxrm);
-                return 0;
-            };
+            return sat_funct<0b001001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001010: // VASUBU
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = static_cast<dest_elem_t>(vs2) - static_cast<twice_t<src1_elem_t>>(vs1);
-                vd = roundoff(res, 1, vxrm);
-                return 0;
-            };
+            return sat_funct<0b001010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001011: // VASUB
-            return [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
-                auto res = sext<twice_t<src2_elem_t>>(vs2) - sext<twice_t<src1_elem_t>>(vs1);
-                vd = roundoff(res, 1, vxrm);
-                return 0;
-            };
+            return sat_funct<0b001011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_sat_funct");
+            return nullptr;
         }
     else
-        throw new std::runtime_error("Unknown funct3 in get_sat_funct");
+        return nullptr;
 }
-template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-bool sat_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
-                          unsigned vd, unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::add_pointer_t<bool(uint64_t, vtype_t, dest_elem_t&, src2_elem_t, src1_elem_t)> get_sat_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_sat_funct");
+}
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::function<bool(uint64_t, vtype_t, dest_elem_t&, src2_elem_t, src1_elem_t)> get_sat_funct(unsigned funct6, unsigned funct3) {
+    return get_sat_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+}
+// roundoff of the lanes of v shifted right by d, a scalar or a vector of counts below the lane width. The increment is the carry out of
+// the d bits shifted out plus a bias: half - 1 and bit 0 of the result for RNE, all ones for ROD (a compare would be lowered element
+// wise). mask & 1 clears the bias and the tie break for d of 0
+template <unsigned VXRM, typename vec_t, typename shamt_t> void simd_roundoff(vec_t& res, const vec_t& v, const shamt_t& d) {
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(simd_elem_t<vec_t>);
+    using unsigned_vec_t = typename simd_vec<std::make_unsigned_t<simd_elem_t<vec_t>>, lanes>::type;
+    using count_t = std::conditional_t<std::is_integral_v<shamt_t>, shamt_t, unsigned_vec_t>;
+    count_t count = (count_t)d;
+    unsigned_vec_t mask = ((1 - unsigned_vec_t{}) << count) - 1;
+    unsigned_vec_t shifted_out = (unsigned_vec_t)v & mask;
+    res = v >> (std::conditional_t<std::is_integral_v<shamt_t>, shamt_t, vec_t>)d;
+    if constexpr(VXRM == 0b00) // RNU
+        res += (vec_t)((shifted_out + (mask ^ (mask >> 1))) >> count);
+    else if constexpr(VXRM == 0b01) // RNE
+        res += (vec_t)((shifted_out + (mask >> 1) + ((unsigned_vec_t)res & mask & 1)) >> count);
+    else if constexpr(VXRM == 0b11) // ROD
+        res |= (vec_t)((shifted_out + mask) >> count);
+}
+// the fixed-point counterpart of simd_funct with the rounding mode VXRM, sat receives all ones in the lanes that saturated. vs1 is a
+// vector or, for the shifts and clips, a scalar count
+template <unsigned FUNCT6, unsigned FUNCT3, unsigned VXRM, typename vec_t, typename src2_vec_t, typename src1_t>
+void simd_sat_funct(vec_t& res, vec_t& sat, const src2_vec_t& vs2, const src1_t& vs1) {
+    using elem_t = simd_elem_t<vec_t>;
+    using src2_elem_t = simd_elem_t<src2_vec_t>;
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(elem_t);
+    using signed_vec_t = typename simd_vec<std::make_signed_t<elem_t>, lanes>::type;
+    using signed_src2_vec_t = typename simd_vec<std::make_signed_t<src2_elem_t>, lanes>::type;
+    constexpr elem_t signed_max = std::numeric_limits<std::make_signed_t<elem_t>>::max();
+    // the shift count in lanes of src2 or as scalar, a variable as returning a host vector from a lambda would depend on the ABI
+    constexpr bool shift = FUNCT6 == 0b101010 || FUNCT6 == 0b101011 || FUNCT6 == 0b101110 || FUNCT6 == 0b101111;
+    std::conditional_t<std::is_integral_v<src1_t>, src2_elem_t, src2_vec_t> shamt{};
+    if constexpr(shift && std::is_integral_v<src1_t>)
+        shamt = static_cast<src2_elem_t>(vs1 & shift_mask<src2_elem_t>());
+    else if constexpr(shift) {
+        simd_convert<false>(shamt, vs1);
+        shamt &= shift_mask<src2_elem_t>();
+    }
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b100000) { // VSADDU
+            res = vs2 + vs1;
+            sat = (vec_t)(res < vs2);
+            res |= sat;
+        } else if constexpr(FUNCT6 == 0b100001 || FUNCT6 == 0b100011) { // VSADD, VSSUB
+            // the wrapped result overflowed if its sign differs from the one of vs2 and the one of vs1 for an addition, of -vs1 for a
+            // subtraction. It saturates towards the sign of vs2. The sign masks are negated logical shifts, GCC lowers a signed compare
+            // or arithmetic shift of bytes element wise
+            constexpr unsigned sign_bit = sizeof(elem_t) * 8 - 1;
+            if constexpr(FUNCT6 == 0b100001) {
+                res = vs2 + vs1;
+                sat = 0 - (((vs2 ^ res) & (vs1 ^ res)) >> sign_bit);
+            } else {
+                res = vs2 - vs1;
+                sat = 0 - (((vs2 ^ vs1) & (vs2 ^ res)) >> sign_bit);
+            }
+            vec_t limit = (0 - (vs2 >> sign_bit)) ^ signed_max;
+            res = (res & ~sat) | (limit & sat);
+        } else if constexpr(FUNCT6 == 0b100010) { // VSSUBU
+            sat = (vec_t)(vs2 < vs1);
+            res = (vs2 - vs1) & ~sat;
+        } else if constexpr(FUNCT6 == 0b100111) { // VSMUL, SEW 8 to 32. Only MIN * MIN exceeds the range
+            using wide_vec_t = typename simd_vec<std::make_signed_t<twice_t<elem_t>>, lanes>::type;
+            using unsigned_wide_vec_t = typename simd_vec<twice_t<elem_t>, lanes>::type;
+            wide_vec_t wide_vs2, wide_vs1, wide;
+            simd_convert<true>(wide_vs2, vs2);
+            simd_convert<true>(wide_vs1, vs1);
+            simd_roundoff<VXRM>(wide, wide_vs2 * wide_vs1, sizeof(elem_t) * 8 - 1);
+            // the sign of signed_max - wide flags the overflow, a compare would be narrowed element wise
+            simd_convert<false>(sat, (unsigned_wide_vec_t)(signed_max - wide) >> (sizeof(elem_t) * 16 - 1));
+            simd_convert<false>(res, wide);
+            sat = 0 - sat;
+            res = (res & ~sat) | (sat & signed_max);
+        } else if constexpr(FUNCT6 == 0b101010) { // VSSRL
+            simd_roundoff<VXRM>(res, vs2, shamt);
+            sat = vec_t{};
+        } else if constexpr(FUNCT6 == 0b101011) { // VSSRA
+            signed_vec_t shifted;
+            simd_roundoff<VXRM>(shifted, (signed_vec_t)vs2, shamt);
+            res = (vec_t)shifted;
+            sat = vec_t{};
+        } else if constexpr(FUNCT6 == 0b101110 || FUNCT6 == 0b101111) { // VNCLIPU, VNCLIP
+            // the lanes out of range have a non-zero upper half, offset by signed_max + 1 for VNCLIP. The overflow flag is the sign of its
+            // negation and, as for VSMUL, narrowed from bit 0
+            constexpr unsigned bits = sizeof(elem_t) * 8;
+            src2_vec_t wide;
+            vec_t negative{};
+            if constexpr(FUNCT6 == 0b101110)
+                simd_roundoff<VXRM>(wide, vs2, shamt);
+            else {
+                signed_src2_vec_t signed_wide;
+                simd_roundoff<VXRM>(signed_wide, (signed_src2_vec_t)vs2, shamt);
+                wide = (src2_vec_t)signed_wide;
+                simd_convert<false>(negative, wide >> (2 * bits - 1));
+            }
+            src2_vec_t upper = (FUNCT6 == 0b101110 ? wide : wide + signed_max + 1) >> bits;
+            simd_convert<false>(sat, (0 - upper) >> (2 * bits - 1));
+            simd_convert<false>(res, wide);
+            sat = 0 - sat;
+            if constexpr(FUNCT6 == 0b101110)
+                res |= sat;
+            else
+                res = (res & ~sat) | (sat & (signed_max + negative));
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_sat_funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        // the averages without widening: vs2 + vs1 is 2 * (vs2 & vs1) + (vs2 ^ vs1) and vs2 - vs1 is (vs2 ^ vs1) - 2 * (~vs2 & vs1),
+        // bit 0 of vs2 ^ vs1 is the one shifted out
+        vec_t half = (vs2 ^ vs1) >> 1;
+        if constexpr(FUNCT6 & 1) // VAADD, VASUB
+            half = (vec_t)((signed_vec_t)(vs2 ^ vs1) >> 1);
+        if constexpr(FUNCT6 == 0b001000 || FUNCT6 == 0b001001) // VAADDU, VAADD
+            res = (vs2 & vs1) + half;
+        else if constexpr(FUNCT6 == 0b001010 || FUNCT6 == 0b001011) // VASUBU, VASUB
+            res = half - (~vs2 & vs1);
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_sat_funct");
+        vec_t shifted_out = (vs2 ^ vs1) & 1;
+        if constexpr(VXRM == 0b00) // RNU
+            res += shifted_out;
+        else if constexpr(VXRM == 0b01) // RNE
+            res += shifted_out & res;
+        else if constexpr(VXRM == 0b11) // ROD
+            res |= shifted_out;
+        sat = vec_t{};
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in simd_sat_funct");
+}
+// the operations with a simd_sat_funct implementation for these element types
+template <typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+constexpr bool has_simd_sat_funct(unsigned funct6, unsigned funct3) {
+    constexpr bool single_width = std::is_same_v<dest_elem_t, src2_elem_t> && std::is_same_v<dest_elem_t, src1_elem_t>;
+    constexpr bool narrowing = sizeof(src2_elem_t) == 2 * sizeof(dest_elem_t) && std::is_same_v<dest_elem_t, src1_elem_t>;
+    if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
+        switch(funct6) {
+        case 0b100000: // VSADDU
+        case 0b100001: // VSADD
+        case 0b100010: // VSSUBU
+        case 0b100011: // VSSUB
+        case 0b100111: // VSMUL
+        case 0b101010: // VSSRL
+        case 0b101011: // VSSRA
+            return single_width;
+        case 0b101110: // VNCLIPU
+        case 0b101111: // VNCLIP
+            return narrowing;
+        default:
+            return false;
+        }
+    if(funct3 == OPMVV || funct3 == OPMVX)
+        return funct6 >= 0b001000 && funct6 <= 0b001011 && single_width; // VAADDU, VAADD, VASUBU, VASUB
+    return false;
+}
+// .vv (vs1_elems set) or .vx/.vi (scalar) form of a simd_sat_funct operation with the rounding mode VXRM, returns vxsat. The saturated
+// lanes of the blocks are collected in a host vector and reduced at the end
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, unsigned VXRM, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+bool simd_sat_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                   const src1_elem_t* vs1_elems, src1_elem_t scalar, const dest_elem_t* lanes) {
+    constexpr size_t block = simd_block<dest_elem_t, src2_elem_t>;
+    using vec_t = typename simd_vec<dest_elem_t, block>::type;
+    using src2_vec_t = typename simd_vec<src2_elem_t, block>::type;
+    using src1_vec_t = typename simd_vec<src1_elem_t, block>::type;
+    auto vd_elems = reinterpret_cast<const dest_elem_t*>(V + VLEN / 8 * vd);
+    auto vs2_elems = reinterpret_cast<const src2_elem_t*>(V + VLEN / 8 * vs2);
+    src1_vec_t broadcast = scalar - src1_vec_t{};
+    // as the multiply-highs of simd_vector_loop, VSMUL of SEW 64 is computed per element
+    constexpr bool element_wise = sizeof(dest_elem_t) == 8 && FUNCT3 == OPIVV && FUNCT6 == 0b100111;
+    constexpr bool scalar_count = FUNCT3 == OPIVV && FUNCT6 >= 0b101010; // VSSRL, VSSRA, VNCLIPU, VNCLIP
     bool saturated = false;
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    vec_t saturated_lanes{};
+    auto block_fn = [&](size_t idx, auto& res) {
+        src2_vec_t src2;
+        src1_vec_t src1 = broadcast;
+        vec_t sat;
+        memcpy(&src2, vs2_elems + idx, sizeof(src2_vec_t));
+        if(vs1_elems) {
+            memcpy(&src1, vs1_elems + idx, sizeof(src1_vec_t));
+            simd_sat_funct<FUNCT6, FUNCT3, VXRM>(res, sat, src2, src1);
+        } else if constexpr(scalar_count)
+            simd_sat_funct<FUNCT6, FUNCT3, VXRM>(res, sat, src2, scalar);
+        else
+            simd_sat_funct<FUNCT6, FUNCT3, VXRM>(res, sat, src2, src1);
+        if(!vm) {
+            vec_t active;
+            simd_active_lanes(active, V, idx, lanes);
+            sat &= active;
+        }
+        saturated_lanes |= sat;
+    };
+    auto elem_fn = [&](size_t idx) {
+        dest_elem_t res = vd_elems[idx];
+        saturated |= sat_funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(VXRM, cfg.vtype, res, vs2_elems[idx],
+                                                                                      vs1_elems ? vs1_elems[idx] : scalar);
+        return res;
+    };
+    simd_body_loop<VLEN, block, element_wise>(V, vl, vstart, cfg, vm, vd, lanes, block_fn, elem_fn);
+    for(size_t i = 0; i < block; i++)
+        saturated |= saturated_lanes[i] != 0;
+    return saturated;
+}
+// simd_sat_loop for the rounding mode vxrm
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+bool simd_sat_vxrm_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, int64_t vxrm, bool vm, unsigned vd, unsigned vs2,
+                        const src1_elem_t* vs1_elems, src1_elem_t scalar, const dest_elem_t* lanes) {
+    switch(vxrm & 0b11) {
+    case 0b00:
+        return simd_sat_loop<VLEN, FUNCT6, FUNCT3, 0b00, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg, vm, vd, vs2, vs1_elems,
+                                                                                                scalar, lanes);
+    case 0b01:
+        return simd_sat_loop<VLEN, FUNCT6, FUNCT3, 0b01, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg, vm, vd, vs2, vs1_elems,
+                                                                                                scalar, lanes);
+    case 0b10:
+        return simd_sat_loop<VLEN, FUNCT6, FUNCT3, 0b10, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg, vm, vd, vs2, vs1_elems,
+                                                                                                scalar, lanes);
+    default:
+        return simd_sat_loop<VLEN, FUNCT6, FUNCT3, 0b11, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg, vm, vd, vs2, vs1_elems,
+                                                                                                scalar, lanes);
+    }
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+using simd_sat_loop_t = bool (*)(uint8_t*, uint64_t, uint64_t, const vconfig_t&, int64_t, bool, unsigned, unsigned, const src1_elem_t*,
+                                 src1_elem_t, const dest_elem_t*);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+constexpr simd_sat_loop_t<VLEN, dest_elem_t, src1_elem_t> simd_sat_loop_for() {
+    if constexpr(has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return simd_sat_vxrm_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>;
+    else
+        return nullptr;
+}
+// the simd_sat_vxrm_loop for an encoding, nullptr if there is none for the element types
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+simd_sat_loop_t<VLEN, dest_elem_t, src1_elem_t> find_simd_sat_loop(unsigned funct6, unsigned funct3) noexcept {
+    if(!has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return nullptr;
+    if(funct3 == OPMVV || funct3 == OPMVX)
+        switch(funct6) {
+        case 0b001000: // VAADDU
+            return simd_sat_loop_for<VLEN, 0b001000, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001001: // VAADD
+            return simd_sat_loop_for<VLEN, 0b001001, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001010: // VASUBU
+            return simd_sat_loop_for<VLEN, 0b001010, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        case 0b001011: // VASUB
+            return simd_sat_loop_for<VLEN, 0b001011, OPMVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+        default:
+            return nullptr;
+        }
+    switch(funct6) {
+    case 0b100000: // VSADDU
+        return simd_sat_loop_for<VLEN, 0b100000, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b100001: // VSADD
+        return simd_sat_loop_for<VLEN, 0b100001, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b100010: // VSSUBU
+        return simd_sat_loop_for<VLEN, 0b100010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b100011: // VSSUB
+        return simd_sat_loop_for<VLEN, 0b100011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b100111: // VSMUL
+        return simd_sat_loop_for<VLEN, 0b100111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b101010: // VSSRL
+        return simd_sat_loop_for<VLEN, 0b101010, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b101011: // VSSRA
+        return simd_sat_loop_for<VLEN, 0b101011, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b101110: // VNCLIPU
+        return simd_sat_loop_for<VLEN, 0b101110, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    case 0b101111: // VNCLIP
+        return simd_sat_loop_for<VLEN, 0b101111, OPIVV, dest_elem_t, src2_elem_t, src1_elem_t>();
+    default:
+        return nullptr;
+    }
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+bool sat_vector_vector_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, int64_t vxrm, bool vm, unsigned vd,
+                            unsigned vs2, unsigned vs1) {
+    bool saturated = false;
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
         if(mask_active)
-            saturated |= fn(vxrm, vtype, vd_view[idx], vs2_view[idx], vs1_view[idx]);
-        else if(vtype.vma())
+            saturated |= fn(vxrm, cfg.vtype, vd_view[idx], vs2_view[idx], vs1_view[idx]);
+        else if(cfg.vma)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
     }
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++) {
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++) {
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
         }
     return saturated;
 }
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-bool sat_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
-                       unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+bool sat_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
+                          unsigned vd, unsigned vs2, unsigned vs1) {
+    auto fn = get_sat_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0,
+                         nullptr);
+    return sat_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2,
+                                                                               vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+bool sat_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm, unsigned vd, unsigned vs2,
+                          unsigned vs1) {
+    if constexpr(has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return simd_sat_vxrm_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(
+            V, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0, nullptr);
+    auto fn = [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return sat_funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vxrm, vtype, vd, vs2, vs1);
+    };
+    return sat_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2,
+                                                                               vs1);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t sat_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    return vstatus_t::ok(
+        sat_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, rm, op.vm, op.vd, op.vs2, op.vs1));
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+vstatus_t simd_sat_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t,
+                                      uint8_t rm) noexcept {
+    auto simd_loop = reinterpret_cast<simd_sat_loop_t<VLEN, dest_elem_t, src1_elem_t>>(op.elem_fn);
+    return vstatus_t::ok(
+        simd_loop(V, vl, vstart, op.cfg, rm, op.vm, op.vd, op.vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * op.vs1), 0, nullptr));
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_sat_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                               unsigned vs1) noexcept {
+    auto fn = find_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return {simd_sat_vector_vector_exec<VLEN, dest_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(simd_loop),
+                vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, true};
+    return {sat_vector_vector_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN),
+            vm, vd, vs2, vs1, true};
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+bool sat_vector_imm_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, int64_t vxrm, bool vm, unsigned vd,
+                         unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
     bool saturated = false;
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
         if(mask_active)
-            saturated |= fn(vxrm, vtype, vd_view[idx], vs2_view[idx], imm);
-        else if(vtype.vma())
+            saturated |= fn(vxrm, cfg.vtype, vd_view[idx], vs2_view[idx], imm);
+        else if(cfg.vma)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
     }
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++) {
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++) {
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
         }
     return saturated;
 }
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+bool sat_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm,
+                       unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+    auto fn = get_sat_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2, nullptr, imm, nullptr);
+    return sat_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2,
+                                                                            imm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+bool sat_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, int64_t vxrm, bool vm, unsigned vd, unsigned vs2,
+                       typename std::make_signed<src1_elem_t>::type imm) {
+    if constexpr(has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+        return simd_sat_vxrm_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, vconfig_t(vtype, VLEN), vxrm,
+                                                                                               vm, vd, vs2, nullptr, imm, nullptr);
+    auto fn = [](uint64_t vxrm, vtype_t vtype, dest_elem_t& vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return sat_funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vxrm, vtype, vd, vs2, vs1);
+    };
+    return sat_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vxrm, vm, vd, vs2,
+                                                                            imm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t sat_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    auto imm = static_cast<typename std::make_signed<src1_elem_t>::type>(scalar);
+    return vstatus_t::ok(
+        sat_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, rm, op.vm, op.vd, op.vs2, imm));
+}
+template <unsigned VLEN, typename dest_elem_t, typename src1_elem_t>
+vstatus_t simd_sat_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar,
+                                   uint8_t rm) noexcept {
+    auto simd_loop = reinterpret_cast<simd_sat_loop_t<VLEN, dest_elem_t, src1_elem_t>>(op.elem_fn);
+    return vstatus_t::ok(simd_loop(V, vl, vstart, op.cfg, rm, op.vm, op.vd, op.vs2, nullptr, static_cast<src1_elem_t>(scalar), nullptr));
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_sat_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept {
+    auto fn = find_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return {simd_sat_vector_imm_exec<VLEN, dest_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(simd_loop), vconfig_t(vtype, VLEN),
+                vm, vd, vs2, 0, true};
+    return {sat_vector_imm_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm,
+            vd, vs2, 0, true};
+}
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+void red_funct(dest_elem_t& running_total, src_elem_t vs2) {
+    if constexpr(FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI) {
+        if constexpr(FUNCT6 == 0b110000) // VWREDSUMU
+            running_total += static_cast<dest_elem_t>(vs2);
+        else if constexpr(FUNCT6 == 0b110001) // VWREDSUM
+            // cast the signed vs2 elem to unsigned to enable wrap around on overflow
+            running_total += static_cast<dest_elem_t>(sext<dest_elem_t>(vs2));
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in red_funct");
+    } else if constexpr(FUNCT3 == OPMVV || FUNCT3 == OPMVX) {
+        if constexpr(FUNCT6 == 0b000000) // VREDSUM
+            running_total += vs2;
+        else if constexpr(FUNCT6 == 0b000001) // VREDAND
+            running_total &= vs2;
+        else if constexpr(FUNCT6 == 0b000010) // VREDOR
+            running_total |= vs2;
+        else if constexpr(FUNCT6 == 0b000011) // VREDXOR
+            running_total ^= vs2;
+        else if constexpr(FUNCT6 == 0b000100) // VREDMINU
+            running_total = std::min<dest_elem_t>(running_total, vs2);
+        else if constexpr(FUNCT6 == 0b000101) // VREDMIN
+            running_total = std::min(static_cast<std::make_signed_t<dest_elem_t>>(running_total),
+                                     static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src_elem_t>>(vs2)));
+        else if constexpr(FUNCT6 == 0b000110) // VREDMAXU
+            running_total = std::max(running_total, static_cast<dest_elem_t>(vs2));
+        else if constexpr(FUNCT6 == 0b000111) // VREDMAX
+            running_total = std::max(static_cast<std::make_signed_t<dest_elem_t>>(running_total),
+                                     static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src_elem_t>>(vs2)));
+        else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in red_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in red_funct");
+}
 template <typename dest_elem_t, typename src_elem_t>
-std::function<void(dest_elem_t&, src_elem_t)> get_red_funct(unsigned funct6, unsigned funct3) {
+std::add_pointer_t<void(dest_elem_t&, src_elem_t)> find_red_funct(unsigned funct6, unsigned funct3) noexcept {
     if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
         switch(funct6) {
         case 0b110000: // VWREDSUMU
-            return [](dest_elem_t& running_total, src_elem_t vs2) { return running_total += static_cast<dest_elem_t>(vs2); };
+            return red_funct<0b110000, OPIVV, dest_elem_t, src_elem_t>;
         case 0b110001: // VWREDSUM
-            return [](dest_elem_t& running_total, src_elem_t vs2) {
-                // cast the signed vs2 elem to unsigned to enable wrap around on overflow
-                return running_total += static_cast<dest_elem_t>(sext<dest_elem_t>(vs2));
-            };
+            return red_funct<0b110001, OPIVV, dest_elem_t, src_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_red_funct");
+            return nullptr;
         }
     else if(funct3 == OPMVV || funct3 == OPMVX)
         switch(funct6) {
         case 0b000000: // VREDSUM
-            return [](dest_elem_t& running_total, src_elem_t vs2) { return running_total += vs2; };
+            return red_funct<0b000000, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000001: // VREDAND
-            return [](dest_elem_t& running_total, src_elem_t vs2) { return running_total &= vs2; };
+            return red_funct<0b000001, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000010: // VREDOR
-            return [](dest_elem_t& running_total, src_elem_t vs2) { return running_total |= vs2; };
+            return red_funct<0b000010, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000011: // VREDXOR
-            return [](dest_elem_t& running_total, src_elem_t vs2) { running_total ^= vs2; };
+            return red_funct<0b000011, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000100: // VREDMINU
-            return [](dest_elem_t& running_total, src_elem_t vs2) { running_total = std::min<dest_elem_t>(running_total, vs2); };
+            return red_funct<0b000100, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000101: // VREDMIN
-            return [](dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = std::min(static_cast<std::make_signed_t<dest_elem_t>>(running_total),
-                                         static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src_elem_t>>(vs2)));
-            };
+            return red_funct<0b000101, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000110: // VREDMAXU
-            return
-                [](dest_elem_t& running_total, src_elem_t vs2) { running_total = std::max(running_total, static_cast<dest_elem_t>(vs2)); };
+            return red_funct<0b000110, OPMVV, dest_elem_t, src_elem_t>;
         case 0b000111: // VREDMAX
-            return [](dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = std::max(static_cast<std::make_signed_t<dest_elem_t>>(running_total),
-                                         static_cast<std::make_signed_t<dest_elem_t>>(static_cast<std::make_signed_t<src_elem_t>>(vs2)));
-            };
+            return red_funct<0b000111, OPMVV, dest_elem_t, src_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_red_funct");
+            return nullptr;
+        }
+    else
+        return nullptr;
+}
+template <typename dest_elem_t, typename src_elem_t>
+std::add_pointer_t<void(dest_elem_t&, src_elem_t)> get_red_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_red_funct<dest_elem_t, src_elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_red_funct");
+}
+template <typename dest_elem_t, typename src_elem_t>
+std::function<void(dest_elem_t&, src_elem_t)> get_red_funct(unsigned funct6, unsigned funct3) {
+    return get_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename funct_t>
+void vector_red_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                     unsigned vs1) {
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    dest_elem_t running_total = get_vreg<VLEN, dest_elem_t>(V, vs1, cfg.vlmax)[0];
+    auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, cfg.vlmax);
+    // vd may be vs2 or vs1, element 0 is written once all of them are read
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool mask_active = vm ? 1 : mask_reg[idx];
+        if(mask_active) {
+            fn(running_total, vs2_view[idx]);
+        }
+    }
+    vd_elems[0] = running_total;
+    // the tail is all elements of the destination register beyond the first one, counted in the destination EEW
+    if(cfg.vta)
+        for(size_t idx = 1; idx < VLEN / 8 / sizeof(dest_elem_t); idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+// the identity of a reduction, the value of the lanes of the SIMD accumulators that are inactive
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t> constexpr dest_elem_t red_identity() {
+    using signed_t = std::make_signed_t<dest_elem_t>;
+    if constexpr(FUNCT3 == OPMVV && (FUNCT6 == 0b000001 || FUNCT6 == 0b000100)) // VREDAND, VREDMINU
+        return std::numeric_limits<dest_elem_t>::max();
+    else if constexpr(FUNCT3 == OPMVV && FUNCT6 == 0b000101) // VREDMIN
+        return std::numeric_limits<signed_t>::max();
+    else if constexpr(FUNCT3 == OPMVV && FUNCT6 == 0b000111) // VREDMAX
+        return static_cast<dest_elem_t>(std::numeric_limits<signed_t>::min());
+    else
+        return 0;
+}
+// folds the lanes of vs2 into the ones of the accumulator acc, the widening sums get vs2 already extended
+template <unsigned FUNCT6, unsigned FUNCT3, typename vec_t> void simd_red_funct(vec_t& acc, const vec_t& vs2) {
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(simd_elem_t<vec_t>);
+    using signed_vec_t = typename simd_vec<std::make_signed_t<simd_elem_t<vec_t>>, lanes>::type;
+    if constexpr(FUNCT3 == OPIVV || FUNCT6 == 0b000000) // VWREDSUMU, VWREDSUM, VREDSUM
+        acc += vs2;
+    else if constexpr(FUNCT6 == 0b000001) // VREDAND
+        acc &= vs2;
+    else if constexpr(FUNCT6 == 0b000010) // VREDOR
+        acc |= vs2;
+    else if constexpr(FUNCT6 == 0b000011) // VREDXOR
+        acc ^= vs2;
+    else if constexpr(FUNCT6 == 0b000100) // VREDMINU
+        acc = vs2 < acc ? vs2 : acc;
+    else if constexpr(FUNCT6 == 0b000110) // VREDMAXU
+        acc = vs2 > acc ? vs2 : acc;
+    else if constexpr(FUNCT6 == 0b000101 || FUNCT6 == 0b000111) { // VREDMIN, VREDMAX
+        // selecting between operands of the signedness of the compare, GCC lowers a mixed one element wise
+        signed_vec_t signed_acc = (signed_vec_t)acc, signed_vs2 = (signed_vec_t)vs2;
+        if constexpr(FUNCT6 == 0b000101)
+            acc = (vec_t)(signed_vs2 < signed_acc ? signed_vs2 : signed_acc);
+        else
+            acc = (vec_t)(signed_vs2 > signed_acc ? signed_vs2 : signed_acc);
+    }
+    else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in simd_red_funct");
+}
+// the lanes of acc reduced as a tree, each step folds the upper half of the lanes into the lower one
+template <unsigned FUNCT6, unsigned FUNCT3, typename vec_t> simd_elem_t<vec_t> simd_red_lanes(const vec_t& acc) {
+    constexpr size_t lanes = sizeof(vec_t) / sizeof(simd_elem_t<vec_t>);
+    if constexpr(lanes == 1)
+        return acc[0];
+    else {
+        using half_vec_t = typename simd_vec<simd_elem_t<vec_t>, lanes / 2>::type;
+        half_vec_t low, high;
+        memcpy(&low, &acc, sizeof(half_vec_t));
+        memcpy(&high, reinterpret_cast<const uint8_t*>(&acc) + sizeof(half_vec_t), sizeof(half_vec_t));
+        simd_red_funct<FUNCT6, FUNCT3>(low, high);
+        return simd_red_lanes<FUNCT6, FUNCT3>(low);
+    }
+}
+// the reductions with a simd_red_funct implementation for these element types
+template <typename dest_elem_t, typename src_elem_t> constexpr bool has_simd_red_funct(unsigned funct6, unsigned funct3) {
+    if(funct3 == OPIVV || funct3 == OPIVX || funct3 == OPIVI)
+        return (funct6 == 0b110000 || funct6 == 0b110001) && sizeof(dest_elem_t) == 2 * sizeof(src_elem_t); // VWREDSUMU, VWREDSUM
+    if(funct3 == OPMVV || funct3 == OPMVX)
+        return funct6 <= 0b000111 && std::is_same_v<dest_elem_t, src_elem_t>;
+    return false;
+}
+// reduction of the active elements of vs2 in [vstart, vl) and element 0 of vs1 into element 0 of vd. The aligned blocks go to
+// independent accumulators with the inactive lanes set to the identity, the expanded v0 bits are taken from lanes if the caller has
+// them cached. As all integer reductions are associative the accumulators and their lanes are combined at the end. VREDAND and VREDOR
+// stop once every lane is 0 or all ones
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+void simd_red_loop(uint8_t* V, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                   const src_elem_t* lanes) {
+    constexpr size_t block = simd_block<dest_elem_t, src_elem_t>;
+    constexpr size_t accumulators = 4;
+    using vec_t = typename simd_vec<dest_elem_t, block>::type;
+    using src_vec_t = typename simd_vec<src_elem_t, block>::type;
+    constexpr dest_elem_t identity = red_identity<FUNCT6, FUNCT3, dest_elem_t>();
+    constexpr bool early_exit = FUNCT3 == OPMVV && (FUNCT6 == 0b000001 || FUNCT6 == 0b000010); // VREDAND, VREDOR
+    constexpr dest_elem_t saturated = FUNCT6 == 0b000001 ? 0 : std::numeric_limits<dest_elem_t>::max();
+    auto vs2_elems = reinterpret_cast<const src_elem_t*>(V + VLEN / 8 * vs2);
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
+    dest_elem_t running_total = reinterpret_cast<const dest_elem_t*>(V + VLEN / 8 * vs1)[0];
+    auto single = [&](size_t idx) {
+        if(vm || V[idx / 8] >> (idx % 8) & 1)
+            red_funct<FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(running_total, vs2_elems[idx]);
+    };
+    auto accumulate = [&](vec_t& acc, size_t idx) {
+        src_vec_t src;
+        memcpy(&src, vs2_elems + idx, sizeof(src_vec_t));
+        if(!vm) {
+            src_vec_t active;
+            simd_active_lanes(active, V, idx, lanes);
+            src = (src & active) | (static_cast<src_elem_t>(identity) & ~active);
+        }
+        if constexpr(sizeof(dest_elem_t) > sizeof(src_elem_t)) {
+            vec_t wide;
+            simd_convert<FUNCT6 == 0b110001>(wide, src);
+            simd_red_funct<FUNCT6, FUNCT3>(acc, wide);
+        } else
+            simd_red_funct<FUNCT6, FUNCT3>(acc, src);
+    };
+    size_t idx = vstart;
+    if(!vm && !lanes && sizeof(src_elem_t) >= 4)
+        // as in simd_body_loop, walking the active elements is faster than expanding the mask for the few wide lanes of a block
+        for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
+            red_funct<FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(running_total, vs2_elems[idx]);
+            return !early_exit || running_total != saturated;
+        });
+    else {
+        for(; idx < vl && idx % block; idx++)
+            single(idx);
+        if(idx + block <= vl) {
+            vec_t acc[accumulators];
+            for(auto& lane_acc : acc)
+                lane_acc = identity - vec_t{};
+            for(; idx + accumulators * block <= vl; idx += accumulators * block) {
+                for(size_t i = 0; i < accumulators; i++)
+                    accumulate(acc[i], idx + i * block);
+                if constexpr(early_exit) {
+                    vec_t combined = acc[0], all_saturated = saturated - vec_t{};
+                    for(size_t i = 1; i < accumulators; i++)
+                        simd_red_funct<FUNCT6, FUNCT3>(combined, acc[i]);
+                    if(!memcmp(&combined, &all_saturated, sizeof(vec_t))) {
+                        idx = vl;
+                        break;
+                    }
+                }
+            }
+            for(; idx + block <= vl; idx += block)
+                accumulate(acc[0], idx);
+            for(size_t i = 1; i < accumulators; i++)
+                simd_red_funct<FUNCT6, FUNCT3>(acc[0], acc[i]);
+            // the lanes hold wide partial sums for VWREDSUM(U), combine them as single width sums
+            red_funct<FUNCT3 == OPIVV ? 0b000000 : FUNCT6, OPMVV, dest_elem_t, dest_elem_t>(running_total,
+                                                                                            simd_red_lanes<FUNCT6, FUNCT3>(acc[0]));
         }
+        for(; idx < vl; idx++)
+            single(idx);
+    }
+    vd_elems[0] = running_total;
+    // the tail is all elements of the destination register beyond the first one
+    if(cfg.vta)
+        for(size_t idx = 1; idx < VLEN / 8 / sizeof(dest_elem_t); idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+template <unsigned VLEN, typename src_elem_t>
+using simd_red_loop_t = void (*)(uint8_t*, uint64_t, uint64_t, const vconfig_t&, bool, unsigned, unsigned, unsigned, const src_elem_t*);
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+constexpr simd_red_loop_t<VLEN, src_elem_t> simd_red_loop_for() {
+    if constexpr(has_simd_red_funct<dest_elem_t, src_elem_t>(FUNCT6, FUNCT3))
+        return simd_red_loop<VLEN, FUNCT6, FUNCT3 == OPIVV || FUNCT3 == OPIVX || FUNCT3 == OPIVI ? OPIVV : OPMVV, dest_elem_t, src_elem_t>;
     else
-        throw new std::runtime_error("Unknown funct3 in get_red_funct");
+        return nullptr;
+}
+// the simd_red_loop for an encoding, nullptr if there is none for the element types
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+simd_red_loop_t<VLEN, src_elem_t> find_simd_red_loop(unsigned funct6, unsigned funct3) noexcept {
+    if(!has_simd_red_funct<dest_elem_t, src_elem_t>(funct6, funct3))
+        return nullptr;
+    switch(funct6) {
+    case 0b110000: // VWREDSUMU
+        return simd_red_loop_for<VLEN, 0b110000, OPIVV, dest_elem_t, src_elem_t>();
+    case 0b110001: // VWREDSUM
+        return simd_red_loop_for<VLEN, 0b110001, OPIVV, dest_elem_t, src_elem_t>();
+    case 0b000000: // VREDSUM
+        return simd_red_loop_for<VLEN, 0b000000, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000001: // VREDAND
+        return simd_red_loop_for<VLEN, 0b000001, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000010: // VREDOR
+        return simd_red_loop_for<VLEN, 0b000010, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000011: // VREDXOR
+        return simd_red_loop_for<VLEN, 0b000011, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000100: // VREDMINU
+        return simd_red_loop_for<VLEN, 0b000100, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000101: // VREDMIN
+        return simd_red_loop_for<VLEN, 0b000101, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000110: // VREDMAXU
+        return simd_red_loop_for<VLEN, 0b000110, OPMVV, dest_elem_t, src_elem_t>();
+    case 0b000111: // VREDMAX
+        return simd_red_loop_for<VLEN, 0b000111, OPMVV, dest_elem_t, src_elem_t>();
+    default:
+        return nullptr;
+    }
 }
 template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
 void vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
                    unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_elem = get_vreg<VLEN, dest_elem_t>(V, vs1, vlmax)[0];
-    auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_red_funct<dest_elem_t, src_elem_t>(funct6, funct3);
-    dest_elem_t& running_total = vd_view[0] = vs1_elem;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active) {
-            fn(running_total, vs2_view[idx]);
-        }
-    }
-    // the tail is all elements of the destination register beyond the first one
-    if(vtype.vta())
-        for(size_t idx = 1; idx < VLEN / vtype.sew(); idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+    auto fn = get_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+    if(auto simd_loop = find_simd_red_loop<VLEN, dest_elem_t, src_elem_t>(funct6, funct3))
+        simd_loop(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, nullptr);
+    else
+        vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+void vector_red_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    if constexpr(has_simd_red_funct<dest_elem_t, src_elem_t>(FUNCT6, FUNCT3))
+        return simd_red_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src_elem_t>()(V, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1,
+                                                                                  nullptr);
+    auto fn = [](dest_elem_t& running_total, src_elem_t vs2) { red_funct<FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(running_total, vs2); };
+    vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+vstatus_t vector_red_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t) noexcept {
+    auto fn = reinterpret_cast<decltype(find_red_funct<dest_elem_t, src_elem_t>(0, 0))>(op.elem_fn);
+    vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename src_elem_t>
+vstatus_t simd_vector_red_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t) noexcept {
+    auto simd_loop = reinterpret_cast<simd_red_loop_t<VLEN, src_elem_t>>(op.elem_fn);
+    simd_loop(V, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1, nullptr);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+prepared_op<VLEN> prepare_vector_red_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                        unsigned vs1) noexcept {
+    auto fn = find_red_funct<dest_elem_t, src_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    if(auto simd_loop = find_simd_red_loop<VLEN, dest_elem_t, src_elem_t>(funct6, funct3))
+        return {simd_vector_red_exec<VLEN, src_elem_t>, reinterpret_cast<void (*)()>(simd_loop), vconfig_t(vtype, VLEN), vm, vd, vs2, vs1};
+    return {vector_red_exec<VLEN, dest_elem_t, src_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, vs1};
 }
 
 // might be that these exist somewhere in softfloat
@@ -1151,272 +3182,393 @@ template <> inline uint64_t fp_max<uint64_t>(uint64_t v2, uint64_t v1) {
         return v1;
 }
 
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+dest_elem_t fp_funct(uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+    if constexpr(FUNCT3 == OPFVV || FUNCT3 == OPFVF) {
+        if constexpr(FUNCT6 == 0b000000) { // VFADD
+            dest_elem_t val = fp_add<src2_elem_t>(rm, vs2, vs1);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b000010) { // VFSUB
+            dest_elem_t val = fp_sub<src2_elem_t>(rm, vs2, vs1);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b000100) // VFMIN
+            return fp_min<src2_elem_t>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b000110) // VFMAX
+            return fp_max<src2_elem_t>(vs2, vs1);
+        else if constexpr(FUNCT6 == 0b100000) { // VFDIV
+            dest_elem_t val = fp_div<src2_elem_t>(rm, vs2, vs1);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b100001) { // VFRDIV
+            dest_elem_t val = fp_div<src2_elem_t>(rm, vs1, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b100100) { // VFMUL
+            dest_elem_t val = fp_mul<src2_elem_t>(rm, vs2, vs1);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b100111) { // VFRSUB
+            dest_elem_t val = fp_sub<src2_elem_t>(rm, vs1, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101000) { // VFMADD
+            dest_elem_t val = fp_madd<src2_elem_t>(rm, vs1, vd, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101001) { // VFNMADD
+            dest_elem_t val = fp_nmadd<src2_elem_t>(rm, vs1, vd, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101010) { // VFMSUB
+            dest_elem_t val = fp_msub<src2_elem_t>(rm, vs1, vd, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101011) { // VFNMSUB
+            dest_elem_t val = fp_nmsub<src2_elem_t>(rm, vs1, vd, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101100) { // VFMACC
+            dest_elem_t val = fp_madd<src2_elem_t>(rm, vs1, vs2, vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101101) { // VFNMAC
+            dest_elem_t val = fp_nmadd<src2_elem_t>(rm, vs1, vs2, vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101110) { // VFMSAC
+            dest_elem_t val = fp_msub<src2_elem_t>(rm, vs1, vs2, vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b101111) { // VFNMSAC
+            dest_elem_t val = fp_nmsub<src2_elem_t>(rm, vs1, vs2, vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b110000) { // VFWADD
+            dest_elem_t val = fp_add<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b110010) { // VFWSUB
+            dest_elem_t val = fp_sub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b110100) { // VFWADD.W
+            dest_elem_t val = fp_add<dest_elem_t>(rm, vs2, widen_float<dest_elem_t>(vs1));
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b110110) { // VFWSUB.W
+            dest_elem_t val = fp_sub<dest_elem_t>(rm, vs2, widen_float<dest_elem_t>(vs1));
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b111000) { // VFWMUL
+            dest_elem_t val = fp_mul<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b111100) { // VFWMACC
+            dest_elem_t val = fp_madd<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b111101) { // VFWNMACC
+            dest_elem_t val = fp_nmadd<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b111110) { // VFWMSAC
+            dest_elem_t val = fp_msub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b111111) { // VFWNMSAC
+            dest_elem_t val = fp_nmsub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(FUNCT6 == 0b001000) { // VFSGNJ
+            dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
+            dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+            return (vs2 & mask) | (vs1 & sign_mask);
+        } else if constexpr(FUNCT6 == 0b001001) { // VFSGNJN
+            dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
+            dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+            return (vs2 & mask) | (~vs1 & sign_mask);
+        } else if constexpr(FUNCT6 == 0b001010) { // VFSGNJX
+            dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
+            dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
+            return vs2 ^ (vs1 & sign_mask);
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in fp_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in fp_funct");
+}
 template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
-std::function<dest_elem_t(uint8_t, uint8_t&, dest_elem_t, src2_elem_t, src1_elem_t)> get_fp_funct(unsigned funct6, unsigned funct3) {
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, dest_elem_t, src2_elem_t, src1_elem_t)> find_fp_funct(unsigned funct6,
+                                                                                                        unsigned funct3) noexcept {
     if(funct3 == OPFVV || funct3 == OPFVF)
         switch(funct6) {
         case 0b000000: // VFADD
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_add<src2_elem_t>(rm, vs2, vs1);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b000000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000010: // VFSUB
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_sub<src2_elem_t>(rm, vs2, vs1);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b000010, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000100: // VFMIN
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return fp_min<src2_elem_t>(vs2, vs1);
-            };
+            return fp_funct<0b000100, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b000110: // VFMAX
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                return fp_max<src2_elem_t>(vs2, vs1);
-            };
+            return fp_funct<0b000110, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100000: // VFDIV
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_div<src2_elem_t>(rm, vs2, vs1);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b100000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100001: // VFRDIV
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_div<src2_elem_t>(rm, vs1, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b100001, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100100: // VFMUL
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_mul<src2_elem_t>(rm, vs2, vs1);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b100100, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b100111: // VFRSUB
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_sub<src2_elem_t>(rm, vs1, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b100111, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101000: // VFMADD
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_madd<src2_elem_t>(rm, vs1, vd, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101001: // VFNMADD
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmadd<src2_elem_t>(rm, vs1, vd, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101001, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101010: // VFMSUB
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_msub<src2_elem_t>(rm, vs1, vd, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101010, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101011: // VFNMSUB
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmsub<src2_elem_t>(rm, vs1, vd, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101011, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101100: // VFMACC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_madd<src2_elem_t>(rm, vs1, vs2, vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101100, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101101: // VFNMAC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmadd<src2_elem_t>(rm, vs1, vs2, vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101101, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101110: // VFMSAC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_msub<src2_elem_t>(rm, vs1, vs2, vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101110, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b101111: // VFNMSAC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmsub<src2_elem_t>(rm, vs1, vs2, vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b101111, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110000: // VFWADD
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_add<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b110000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110010: // VFWSUB
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_sub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b110010, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110100: // VFWADD.W
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_add<dest_elem_t>(rm, vs2, widen_float<dest_elem_t>(vs1));
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b110100, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b110110: // VFWSUB.W
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_sub<dest_elem_t>(rm, vs2, widen_float<dest_elem_t>(vs1));
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b110110, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111000: // VFWMUL
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_mul<dest_elem_t>(rm, widen_float<dest_elem_t>(vs2), widen_float<dest_elem_t>(vs1));
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b111000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111100: // VFWMACC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_madd<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b111100, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111101: // VFWNMACC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmadd<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b111101, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111110: // VFWMSAC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_msub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b111110, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b111111: // VFWNMSAC
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t val = fp_nmsub<dest_elem_t>(rm, widen_float<dest_elem_t>(vs1), widen_float<dest_elem_t>(vs2), vd);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_funct<0b111111, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001000: // VFSGNJ
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
-                dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                return (vs2 & mask) | (vs1 & sign_mask);
-            };
+            return fp_funct<0b001000, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001001: // VFSGNJN
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
-                dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                return (vs2 & mask) | (~vs1 & sign_mask);
-            };
+            return fp_funct<0b001001, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         case 0b001010: // VFSGNJX
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
-                dest_elem_t mask = std::numeric_limits<dest_elem_t>::max() >> 1;
-                dest_elem_t sign_mask = std::numeric_limits<std::make_signed_t<dest_elem_t>>::min();
-                return vs2 ^ (vs1 & sign_mask);
-            };
+            return fp_funct<0b001010, OPFVV, dest_elem_t, src2_elem_t, src1_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_fp_funct");
+            return nullptr;
         }
     else
-        throw new std::runtime_error("Unknown funct3 in get_fp_funct");
+        return nullptr;
 }
-template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-void fp_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                         unsigned vs2, unsigned vs1, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, dest_elem_t, src2_elem_t, src1_elem_t)> get_fp_funct_ptr(unsigned funct6,
+                                                                                                           unsigned funct3) {
+    if(auto fn = find_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_funct");
+}
+template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+std::function<dest_elem_t(uint8_t, uint8_t&, dest_elem_t, src2_elem_t, src1_elem_t)> get_fp_funct(unsigned funct6, unsigned funct3) {
+    return get_fp_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void fp_vector_vector_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                           unsigned vs1, uint8_t rm) {
+    if(!vm && vl <= small_vl) {
+        auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+        auto vs1_elems = reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1);
+        uint8_t accrued_flags = 0;
+        small_vl_loop<VLEN, dest_elem_t>(V, vl, vstart, cfg, vd, [&](dest_elem_t vd_elem, size_t idx) {
+            return fn(rm, accrued_flags, vd_elem, vs2_elems[idx], vs1_elems[idx]);
+        });
+        softfloat_exceptionFlags = accrued_flags;
+        return;
+    }
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs1_view = get_vreg<VLEN, src1_elem_t>(V, vs1, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
     uint8_t accrued_flags = 0;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
+    if(!vm && (agnostic_undisturbed() || !cfg.vma)) {
+        for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
             vd_view[idx] = fn(rm, accrued_flags, vd_view[idx], vs2_view[idx], vs1_view[idx]);
-        else if(vtype.vma())
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-    }
+            return true;
+        });
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active)
+                vd_view[idx] = fn(rm, accrued_flags, vd_view[idx], vs2_view[idx], vs1_view[idx]);
+            else if(cfg.vma)
+                vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        }
     softfloat_exceptionFlags = accrued_flags;
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++) {
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++) {
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
         }
 }
 template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
-void fp_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                      unsigned vs2, src1_elem_t imm, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+void fp_vector_vector_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                         unsigned vs2, unsigned vs1, uint8_t rm) {
+    auto fn = get_fp_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    fp_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void fp_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                         uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return fp_funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(rm, accrued_flags, vd, vs2, vs1);
+    };
+    fp_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t fp_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    fp_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1, rm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_fp_vector_vector_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                              unsigned vs1) noexcept {
+    auto fn = find_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {fp_vector_vector_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN),
+            vm, vd, vs2, vs1};
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, typename funct_t>
+void fp_vector_imm_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                        src1_elem_t imm, uint8_t rm) {
+    if(!vm && vl <= small_vl) {
+        auto vs2_elems = reinterpret_cast<src2_elem_t*>(V + VLEN / 8 * vs2);
+        uint8_t accrued_flags = 0;
+        small_vl_loop<VLEN, dest_elem_t>(V, vl, vstart, cfg, vd, [&](dest_elem_t vd_elem, size_t idx) {
+            return fn(rm, accrued_flags, vd_elem, vs2_elems[idx], imm);
+        });
+        softfloat_exceptionFlags = accrued_flags;
+        return;
+    }
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, src2_elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, cfg.vlmax);
     uint8_t accrued_flags = 0;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
+    if(!vm && (agnostic_undisturbed() || !cfg.vma)) {
+        for_each_active<VLEN>(V, vl, vstart, [&](size_t idx) {
             vd_view[idx] = fn(rm, accrued_flags, vd_view[idx], vs2_view[idx], imm);
-        else if(vtype.vma())
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
-    }
+            return true;
+        });
+    } else
+        for(size_t idx = vstart; idx < vl; idx++) {
+            bool mask_active = vm ? 1 : mask_reg[idx];
+            if(mask_active)
+                vd_view[idx] = fn(rm, accrued_flags, vd_view[idx], vs2_view[idx], imm);
+            else if(cfg.vma)
+                vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        }
     softfloat_exceptionFlags = accrued_flags;
-    if(vtype.vta())
-        for(size_t idx = vl; idx < vlmax; idx++)
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void fp_vector_imm_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                      unsigned vs2, src1_elem_t imm, uint8_t rm) {
+    auto fn = get_fp_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    fp_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm, rm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+void fp_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, src1_elem_t imm,
+                      uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+        return fp_funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(rm, accrued_flags, vd, vs2, vs1);
+    };
+    fp_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm, rm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+vstatus_t fp_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(0, 0))>(op.elem_fn);
+    auto imm = static_cast<src1_elem_t>(scalar);
+    fp_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, imm, rm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t>
+prepared_op<VLEN> prepare_fp_vector_imm_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept {
+    auto fn = find_fp_funct<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {fp_vector_imm_exec<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm,
+            vd, vs2, 0};
+}
+template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+void fp_red_funct(uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
+    if constexpr(FUNCT3 == OPFVV || FUNCT3 == OPFVF) {
+        if constexpr(FUNCT6 == 0b000001) { // VFREDUSUM
+            running_total = fp_add<dest_elem_t>(rm, running_total, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+        } else if constexpr(FUNCT6 == 0b000011) { // VFREDOSUM
+            running_total = fp_add<dest_elem_t>(rm, running_total, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+        } else if constexpr(FUNCT6 == 0b000101) // VFREDMIN
+            running_total = fp_min<dest_elem_t>(running_total, vs2);
+        else if constexpr(FUNCT6 == 0b000111) // VFREDMAX
+            running_total = fp_max<dest_elem_t>(running_total, vs2);
+        else if constexpr(FUNCT6 == 0b110001) { // VFWREDUSUM
+            running_total = fp_add<dest_elem_t>(rm, running_total, widen_float<dest_elem_t>(vs2));
+            accrued_flags |= softfloat_exceptionFlags;
+        } else if constexpr(FUNCT6 == 0b110011) { // VFWREDOSUM
+            running_total = fp_add<dest_elem_t>(rm, running_total, widen_float<dest_elem_t>(vs2));
+            accrued_flags |= softfloat_exceptionFlags;
+        } else
+            static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct6 in fp_red_funct");
+    } else
+        static_assert(unsupported_encoding<FUNCT6, FUNCT3>, "Unknown funct3 in fp_red_funct");
+}
 template <typename dest_elem_t, typename src_elem_t>
-std::function<void(uint8_t, uint8_t&, dest_elem_t&, src_elem_t)> get_fp_red_funct(unsigned funct6, unsigned funct3) {
+std::add_pointer_t<void(uint8_t, uint8_t&, dest_elem_t&, src_elem_t)> find_fp_red_funct(unsigned funct6, unsigned funct3) noexcept {
     if(funct3 == OPFVV || funct3 == OPFVF)
         switch(funct6) {
         case 0b000001: // VFREDUSUM
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_add<dest_elem_t>(rm, running_total, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-            };
+            return fp_red_funct<0b000001, OPFVV, dest_elem_t, src_elem_t>;
         case 0b000011: // VFREDOSUM
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_add<dest_elem_t>(rm, running_total, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-            };
+            return fp_red_funct<0b000011, OPFVV, dest_elem_t, src_elem_t>;
         case 0b000101: // VFREDMIN
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_min<dest_elem_t>(running_total, vs2);
-            };
+            return fp_red_funct<0b000101, OPFVV, dest_elem_t, src_elem_t>;
         case 0b000111: // VFREDMAX
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_max<dest_elem_t>(running_total, vs2);
-            };
+            return fp_red_funct<0b000111, OPFVV, dest_elem_t, src_elem_t>;
         case 0b110001: // VFWREDUSUM
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_add<dest_elem_t>(rm, running_total, widen_float<dest_elem_t>(vs2));
-                accrued_flags |= softfloat_exceptionFlags;
-            };
+            return fp_red_funct<0b110001, OPFVV, dest_elem_t, src_elem_t>;
         case 0b110011: // VFWREDOSUM
-            return [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
-                running_total = fp_add<dest_elem_t>(rm, running_total, widen_float<dest_elem_t>(vs2));
-                accrued_flags |= softfloat_exceptionFlags;
-            };
+            return fp_red_funct<0b110011, OPFVV, dest_elem_t, src_elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct6 in get_fp_red_funct");
+            return nullptr;
         }
     else
-        throw new std::runtime_error("Unknown funct3 in get_fp_red_funct");
+        return nullptr;
 }
-template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
-void fp_vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
-                      unsigned vs2, unsigned vs1, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_elem = get_vreg<VLEN, dest_elem_t>(V, vs1, vlmax)[0];
-    auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
-    auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_fp_red_funct<dest_elem_t, src_elem_t>(funct6, funct3);
-    dest_elem_t& running_total = vd_view[0] = vs1_elem;
+template <typename dest_elem_t, typename src_elem_t>
+std::add_pointer_t<void(uint8_t, uint8_t&, dest_elem_t&, src_elem_t)> get_fp_red_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_fp_red_funct<dest_elem_t, src_elem_t>(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_red_funct");
+}
+template <typename dest_elem_t, typename src_elem_t>
+std::function<void(uint8_t, uint8_t&, dest_elem_t&, src_elem_t)> get_fp_red_funct(unsigned funct6, unsigned funct3) {
+    return get_fp_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename funct_t>
+void fp_vector_red_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                        unsigned vs1, uint8_t rm) {
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    dest_elem_t running_total = get_vreg<VLEN, dest_elem_t>(V, vs1, cfg.vlmax)[0];
+    auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, cfg.vlmax);
+    // vd may be vs2 or vs1, element 0 is written once all of them are read
+    auto vd_elems = reinterpret_cast<dest_elem_t*>(V + VLEN / 8 * vd);
     uint8_t accrued_flags = 0;
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
@@ -1424,10 +3576,39 @@ void fp_vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl,
             fn(rm, accrued_flags, running_total, vs2_view[idx]);
     }
     softfloat_exceptionFlags = accrued_flags;
-    // the tail is all elements of the destination register beyond the first one
-    if(vtype.vta())
-        for(size_t idx = 1; idx < VLEN / vtype.sew(); idx++)
-            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+    vd_elems[0] = running_total;
+    // the tail is all elements of the destination register beyond the first one, counted in the destination EEW
+    if(cfg.vta)
+        for(size_t idx = 1; idx < VLEN / 8 / sizeof(dest_elem_t); idx++)
+            vd_elems[idx] = agnostic_behavior(vd_elems[idx]);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+void fp_vector_red_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd,
+                      unsigned vs2, unsigned vs1, uint8_t rm) {
+    auto fn = get_fp_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+    fp_vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t>
+void fp_vector_red_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                      uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, dest_elem_t& running_total, src_elem_t vs2) {
+        fp_red_funct<FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(rm, accrued_flags, running_total, vs2);
+    };
+    fp_vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+vstatus_t fp_vector_red_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_fp_red_funct<dest_elem_t, src_elem_t>(0, 0))>(op.elem_fn);
+    fp_vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1, rm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+prepared_op<VLEN> prepare_fp_vector_red_op(unsigned funct6, unsigned funct3, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                           unsigned vs1) noexcept {
+    auto fn = find_fp_red_funct<dest_elem_t, src_elem_t>(funct6, funct3);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {fp_vector_red_exec<VLEN, dest_elem_t, src_elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, vs1};
 }
 template <typename elem_size_t> elem_size_t fp_sqrt(uint8_t, elem_size_t);
 template <> inline uint16_t fp_sqrt<uint16_t>(uint8_t mode, uint16_t v2) { return fsqrt_h(v2, mode); }
@@ -1468,77 +3649,97 @@ template <> inline uint16_t fp_i_to_f<uint16_t, uint16_t>(uint8_t rm, uint16_t v
 template <> inline uint32_t fp_i_to_f<uint32_t, uint32_t>(uint8_t rm, uint32_t v2) { return i32tof32(v2, rm); }
 template <> inline uint64_t fp_i_to_f<uint64_t, uint64_t>(uint8_t rm, uint64_t v2) { return i64tof64(v2, rm); }
 
-template <typename elem_t> std::function<elem_t(uint8_t, uint8_t&, elem_t)> get_fp_unary_fn(unsigned encoding_space, unsigned unary_op) {
+template <unsigned ENCODING_SPACE, unsigned UNARY_OP, typename elem_t> elem_t fp_unary_fn(uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
+    if constexpr(ENCODING_SPACE == 0b010011) { // VFUNARY1
+        if constexpr(UNARY_OP == 0b00000) { // VFSQRT
+            elem_t val = fp_sqrt(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b00100) { // VFRSQRT7
+            elem_t val = fp_rsqrt7(vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b00101) { // VFREC7
+            elem_t val = fp_rec7(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b10000) { // VFCLASS
+            elem_t val = fp_fclass(vs2);
+            return val;
+        } else
+            static_assert(unsupported_encoding<ENCODING_SPACE, UNARY_OP>, "Unknown funct in fp_unary_fn");
+    } else if constexpr(ENCODING_SPACE == 0b010010) { // VFUNARY0
+        if constexpr(UNARY_OP == 0b00000 || UNARY_OP == 0b00110) { // VFCVT.XU.F.V, VFCVT.RTZ.XU.F.V
+            elem_t val = fp_f_to_ui<elem_t, elem_t>(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b00001 || UNARY_OP == 0b00111) { // VFCVT.X.F.V, VFCVT.RTZ.X.F.V
+            elem_t val = fp_f_to_i<elem_t, elem_t>(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b00010) { // VFCVT.F.XU.V
+            elem_t val = fp_ui_to_f<elem_t, elem_t>(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else if constexpr(UNARY_OP == 0b00011) { // VFCVT.F.X.V
+            elem_t val = fp_i_to_f<elem_t, elem_t>(rm, vs2);
+            accrued_flags |= softfloat_exceptionFlags;
+            return val;
+        } else
+            static_assert(unsupported_encoding<ENCODING_SPACE, UNARY_OP>, "Unknown funct in fp_unary_fn");
+    } else
+        static_assert(unsupported_encoding<ENCODING_SPACE, UNARY_OP>, "Unknown funct in fp_unary_fn");
+}
+template <typename elem_t>
+std::add_pointer_t<elem_t(uint8_t, uint8_t&, elem_t)> find_fp_unary_fn(unsigned encoding_space, unsigned unary_op) noexcept {
     if(encoding_space == 0b010011) // VFUNARY1
         switch(unary_op) {
         case 0b00000: // VFSQRT
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_sqrt(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010011, 0b00000, elem_t>;
         case 0b00100: // VFRSQRT7
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_rsqrt7(vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010011, 0b00100, elem_t>;
         case 0b00101: // VFREC7
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_rec7(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010011, 0b00101, elem_t>;
         case 0b10000: // VFCLASS
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_fclass(vs2);
-                return val;
-            };
+            return fp_unary_fn<0b010011, 0b10000, elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct in get_fp_unary_fn");
+            return nullptr;
         }
     else if(encoding_space == 0b010010) // VFUNARY0
         switch(unary_op) {
         case 0b00000: // VFCVT.XU.F.V
         case 0b00110: // VFCVT.RTZ.XU.F.V
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_f_to_ui<elem_t, elem_t>(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010010, 0b00000, elem_t>;
         case 0b00001: // VFCVT.X.F.V
         case 0b00111: // VFCVT.RTZ.X.F.V
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_f_to_i<elem_t, elem_t>(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010010, 0b00001, elem_t>;
         case 0b00010: // VFCVT.F.XU.V
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_ui_to_f<elem_t, elem_t>(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010010, 0b00010, elem_t>;
         case 0b00011: // VFCVT.F.X.V
-            return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
-                elem_t val = fp_i_to_f<elem_t, elem_t>(rm, vs2);
-                accrued_flags |= softfloat_exceptionFlags;
-                return val;
-            };
+            return fp_unary_fn<0b010010, 0b00011, elem_t>;
         default:
-            throw new std::runtime_error("Unknown funct in get_fp_unary_fn");
+            return nullptr;
         }
     else
-        throw new std::runtime_error("Unknown funct in get_fp_unary_fn");
+        return nullptr;
 }
-template <unsigned VLEN, typename elem_t>
-void fp_vector_unary_op(uint8_t* V, unsigned encoding_space, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm,
-                        unsigned vd, unsigned vs2, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+template <typename elem_t>
+std::add_pointer_t<elem_t(uint8_t, uint8_t&, elem_t)> get_fp_unary_fn_ptr(unsigned encoding_space, unsigned unary_op) {
+    if(auto fn = find_fp_unary_fn<elem_t>(encoding_space, unary_op))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_unary_fn");
+}
+template <typename elem_t>
+std::function<elem_t(uint8_t, uint8_t&, elem_t)> get_fp_unary_fn(unsigned encoding_space, unsigned unary_op) {
+    return get_fp_unary_fn_ptr<elem_t>(encoding_space, unary_op);
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void fp_vector_unary_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                          uint8_t rm) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, elem_t>(V, vd, vlmax);
-    auto fn = get_fp_unary_fn<elem_t>(encoding_space, unary_op);
     uint8_t accrued_flags = 0;
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
@@ -1552,6 +3753,19 @@ void fp_vector_unary_op(uint8_t* V, unsigned encoding_space, unsigned unary_op,
         for(size_t idx = vl; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+template <unsigned VLEN, typename elem_t>
+void fp_vector_unary_op(uint8_t* V, unsigned encoding_space, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm,
+                        unsigned vd, unsigned vs2, uint8_t rm) {
+    auto fn = get_fp_unary_fn_ptr<elem_t>(encoding_space, unary_op);
+    fp_vector_unary_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
+template <unsigned VLEN, unsigned ENCODING_SPACE, unsigned UNARY_OP, typename elem_t>
+void fp_vector_unary_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2) {
+        return fp_unary_fn<ENCODING_SPACE, UNARY_OP, elem_t>(rm, accrued_flags, vs2);
+    };
+    fp_vector_unary_loop<VLEN, elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
 
 template <> inline uint16_t fp_f_to_ui<uint16_t, uint8_t>(uint8_t rm, uint8_t v2) {
     throw new std::runtime_error("Attempting illegal widening conversion");
@@ -1579,53 +3793,67 @@ template <> inline uint16_t fp_f_to_f<uint16_t, uint8_t>(uint8_t rm, uint8_t val
 template <> inline uint32_t fp_f_to_f<uint32_t, uint16_t>(uint8_t rm, uint16_t val) { return f16tof32(val, rm); }
 template <> inline uint64_t fp_f_to_f<uint64_t, uint32_t>(uint8_t rm, uint32_t val) { return f32tof64(val, rm); }
 
+template <unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+dest_elem_t fp_widening_fn(uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
+    if constexpr(UNARY_OP == 0b01000 || UNARY_OP == 0b01110) { // VFWCVT.XU.F.V, VFWCVT.RTZ.XU.F.V
+        dest_elem_t val = fp_f_to_ui<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b01001 || UNARY_OP == 0b01111) { // VFWCVT.X.F.V, VFWCVT.RTZ.X.F.V
+        dest_elem_t val = fp_f_to_i<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b01010) { // VFWCVT.F.XU.V
+        dest_elem_t val = fp_ui_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b01011) { // VFWCVT.F.X.V
+        dest_elem_t val = fp_i_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b01100) { // VFWCVT.F.F.V
+        dest_elem_t val = fp_f_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else
+        static_assert(unsupported_encoding<UNARY_OP>, "Unknown funct in fp_widening_fn");
+}
 template <typename dest_elem_t, typename src_elem_t>
-std::function<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_widening_fn(unsigned unary_op) {
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> find_fp_widening_fn(unsigned unary_op) noexcept {
     switch(unary_op) {
     case 0b01000: // VFWCVT.XU.F.V
     case 0b01110: // VFWCVT.RTZ.XU.F.V
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_ui<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_widening_fn<0b01000, dest_elem_t, src_elem_t>;
     case 0b01001: // VFWCVT.X.F.V
     case 0b01111: // VFWCVT.RTZ.X.F.V
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_i<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_widening_fn<0b01001, dest_elem_t, src_elem_t>;
     case 0b01010: // VFWCVT.F.XU.V
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_ui_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_widening_fn<0b01010, dest_elem_t, src_elem_t>;
     case 0b01011: // VFWCVT.F.X.V
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_i_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_widening_fn<0b01011, dest_elem_t, src_elem_t>;
     case 0b01100: // VFWCVT.F.F.V
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_widening_fn<0b01100, dest_elem_t, src_elem_t>;
     default:
-        throw new std::runtime_error("Unknown funct in get_fp_unary_fn");
+        return nullptr;
     }
 }
-template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
-void fp_vector_unary_w(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
-                       uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+template <typename dest_elem_t, typename src_elem_t>
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_widening_fn_ptr(unsigned unary_op) {
+    if(auto fn = find_fp_widening_fn<dest_elem_t, src_elem_t>(unary_op))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_widening_fn");
+}
+template <typename dest_elem_t, typename src_elem_t>
+std::function<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_widening_fn(unsigned unary_op) {
+    return get_fp_widening_fn_ptr<dest_elem_t, src_elem_t>(unary_op);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename funct_t>
+void fp_vector_unary_w_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                            uint8_t rm) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_fp_widening_fn<dest_elem_t, src_elem_t>(unary_op);
     uint8_t accrued_flags = 0;
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
@@ -1639,6 +3867,19 @@ void fp_vector_unary_w(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vsta
         for(size_t idx = vl; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_w(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                       uint8_t rm) {
+    auto fn = get_fp_widening_fn_ptr<dest_elem_t, src_elem_t>(unary_op);
+    fp_vector_unary_w_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_w(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
+        return fp_widening_fn<UNARY_OP, dest_elem_t, src_elem_t>(rm, accrued_flags, vs2);
+    };
+    fp_vector_unary_w_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
 
 template <> inline uint8_t fp_f_to_ui<uint8_t, uint16_t>(uint8_t rm, uint16_t v2) { return f16toui32(v2, rm); }
 template <> inline uint16_t fp_f_to_ui<uint16_t, uint32_t>(uint8_t rm, uint32_t v2) { return f32toui32(v2, rm); }
@@ -1665,54 +3906,68 @@ template <> inline uint8_t fp_f_to_f<uint8_t, uint16_t>(uint8_t rm, uint16_t val
 }
 template <> inline uint16_t fp_f_to_f<uint16_t, uint32_t>(uint8_t rm, uint32_t val) { return f32tof16(val, rm); }
 template <> inline uint32_t fp_f_to_f<uint32_t, uint64_t>(uint8_t rm, uint64_t val) { return f64tof32(val, rm); }
+template <unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+dest_elem_t fp_narrowing_fn(uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
+    if constexpr(UNARY_OP == 0b10000 || UNARY_OP == 0b10110) { // VFNCVT.XU.F.W, VFNCVT.RTZ.XU.F.W
+        dest_elem_t val = fp_f_to_ui<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b10001 || UNARY_OP == 0b10111) { // VFNCVT.X.F.W, VFNCVT.RTZ.X.F.W
+        dest_elem_t val = fp_f_to_i<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b10010) { // VFNCVT.F.XU.W
+        dest_elem_t val = fp_ui_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b10011) { // VFNCVT.F.X.W
+        dest_elem_t val = fp_i_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(UNARY_OP == 0b10100 || UNARY_OP == 0b10101) { // VFNCVT.F.F.W, VFNCVT.ROD.F.F.W
+        dest_elem_t val = fp_f_to_f<dest_elem_t, src_elem_t>(rm, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else
+        static_assert(unsupported_encoding<UNARY_OP>, "Unknown funct in fp_narrowing_fn");
+}
 template <typename dest_elem_t, typename src_elem_t>
-std::function<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_narrowing_fn(unsigned unary_op) {
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> find_fp_narrowing_fn(unsigned unary_op) noexcept {
     switch(unary_op) {
     case 0b10000: // VFNCVT.XU.F.W
     case 0b10110: // VFNCVT.RTZ.XU.F.W
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_ui<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_narrowing_fn<0b10000, dest_elem_t, src_elem_t>;
     case 0b10001: // VFNCVT.X.F.W
     case 0b10111: // VFNCVT.RTZ.X.F.W
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_i<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_narrowing_fn<0b10001, dest_elem_t, src_elem_t>;
     case 0b10010: // VFNCVT.F.XU.W
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_ui_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_narrowing_fn<0b10010, dest_elem_t, src_elem_t>;
     case 0b10011: // VFNCVT.F.X.W
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_i_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_narrowing_fn<0b10011, dest_elem_t, src_elem_t>;
     case 0b10100: // VFNCVT.F.F.W
     case 0b10101: // VFNCVT.ROD.F.F.W
-        return [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
-            dest_elem_t val = fp_f_to_f<dest_elem_t, src_elem_t>(rm, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_narrowing_fn<0b10100, dest_elem_t, src_elem_t>;
     default:
-        throw new std::runtime_error("Unknown funct in get_fp_narrowing_fn");
+        return nullptr;
     }
 }
-template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
-void fp_vector_unary_n(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
-                       uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+template <typename dest_elem_t, typename src_elem_t>
+std::add_pointer_t<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_narrowing_fn_ptr(unsigned unary_op) {
+    if(auto fn = find_fp_narrowing_fn<dest_elem_t, src_elem_t>(unary_op))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_narrowing_fn");
+}
+template <typename dest_elem_t, typename src_elem_t>
+std::function<dest_elem_t(uint8_t, uint8_t&, src_elem_t)> get_fp_narrowing_fn(unsigned unary_op) {
+    return get_fp_narrowing_fn_ptr<dest_elem_t, src_elem_t>(unary_op);
+}
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename funct_t>
+void fp_vector_unary_n_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                            uint8_t rm) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, dest_elem_t>(V, vd, vlmax);
-    auto fn = get_fp_narrowing_fn<dest_elem_t, src_elem_t>(unary_op);
     uint8_t accrued_flags = 0;
     for(size_t idx = vstart; idx < vl; idx++) {
         bool mask_active = vm ? 1 : mask_reg[idx];
@@ -1726,6 +3981,19 @@ void fp_vector_unary_n(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vsta
         for(size_t idx = vl; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_n(uint8_t* V, unsigned unary_op, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                       uint8_t rm) {
+    auto fn = get_fp_narrowing_fn_ptr<dest_elem_t, src_elem_t>(unary_op);
+    fp_vector_unary_n_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
+template <unsigned VLEN, unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t>
+void fp_vector_unary_n(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, src_elem_t vs2) {
+        return fp_narrowing_fn<UNARY_OP, dest_elem_t, src_elem_t>(rm, accrued_flags, vs2);
+    };
+    fp_vector_unary_n_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vtype, vm, vd, vs2, rm);
+}
 template <typename elem_size_t> bool fp_eq(elem_size_t, elem_size_t);
 template <> inline bool fp_eq<uint16_t>(uint16_t v2, uint16_t v1) { return fcmp_h(v2, v1, 0); }
 template <> inline bool fp_eq<uint32_t>(uint32_t v2, uint32_t v1) { return fcmp_s(v2, v1, 0); }
@@ -1738,208 +4006,362 @@ template <typename elem_size_t> bool fp_lt(elem_size_t, elem_size_t);
 template <> inline bool fp_lt<uint16_t>(uint16_t v2, uint16_t v1) { return fcmp_h(v2, v1, 2); }
 template <> inline bool fp_lt<uint32_t>(uint32_t v2, uint32_t v1) { return fcmp_s(v2, v1, 2); }
 template <> inline bool fp_lt<uint64_t>(uint64_t v2, uint64_t v1) { return fcmp_d(v2, v1, 2); }
-template <typename elem_t> std::function<bool(uint8_t, uint8_t&, elem_t, elem_t)> get_fp_mask_funct(unsigned funct6) {
+template <unsigned FUNCT6, typename elem_t> bool fp_mask_funct(uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
+    if constexpr(FUNCT6 == 0b011000) { // VMFEQ
+        elem_t val = fp_eq(vs2, vs1);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(FUNCT6 == 0b011001) { // VMFLE
+        elem_t val = fp_le(vs2, vs1);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(FUNCT6 == 0b011011) { // VMFLT
+        elem_t val = fp_lt(vs2, vs1);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(FUNCT6 == 0b011100) { // VMFNE
+        elem_t val = !fp_eq(vs2, vs1);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(FUNCT6 == 0b011101) { // VMFGT
+        elem_t val = fp_lt(vs1, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else if constexpr(FUNCT6 == 0b011111) { // VMFGE
+        elem_t val = fp_le(vs1, vs2);
+        accrued_flags |= softfloat_exceptionFlags;
+        return val;
+    } else
+        static_assert(unsupported_encoding<FUNCT6>, "Unknown funct6 in fp_mask_funct");
+}
+template <typename elem_t> std::add_pointer_t<bool(uint8_t, uint8_t&, elem_t, elem_t)> find_fp_mask_funct(unsigned funct6) noexcept {
     switch(funct6) {
     case 0b011000: // VMFEQ
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = fp_eq(vs2, vs1);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011000, elem_t>;
     case 0b011001: // VMFLE
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = fp_le(vs2, vs1);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011001, elem_t>;
     case 0b011011: // VMFLT
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = fp_lt(vs2, vs1);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011011, elem_t>;
     case 0b011100: // VMFNE
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = !fp_eq(vs2, vs1);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011100, elem_t>;
     case 0b011101: // VMFGT
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = fp_lt(vs1, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011101, elem_t>;
     case 0b011111: // VMFGE
-        return [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
-            elem_t val = fp_le(vs1, vs2);
-            accrued_flags |= softfloat_exceptionFlags;
-            return val;
-        };
+        return fp_mask_funct<0b011111, elem_t>;
     default:
-        throw new std::runtime_error("Unknown funct6 in get_fp_mask_funct");
+        return nullptr;
+    }
+}
+template <typename elem_t> std::add_pointer_t<bool(uint8_t, uint8_t&, elem_t, elem_t)> get_fp_mask_funct_ptr(unsigned funct6) {
+    if(auto fn = find_fp_mask_funct<elem_t>(funct6))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_fp_mask_funct");
+}
+template <typename elem_t> std::function<bool(uint8_t, uint8_t&, elem_t, elem_t)> get_fp_mask_funct(unsigned funct6) {
+    return get_fp_mask_funct_ptr<elem_t>(funct6);
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void mask_fp_vector_vector_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd,
+                                unsigned vs2, unsigned vs1, uint8_t rm) {
+    auto vs1_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs1);
+    auto vs2_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
+    uint8_t accrued_flags = 0;
+    // only active elements are compared since compares can raise flags, the results are still merged a word at a time
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t body = mask_word_select(word, vstart, vl);
+        uint64_t active = vm ? body : mask_words.get(word) & body;
+        uint64_t results = 0;
+        for(uint64_t pending = active; pending; pending &= pending - 1) {
+            size_t idx = word * 64 + __builtin_ctzll(pending);
+            results |= uint64_t(fn(rm, accrued_flags, vs2_elems[idx], vs1_elems[idx])) << (idx % 64);
+        }
+        merge_mask_word(vd_words, word, results, body, active, cfg.vma);
     }
+    softfloat_exceptionFlags = accrued_flags;
+    mask_tail_agnostic(vd_words, vl, cfg.vta);
 }
 template <unsigned VLEN, typename elem_t>
 void mask_fp_vector_vector_op(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                               unsigned vs1, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs1_view = get_vreg<VLEN, elem_t>(V, vs1, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, VLEN, vd);
-    auto fn = get_fp_mask_funct<elem_t>(funct6);
+    auto fn = get_fp_mask_funct_ptr<elem_t>(funct6);
+    mask_fp_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void mask_fp_vector_vector_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1,
+                              uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
+        return fp_mask_funct<FUNCT6, elem_t>(rm, accrued_flags, vs2, vs1);
+    };
+    mask_fp_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1, rm);
+}
+template <unsigned VLEN, typename elem_t>
+vstatus_t mask_fp_vector_vector_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t, uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_fp_mask_funct<elem_t>(0))>(op.elem_fn);
+    mask_fp_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, op.vs1, rm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_fp_vector_vector_op(unsigned funct6, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
+                                                   unsigned vs1) noexcept {
+    auto fn = find_fp_mask_funct<elem_t>(funct6);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {mask_fp_vector_vector_exec<VLEN, elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, vs1};
+}
+template <unsigned VLEN, typename elem_t, typename funct_t>
+void mask_fp_vector_imm_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2,
+                             elem_t imm, uint8_t rm) {
+    auto vs2_elems = reinterpret_cast<elem_t*>(V + VLEN / 8 * vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
     uint8_t accrued_flags = 0;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_mask_view[idx] = fn(rm, accrued_flags, vs2_view[idx], vs1_view[idx]);
-        else if(vtype.vma())
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t body = mask_word_select(word, vstart, vl);
+        uint64_t active = vm ? body : mask_words.get(word) & body;
+        uint64_t results = 0;
+        for(uint64_t pending = active; pending; pending &= pending - 1) {
+            size_t idx = word * 64 + __builtin_ctzll(pending);
+            results |= uint64_t(fn(rm, accrued_flags, vs2_elems[idx], imm)) << (idx % 64);
+        }
+        merge_mask_word(vd_words, word, results, body, active, cfg.vma);
     }
     softfloat_exceptionFlags = accrued_flags;
-    if(vtype.vta())
-        for(size_t idx = vl; idx < VLEN; idx++)
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+    mask_tail_agnostic(vd_words, vl, cfg.vta);
 }
 template <unsigned VLEN, typename elem_t>
 void mask_fp_vector_imm_op(uint8_t* V, unsigned funct6, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2,
                            elem_t imm, uint8_t rm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, vlmax);
-    vmask_view vd_mask_view = read_vmask<VLEN>(V, VLEN, vd);
-    auto fn = get_fp_mask_funct<elem_t>(funct6);
-    uint8_t accrued_flags = 0;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_mask_view[idx] = fn(rm, accrued_flags, vs2_view[idx], imm);
-        else if(vtype.vma())
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+    auto fn = get_fp_mask_funct_ptr<elem_t>(funct6);
+    mask_fp_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm, rm);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t>
+void mask_fp_vector_imm_op(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, elem_t imm,
+                           uint8_t rm) {
+    auto fn = [](uint8_t rm, uint8_t& accrued_flags, elem_t vs2, elem_t vs1) {
+        return fp_mask_funct<FUNCT6, elem_t>(rm, accrued_flags, vs2, vs1);
+    };
+    mask_fp_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, imm, rm);
+}
+template <unsigned VLEN, typename elem_t>
+vstatus_t mask_fp_vector_imm_exec(uint8_t* V, const prepared_op<VLEN>& op, uint64_t vl, uint64_t vstart, uint64_t scalar,
+                                  uint8_t rm) noexcept {
+    auto fn = reinterpret_cast<decltype(find_fp_mask_funct<elem_t>(0))>(op.elem_fn);
+    auto imm = static_cast<elem_t>(scalar);
+    mask_fp_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, op.cfg, op.vm, op.vd, op.vs2, imm, rm);
+    return vstatus_t::ok();
+}
+template <unsigned VLEN, typename elem_t>
+prepared_op<VLEN> prepare_mask_fp_vector_imm_op(unsigned funct6, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) noexcept {
+    auto fn = find_fp_mask_funct<elem_t>(funct6);
+    if(!fn)
+        return {nullptr, nullptr, vconfig_t(vtype, VLEN)};
+    return {mask_fp_vector_imm_exec<VLEN, elem_t>, reinterpret_cast<void (*)()>(fn), vconfig_t(vtype, VLEN), vm, vd, vs2, 0};
+}
+template <unsigned FUNCT6> uint64_t mask_word_funct(uint64_t vs2, uint64_t vs1) {
+    if constexpr(FUNCT6 == 0b011000) // VMANDN
+        return vs2 & ~vs1;
+    else if constexpr(FUNCT6 == 0b011001) // VMAND
+        return vs2 & vs1;
+    else if constexpr(FUNCT6 == 0b011010) // VMOR
+        return vs2 | vs1;
+    else if constexpr(FUNCT6 == 0b011011) // VMXOR
+        return vs2 ^ vs1;
+    else if constexpr(FUNCT6 == 0b011100) // VMORN
+        return vs2 | ~vs1;
+    else if constexpr(FUNCT6 == 0b011101) // VMNAND
+        return ~(vs2 & vs1);
+    else if constexpr(FUNCT6 == 0b011110) // VMNOR
+        return ~(vs2 | vs1);
+    else if constexpr(FUNCT6 == 0b011111) // VMXNOR
+        return ~(vs2 ^ vs1);
+    else
+        static_assert(unsupported_encoding<FUNCT6>, "Unknown funct6 in mask_word_funct");
+}
+inline std::add_pointer_t<uint64_t(uint64_t, uint64_t)> find_mask_word_funct(unsigned funct6, unsigned funct3) noexcept {
+    if(funct3 != OPMVV && funct3 != OPMVX)
+        return nullptr;
+    switch(funct6) {
+    case 0b011000: // VMANDN
+        return mask_word_funct<0b011000>;
+    case 0b011001: // VMAND
+        return mask_word_funct<0b011001>;
+    case 0b011010: // VMOR
+        return mask_word_funct<0b011010>;
+    case 0b011011: // VMXOR
+        return mask_word_funct<0b011011>;
+    case 0b011100: // VMORN
+        return mask_word_funct<0b011100>;
+    case 0b011101: // VMNAND
+        return mask_word_funct<0b011101>;
+    case 0b011110: // VMNOR
+        return mask_word_funct<0b011110>;
+    case 0b011111: // VMXNOR
+        return mask_word_funct<0b011111>;
+    default:
+        return nullptr;
     }
-    softfloat_exceptionFlags = accrued_flags;
-    if(vtype.vta())
-        for(size_t idx = vl; idx < VLEN; idx++)
-            vd_mask_view[idx] = agnostic_behavior(vd_mask_view[idx]);
+}
+inline std::add_pointer_t<uint64_t(uint64_t, uint64_t)> get_mask_word_funct_ptr(unsigned funct6, unsigned funct3) {
+    if(auto fn = find_mask_word_funct(funct6, funct3))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_mask_word_funct_ptr");
+}
+template <unsigned VLEN, typename funct_t>
+void mask_mask_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, unsigned vd, unsigned vs2, unsigned vs1) {
+    auto vs1_words = get_vmask_words<VLEN>(V, vs1);
+    auto vs2_words = get_vmask_words<VLEN>(V, vs2);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++)
+        vd_words.set(word, fn(vs2_words.get(word), vs1_words.get(word)), mask_word_select(word, vstart, vl));
+    // the tail is all elements of the destination register beyond vl
+    if(!agnostic_undisturbed())
+        for(size_t word = vl / 64; word < vd_words.word_count; word++)
+            vd_words.set(word, ~uint64_t(0), mask_word_select(word, vl, VLEN));
 }
 template <unsigned VLEN>
 void mask_mask_op(uint8_t* V, unsigned funct6, unsigned funct3, uint64_t vl, uint64_t vstart, unsigned vd, unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN;
-    auto vs1_view = read_vmask<VLEN>(V, vlmax, vs1);
-    auto vs2_view = read_vmask<VLEN>(V, vlmax, vs2);
-    auto vd_view = read_vmask<VLEN>(V, vlmax, vd);
-    auto fn = get_mask_funct<unsigned>(funct6, funct3); // could be bool, but would break the make_signed_t in get_mask_funct
-    for(size_t idx = vstart; idx < vl; idx++)
-        vd_view[idx] = fn(vs2_view[idx], vs1_view[idx]);
-
-    // the tail is all elements of the destination register beyond the first one
-    for(size_t idx = 1; idx < VLEN; idx++)
-        vd_view[idx] = agnostic_behavior(vd_view[idx]);
+    auto fn = get_mask_word_funct_ptr(funct6, funct3);
+    mask_mask_loop<VLEN>(V, fn, vl, vstart, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned FUNCT3>
+void mask_mask_op(uint8_t* V, uint64_t vl, uint64_t vstart, unsigned vd, unsigned vs2, unsigned vs1) {
+    static_assert(FUNCT3 == OPMVV || FUNCT3 == OPMVX, "Unknown funct3 in mask_mask_op");
+    mask_mask_loop<VLEN>(V, mask_word_funct<FUNCT6>, vl, vstart, vd, vs2, vs1);
 }
 template <unsigned VLEN> uint64_t vcpop(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vs2) {
-    uint64_t vlmax = VLEN;
-    auto vs2_view = read_vmask<VLEN>(V, vlmax, vs2);
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    unsigned running_total = 0;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active && vs2_view[idx])
-            running_total += 1;
+    auto vs2_words = get_vmask_words<VLEN>(V, vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    uint64_t running_total = 0;
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t active = vm ? ~uint64_t(0) : mask_words.get(word);
+        running_total += __builtin_popcountll(vs2_words.get(word) & active & mask_word_select(word, vstart, vl));
     }
     return running_total;
 }
 template <unsigned VLEN> uint64_t vfirst(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vs2) {
-    uint64_t vlmax = VLEN;
-    auto vs2_view = read_vmask<VLEN>(V, vlmax, vs2);
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active && vs2_view[idx])
-            return idx;
+    auto vs2_words = get_vmask_words<VLEN>(V, vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t active = vm ? ~uint64_t(0) : mask_words.get(word);
+        if(uint64_t hits = vs2_words.get(word) & active & mask_word_select(word, vstart, vl))
+            return word * 64 + __builtin_ctzll(hits);
     }
     return -1;
 }
-inline std::function<bool(bool&, bool)> get_mask_set_funct(unsigned enc) {
+// hits are the active set bits of vs2 in one mask word, marker records whether an earlier word already had one
+template <unsigned ENC> uint64_t mask_set_word_funct(bool& marker, uint64_t hits) {
+    if(marker)
+        return 0;
+    uint64_t lowest = hits & -hits;
+    marker = hits != 0;
+    if constexpr(ENC == 0b00001) // VMSBF
+        return lowest - 1;
+    else if constexpr(ENC == 0b00010) // VMSOF
+        return lowest;
+    else if constexpr(ENC == 0b00011) // VMSIF
+        return lowest ^ (lowest - 1);
+    else
+        static_assert(unsupported_encoding<ENC>, "Unknown enc in mask_set_word_funct");
+}
+inline std::add_pointer_t<uint64_t(bool&, uint64_t)> find_mask_set_word_funct(unsigned enc) noexcept {
     switch(enc) {
     case 0b00001: // VMSBF
-        return [](bool& marker, bool vs2) {
-            if(marker)
-                return 0;
-            if(vs2) {
-                marker = true;
-                return 0;
-            } else
-                return 1;
-        };
+        return mask_set_word_funct<0b00001>;
     case 0b00010: // VMSOF
-        return [](bool& marker, bool vs2) {
-            if(marker)
-                return 0;
-            if(vs2) {
-                marker = true;
-                return 1;
-            } else
-                return 0;
-        };
+        return mask_set_word_funct<0b00010>;
     case 0b00011: // VMSIF
-        return [](bool& marker, bool vs2) {
-            if(marker)
-                return 0;
-            if(vs2) {
-                marker = true;
-                return 1;
-            } else
-                return 1;
-        };
+        return mask_set_word_funct<0b00011>;
     default:
-        throw new std::runtime_error("Unknown enc in get_mask_set_funct");
+        return nullptr;
     }
 }
-template <unsigned VLEN> void mask_set_op(uint8_t* V, unsigned enc, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2) {
-    uint64_t vlmax = VLEN;
-    auto vs2_view = read_vmask<VLEN>(V, vlmax, vs2);
-    auto vd_view = read_vmask<VLEN>(V, vlmax, vd);
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    auto fn = get_mask_set_funct(enc);
+inline std::add_pointer_t<uint64_t(bool&, uint64_t)> get_mask_set_word_funct_ptr(unsigned enc) {
+    if(auto fn = find_mask_set_word_funct(enc))
+        return fn;
+    throw new std::runtime_error("Unknown encoding in get_mask_set_word_funct_ptr");
+}
+// the element-wise form, a single active element is the lowest bit of a mask word
+inline std::function<bool(bool&, bool)> get_mask_set_funct(unsigned enc) {
+    auto fn = get_mask_set_word_funct_ptr(enc);
+    return [fn](bool& marker, bool vs2) -> bool { return fn(marker, vs2) & 1; };
+}
+template <unsigned VLEN, typename funct_t>
+void mask_set_loop(uint8_t* V, funct_t fn, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2) {
+    auto vs2_words = get_vmask_words<VLEN>(V, vs2);
+    auto vd_words = get_vmask_words<VLEN>(V, vd);
+    auto mask_words = get_vmask_words<VLEN>(V);
     bool marker = false;
-    for(size_t idx = vstart; idx < vl; idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = fn(marker, vs2_view[idx]);
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++) {
+        uint64_t active = (vm ? ~uint64_t(0) : mask_words.get(word)) & mask_word_select(word, vstart, vl);
+        vd_words.set(word, fn(marker, vs2_words.get(word) & active), active);
     }
-    // the tail is all elements of the destination register beyond the first one
-    for(size_t idx = 1; idx < VLEN; idx++)
-        vd_view[idx] = agnostic_behavior(vd_view[idx]);
+    // the tail is all elements of the destination register beyond vl
+    if(!agnostic_undisturbed())
+        for(size_t word = vl / 64; word < vd_words.word_count; word++)
+            vd_words.set(word, ~uint64_t(0), mask_word_select(word, vl, VLEN));
+}
+template <unsigned VLEN> void mask_set_op(uint8_t* V, unsigned enc, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2) {
+    auto fn = get_mask_set_word_funct_ptr(enc);
+    mask_set_loop<VLEN>(V, fn, vl, vstart, vm, vd, vs2);
+}
+template <unsigned VLEN, unsigned ENC> void mask_set_op(uint8_t* V, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2) {
+    mask_set_loop<VLEN>(V, mask_set_word_funct<ENC>, vl, vstart, vm, vd, vs2);
 }
 template <unsigned VLEN, typename src_elem_t>
 void viota(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    auto vs2_view = read_vmask<VLEN>(V, vlmax, vs2);
-    auto vd_view = get_vreg<VLEN, src_elem_t>(V, vd, vlmax);
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    unsigned current = 0;
-    for(size_t idx = vstart; idx < std::min(vl, vlmax); idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active) {
-            vd_view[idx] = current;
-            if(vs2_view[idx])
-                current += 1;
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    uint64_t end = std::min(vl, vlmax);
+    auto vs2_words = get_vmask_words<VLEN>(V, vs2);
+    auto mask_words = get_vmask_words<VLEN>(V);
+    auto vd_elems = reinterpret_cast<src_elem_t*>(V + VLEN / 8 * vd);
+    uint64_t current = 0;
+    for(size_t word = vstart / 64; word < (end + 63) / 64; word++) {
+        uint64_t active = (vm ? ~uint64_t(0) : mask_words.get(word)) & mask_word_select(word, vstart, end);
+        uint64_t hits = vs2_words.get(word) & active;
+        for(; active; active &= active - 1) {
+            unsigned bit = __builtin_ctzll(active);
+            vd_elems[word * 64 + bit] = current;
+            current += hits >> bit & 1;
         }
     }
 }
 template <unsigned VLEN, typename src_elem_t> void vid(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    auto vd_view = get_vreg<VLEN, src_elem_t>(V, vd, vlmax);
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
-    for(size_t idx = vstart; idx < std::min(vl, vlmax); idx++) {
-        bool mask_active = vm ? 1 : mask_reg[idx];
-        if(mask_active)
-            vd_view[idx] = idx;
-    }
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    uint64_t end = std::min(vl, vlmax);
+    auto vd_elems = reinterpret_cast<src_elem_t*>(V + VLEN / 8 * vd);
+    if(vm) {
+        size_t idx = vstart;
+        if constexpr(sizeof(src_elem_t) < 8) {
+            // SWAR: one 64-bit store per block of lanes, adding the lane offsets without carries between lanes
+            constexpr unsigned lanes = 8 / sizeof(src_elem_t);
+            constexpr uint64_t lane_ones = ~uint64_t(0) >> (64 - 8 * sizeof(src_elem_t));
+            constexpr uint64_t high_bits = ~uint64_t(0) / lane_ones << (8 * sizeof(src_elem_t) - 1);
+            constexpr uint64_t offsets = [] {
+                uint64_t val = 0;
+                for(unsigned lane = 0; lane < lanes; lane++)
+                    val |= uint64_t(lane) << (8 * sizeof(src_elem_t) * lane);
+                return val;
+            }();
+            for(; idx % lanes && idx < end; idx++)
+                vd_elems[idx] = idx;
+            for(; idx + lanes <= end; idx += lanes) {
+                uint64_t base = (idx & lane_ones) * (~uint64_t(0) / lane_ones);
+                uint64_t block = ((base & ~high_bits) + offsets) ^ (base & high_bits);
+                std::memcpy(vd_elems + idx, &block, 8);
+            }
+        }
+        for(; idx < end; idx++)
+            vd_elems[idx] = idx;
+    } else
+        for_each_active<VLEN>(V, end, vstart, [vd_elems](size_t idx) {
+            vd_elems[idx] = idx;
+            return true;
+        });
 }
 template <unsigned VLEN, typename src_elem_t> uint64_t scalar_move(uint8_t* V, vtype_t vtype, unsigned vd, uint64_t val, bool to_vector) {
-    unsigned vlmax = VLEN * vtype.lmul() / vtype.sew();
+    unsigned vlmax = vtype.vlmax(VLEN, vtype.sew());
     auto vd_view = get_vreg<VLEN, src_elem_t>(V, vd, vlmax);
     if(to_vector) {
         vd_view[0] = val;
@@ -1951,7 +4373,7 @@ template <unsigned VLEN, typename src_elem_t> uint64_t scalar_move(uint8_t* V, v
 }
 template <unsigned VLEN, typename src_elem_t>
 void vector_slideup(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / (sizeof(src_elem_t) * 8);
+    uint64_t vlmax = vtype.vlmax(VLEN, sizeof(src_elem_t) * 8);
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, src_elem_t>(V, vd, vlmax);
@@ -1968,7 +4390,7 @@ void vector_slideup(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, boo
 }
 template <unsigned VLEN, typename src_elem_t>
 void vector_slidedown(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / (sizeof(src_elem_t) * 8);
+    uint64_t vlmax = vtype.vlmax(VLEN, sizeof(src_elem_t) * 8);
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, src_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, src_elem_t>(V, vd, vlmax);
@@ -2006,7 +4428,7 @@ void vector_slide1down(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
 }
 template <unsigned VLEN, typename dest_elem_t, typename scr_elem_t>
 void vector_vector_gather(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs1_view = get_vreg<VLEN, scr_elem_t>(V, vs1, vlmax);
     auto vs2_view = get_vreg<VLEN, dest_elem_t>(V, vs2, vlmax);
@@ -2024,7 +4446,7 @@ void vector_vector_gather(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtyp
 }
 template <unsigned VLEN, typename scr_elem_t>
 void vector_imm_gather(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
     vmask_view mask_reg = read_vmask<VLEN>(V, vlmax);
     auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
@@ -2039,18 +4461,62 @@ void vector_imm_gather(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype,
         for(size_t idx = vl; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+// appends the elements of src selected by active (one 64 element block) to dest and returns how many were written
+template <unsigned VLEN, typename elem_t> size_t compress_mask_word(elem_t* dest, const elem_t* src, uint64_t active) {
+#if defined(__AVX512F__)
+    if constexpr(sizeof(elem_t) == 4 || sizeof(elem_t) == 8) {
+        constexpr unsigned lanes = 64 / sizeof(elem_t);
+        size_t count = 0;
+        for(unsigned chunk = 0; chunk < 64 / lanes; chunk++) {
+            uint64_t sel = active >> (chunk * lanes) & (~uint64_t(0) >> (64 - lanes));
+            if(!sel)
+                continue;
+            if constexpr(sizeof(elem_t) == 4)
+                _mm512_mask_compressstoreu_epi32(dest + count, sel, _mm512_maskz_loadu_epi32(sel, src + chunk * lanes));
+            else
+                _mm512_mask_compressstoreu_epi64(dest + count, sel, _mm512_maskz_loadu_epi64(sel, src + chunk * lanes));
+            count += __builtin_popcountll(sel);
+        }
+        return count;
+    }
+#endif
+#if defined(__BMI2__)
+    // the 8 byte chunk holding an active element never crosses the end of the register group once VLEN is a multiple of 64
+    if constexpr(sizeof(elem_t) < 8 && VLEN % 64 == 0) {
+        constexpr unsigned lanes = 8 / sizeof(elem_t);
+        constexpr uint64_t lane_ones = ~uint64_t(0) >> (64 - 8 * sizeof(elem_t));
+        constexpr uint64_t lane_lsbs = ~uint64_t(0) / lane_ones;
+        size_t count = 0;
+        for(unsigned chunk = 0; chunk < 64 / lanes; chunk++) {
+            uint64_t sel = active >> (chunk * lanes) & ((uint64_t(1) << lanes) - 1);
+            if(!sel)
+                continue;
+            uint64_t data;
+            std::memcpy(&data, src + chunk * lanes, 8);
+            uint64_t packed = _pext_u64(data, _pdep_u64(sel, lane_lsbs) * lane_ones);
+            size_t n = __builtin_popcountll(sel);
+            std::memcpy(dest + count, &packed, n * sizeof(elem_t));
+            count += n;
+        }
+        return count;
+    }
+#endif
+    size_t count = 0;
+    for(; active; active &= active - 1)
+        dest[count++] = src[__builtin_ctzll(active)];
+    return count;
+}
 template <unsigned VLEN, typename scr_elem_t>
 void vector_compress(uint8_t* V, uint64_t vl, uint64_t vstart, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / vtype.sew();
-    vmask_view mask_reg = read_vmask<VLEN>(V, vlmax, vs1);
-    auto vs2_view = get_vreg<VLEN, scr_elem_t>(V, vs2, vlmax);
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    auto vs1_words = get_vmask_words<VLEN>(V, vs1);
+    auto vs2_elems = reinterpret_cast<scr_elem_t*>(V + VLEN / 8 * vs2);
     auto vd_view = get_vreg<VLEN, scr_elem_t>(V, vd, vlmax);
-    unsigned current_pos = 0;
-    for(size_t idx = vstart; idx < vl; idx++)
-        if(mask_reg[idx]) {
-            vd_view[current_pos] = vs2_view[idx];
-            current_pos += 1;
-        }
+    auto vd_elems = reinterpret_cast<scr_elem_t*>(vd_view.start);
+    size_t current_pos = 0;
+    for(size_t word = vstart / 64; word < (vl + 63) / 64; word++)
+        if(uint64_t active = vs1_words.get(word) & mask_word_select(word, vstart, vl))
+            current_pos += compress_mask_word<VLEN>(vd_elems + current_pos, vs2_elems + word * 64, active);
 
     if(vtype.vta())
         for(size_t idx = vl; idx < vlmax; idx++)
@@ -2062,14 +4528,99 @@ template <unsigned VLEN> void vector_whole_move(uint8_t* V, unsigned vd, unsigne
     memcpy(vd_view.start, vs2_view.start, VLEN / 8 * count);
 }
 
-template <unsigned VLEN, unsigned EGS>
-void vector_vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
-                          unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / (vtype.sew() * EGS);
+template <unsigned FUNCT6, unsigned VS1> uint128_t crypto_funct(uint128_t vd, uint128_t vs2, uint128_t vs1) {
+    if constexpr(FUNCT6 == 0b101000 || FUNCT6 == 0b101001) { // VAES.VV, VAES.VS
+        if constexpr(VS1 == 0b00000) { // VAESDM
+            uint128_t sr = aes_shift_rows_inv(vd);
+            uint128_t sb = aes_subbytes_inv(sr);
+            uint128_t ark = sb ^ vs2;
+            uint128_t mix = aes_mixcolumns_inv(ark);
+            return mix;
+        } else if constexpr(VS1 == 0b00001) { // VAESDF
+            uint128_t sr = aes_shift_rows_inv(vd);
+            uint128_t sb = aes_subbytes_inv(sr);
+            uint128_t ark = sb ^ vs2;
+            return ark;
+        } else if constexpr(VS1 == 0b00010) { // VAESEM
+            uint128_t sb = aes_subbytes_fwd(vd);
+            uint128_t sr = aes_shift_rows_fwd(sb);
+            uint128_t mix = aes_mixcolumns_fwd(sr);
+            uint128_t ark = mix ^ vs2;
+            return ark;
+        } else if constexpr(VS1 == 0b00011) { // VAESEF
+            uint128_t sb = aes_subbytes_fwd(vd);
+            uint128_t sr = aes_shift_rows_fwd(sb);
+            uint128_t ark = sr ^ vs2;
+            return ark;
+        } else if constexpr(VS1 == 0b00111) { // VAESZ
+            uint128_t ark = vd ^ vs2;
+            return ark;
+        } else if constexpr(VS1 == 0b10001) { // VGMUL
+            uint128_t Y = brev8<uint128_t>(vd);
+            uint128_t H = brev8<uint128_t>(vs2);
+            uint128_t Z = 0;
+            for(size_t bit = 0; bit < 128; bit++) {
+                if((Y >> bit) & 1)
+                    Z ^= H;
+                bool reduce = (H >> 127) & 1;
+                H = H << 1;
+                if(reduce)
+                    H ^= 0x87;
+            }
+            uint128_t result = brev8<uint128_t>(Z);
+            return result;
+        } else
+            static_assert(unsupported_encoding<FUNCT6, VS1>, "Unsupported operation in crypto_funct");
+    } else if constexpr(FUNCT6 == 0b100010) { // VAESKF1
+        uint32_t k0 = (vs2 >> 32 * 0) & std::numeric_limits<uint32_t>::max();
+        uint32_t k1 = (vs2 >> 32 * 1) & std::numeric_limits<uint32_t>::max();
+        uint32_t k2 = (vs2 >> 32 * 2) & std::numeric_limits<uint32_t>::max();
+        uint32_t k3 = (vs2 >> 32 * 3) & std::numeric_limits<uint32_t>::max();
+        uint32_t w0 = aes_subword_fwd(aes_rotword(k3)) ^ aes_decode_rcon(vs1) ^ k0;
+        uint32_t w1 = w0 ^ k1;
+        uint32_t w2 = w1 ^ k2;
+        uint32_t w3 = w2 ^ k3;
+        uint128_t result = (uint128_t(w3) << 96) | (uint128_t(w2) << 64) | (uint128_t(w1) << 32) | (uint128_t(w0));
+        return result;
+    } else if constexpr(FUNCT6 == 0b101010) { // VAESKF2
+        uint32_t k0 = (vs2 >> 32 * 0) & std::numeric_limits<uint32_t>::max();
+        uint32_t k1 = (vs2 >> 32 * 1) & std::numeric_limits<uint32_t>::max();
+        uint32_t k2 = (vs2 >> 32 * 2) & std::numeric_limits<uint32_t>::max();
+        uint32_t k3 = (vs2 >> 32 * 3) & std::numeric_limits<uint32_t>::max();
+        uint32_t rkb0 = (vd >> 32 * 0) & std::numeric_limits<uint32_t>::max();
+        uint32_t rkb1 = (vd >> 32 * 1) & std::numeric_limits<uint32_t>::max();
+        uint32_t rkb2 = (vd >> 32 * 2) & std::numeric_limits<uint32_t>::max();
+        uint32_t rkb3 = (vd >> 32 * 3) & std::numeric_limits<uint32_t>::max();
+        uint32_t w0 = vs1 & 1 ? aes_subword_fwd(k3) ^ rkb0 : aes_subword_fwd(aes_rotword(k3)) ^ aes_decode_rcon((vs1 >> 1) - 1) ^ rkb0;
+        uint32_t w1 = w0 ^ rkb1;
+        uint32_t w2 = w1 ^ rkb2;
+        uint32_t w3 = w2 ^ rkb3;
+        uint128_t result = (uint128_t(w3) << 96) | (uint128_t(w2) << 64) | (uint128_t(w1) << 32) | (uint128_t(w0));
+        return result;
+    } else if constexpr(FUNCT6 == 0b101100) { // VGHSH
+        auto H = brev8<uint128_t>(vs2);
+        uint128_t Z = 0;
+        uint128_t S = brev8<uint128_t>(vd ^ vs1);
+        for(size_t bit = 0; bit < 128; bit++) {
+            if((S >> bit) & 1)
+                Z ^= H;
+            bool reduce = (H >> 127) & 1;
+            H = H << 1;
+            if(reduce)
+                H ^= 0x87;
+        }
+        uint128_t result = brev8<uint128_t>(Z);
+        return result;
+    } else
+        static_assert(unsupported_encoding<FUNCT6, VS1>, "Unknown funct6 in crypto_funct");
+}
+template <unsigned VLEN, unsigned EGS, typename funct_t>
+void vector_vector_crypto_loop(uint8_t* V, funct_t fn, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                               unsigned vs1) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew() * EGS);
     auto vs1_view = get_vreg<VLEN, uint128_t>(V, vs1, vlmax);
     auto vs2_view = get_vreg<VLEN, uint128_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, uint128_t>(V, vd, vlmax);
-    auto fn = get_crypto_funct(funct6, vs1);
     for(size_t idx = eg_start; idx < eg_len; idx++) {
         vd_view[idx] = fn(vd_view[idx], vs2_view[idx], vs1_view[idx]);
     }
@@ -2078,12 +4629,21 @@ void vector_vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
 template <unsigned VLEN, unsigned EGS>
-void vector_scalar_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+void vector_vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
                           unsigned vs1) {
-    uint64_t vlmax = VLEN * vtype.lmul() / (vtype.sew() * EGS);
+    auto fn = get_crypto_funct(funct6, vs1);
+    vector_vector_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned VS1, unsigned EGS>
+void vector_vector_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1) {
+    auto fn = [](uint128_t vd, uint128_t vs2, uint128_t vs1) { return crypto_funct<FUNCT6, VS1>(vd, vs2, vs1); };
+    vector_vector_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned EGS, typename funct_t>
+void vector_scalar_crypto_loop(uint8_t* V, funct_t fn, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew() * EGS);
     auto vs2_val = get_vreg<VLEN, uint128_t>(V, vs2, vlmax)[0];
     auto vd_view = get_vreg<VLEN, uint128_t>(V, vd, vlmax);
-    auto fn = get_crypto_funct(funct6, vs1);
     for(size_t idx = eg_start; idx < eg_len; idx++) {
         vd_view[idx] = fn(vd_view[idx], vs2_val, -1);
     }
@@ -2091,14 +4651,24 @@ void vector_scalar_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t
         for(size_t idx = eg_len; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
-
 template <unsigned VLEN, unsigned EGS>
-void vector_imm_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
-                       uint8_t imm) {
-    uint64_t vlmax = VLEN * vtype.lmul() / (vtype.sew() * EGS);
+void vector_scalar_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                          unsigned vs1) {
+    auto fn = get_crypto_funct(funct6, vs1);
+    vector_scalar_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned VS1, unsigned EGS>
+void vector_scalar_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2) {
+    auto fn = [](uint128_t vd, uint128_t vs2, uint128_t vs1) { return crypto_funct<FUNCT6, VS1>(vd, vs2, vs1); };
+    vector_scalar_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2);
+}
+
+template <unsigned VLEN, unsigned EGS, typename funct_t>
+void vector_imm_crypto_loop(uint8_t* V, funct_t fn, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                            uint8_t imm) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew() * EGS);
     auto vs2_view = get_vreg<VLEN, uint128_t>(V, vs2, vlmax);
     auto vd_view = get_vreg<VLEN, uint128_t>(V, vd, vlmax);
-    auto fn = get_crypto_funct(funct6, -1);
     for(size_t idx = eg_start; idx < eg_len; idx++) {
         vd_view[idx] = fn(vd_view[idx], vs2_view[idx], imm);
     }
@@ -2106,118 +4676,143 @@ void vector_imm_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg
         for(size_t idx = eg_len; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
 }
+template <unsigned VLEN, unsigned EGS>
+void vector_imm_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                       uint8_t imm) {
+    auto fn = get_crypto_funct(funct6, -1);
+    vector_imm_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2, imm);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned EGS>
+void vector_imm_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, uint8_t imm) {
+    auto fn = [](uint128_t vd, uint128_t vs2, uint128_t vs1) { return crypto_funct<FUNCT6, static_cast<unsigned>(-1)>(vd, vs2, vs1); };
+    vector_imm_crypto_loop<VLEN, EGS>(V, fn, eg_len, eg_start, vtype, vd, vs2, imm);
+}
 
-template <typename T> std::function<void(vreg_view<T>&, vreg_view<T>&, vreg_view<T>&)> get_crypto_funct(unsigned int funct6) {
-    switch(funct6) {
-    case 0b101110: // VSHA2CH
-        return [](vreg_view<T>& vd_view, vreg_view<T>& vs2_view, vreg_view<T>& vs1_view) {
-            T a = vs2_view[3];
-            T b = vs2_view[2];
-            T c = vd_view[3];
-            T d = vd_view[2];
-            T e = vs2_view[1];
-            T f = vs2_view[0];
-            T g = vd_view[1];
-            T h = vd_view[0];
-            T W0 = vs1_view[2];
-            T W1 = vs1_view[3];
-            T T1 = h + sum1(e) + ch(e, f, g) + W0;
-            T T2 = sum0(a) + maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
-            T1 = h + sum1(e) + ch(e, f, g) + W1;
-            T2 = sum0(a) + maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
-            vd_view[0] = f;
-            vd_view[1] = e;
-            vd_view[2] = b;
-            vd_view[3] = a;
-        };
-    case 0b101111: // VSHA2CL
-        return [](vreg_view<T>& vd_view, vreg_view<T>& vs2_view, vreg_view<T>& vs1_view) {
-            T a = vs2_view[3];
-            T b = vs2_view[2];
-            T c = vd_view[3];
-            T d = vd_view[2];
-            T e = vs2_view[1];
-            T f = vs2_view[0];
-            T g = vd_view[1];
-            T h = vd_view[0];
-            T W0 = vs1_view[0];
-            T W1 = vs1_view[1];
-            T T1 = h + sum1(e) + ch(e, f, g) + W0;
-            T T2 = sum0(a) + maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
-            T1 = h + sum1(e) + ch(e, f, g) + W1;
-            T2 = sum0(a) + maj(a, b, c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + T1;
-            d = c;
-            c = b;
-            b = a;
-            a = T1 + T2;
-            vd_view[0] = f;
-            vd_view[1] = e;
-            vd_view[2] = b;
-            vd_view[3] = a;
-        };
-    case 0b101101: // VSHA2MS
-        return [](vreg_view<T>& vd_view, vreg_view<T>& vs2_view, vreg_view<T>& vs1_view) {
-            T W0 = vd_view[0];
-            T W1 = vd_view[1];
-            T W2 = vd_view[2];
-            T W3 = vd_view[3];
+template <unsigned FUNCT6, typename T> void crypto_funct(vreg_view<T>& vd_view, vreg_view<T>& vs2_view, vreg_view<T>& vs1_view) {
+    if constexpr(FUNCT6 == 0b101110) { // VSHA2CH
+        T a = vs2_view[3];
+        T b = vs2_view[2];
+        T c = vd_view[3];
+        T d = vd_view[2];
+        T e = vs2_view[1];
+        T f = vs2_view[0];
+        T g = vd_view[1];
+        T h = vd_view[0];
+        T W0 = vs1_view[2];
+        T W1 = vs1_view[3];
+        T T1 = h + sum1(e) + ch(e, f, g) + W0;
+        T T2 = sum0(a) + maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+        T1 = h + sum1(e) + ch(e, f, g) + W1;
+        T2 = sum0(a) + maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+        vd_view[0] = f;
+        vd_view[1] = e;
+        vd_view[2] = b;
+        vd_view[3] = a;
+    } else if constexpr(FUNCT6 == 0b101111) { // VSHA2CL
+        T a = vs2_view[3];
+        T b = vs2_view[2];
+        T c = vd_view[3];
+        T d = vd_view[2];
+        T e = vs2_view[1];
+        T f = vs2_view[0];
+        T g = vd_view[1];
+        T h = vd_view[0];
+        T W0 = vs1_view[0];
+        T W1 = vs1_view[1];
+        T T1 = h + sum1(e) + ch(e, f, g) + W0;
+        T T2 = sum0(a) + maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+        T1 = h + sum1(e) + ch(e, f, g) + W1;
+        T2 = sum0(a) + maj(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + T1;
+        d = c;
+        c = b;
+        b = a;
+        a = T1 + T2;
+        vd_view[0] = f;
+        vd_view[1] = e;
+        vd_view[2] = b;
+        vd_view[3] = a;
+    } else if constexpr(FUNCT6 == 0b101101) { // VSHA2MS
+        T W0 = vd_view[0];
+        T W1 = vd_view[1];
+        T W2 = vd_view[2];
+        T W3 = vd_view[3];
 
-            T W4 = vs2_view[0];
-            T W9 = vs2_view[1];
-            T W10 = vs2_view[2];
-            T W11 = vs2_view[3];
+        T W4 = vs2_view[0];
+        T W9 = vs2_view[1];
+        T W10 = vs2_view[2];
+        T W11 = vs2_view[3];
 
-            T W12 = vs1_view[0];
-            T W13 = vs1_view[1];
-            T W14 = vs1_view[2];
-            T W15 = vs1_view[3];
+        T W12 = vs1_view[0];
+        T W13 = vs1_view[1];
+        T W14 = vs1_view[2];
+        T W15 = vs1_view[3];
 
-            T W16 = sig1(W14) + W9 + sig0(W1) + W0;
-            T W17 = sig1(W15) + W10 + sig0(W2) + W1;
-            T W18 = sig1(W16) + W11 + sig0(W3) + W2;
-            T W19 = sig1(W17) + W12 + sig0(W4) + W3;
+        T W16 = sig1(W14) + W9 + sig0(W1) + W0;
+        T W17 = sig1(W15) + W10 + sig0(W2) + W1;
+        T W18 = sig1(W16) + W11 + sig0(W3) + W2;
+        T W19 = sig1(W17) + W12 + sig0(W4) + W3;
 
-            vd_view[0] = W16;
-            vd_view[1] = W17;
-            vd_view[2] = W18;
-            vd_view[3] = W19;
-        };
+        vd_view[0] = W16;
+        vd_view[1] = W17;
+        vd_view[2] = W18;
+        vd_view[3] = W19;
+    } else
+        static_assert(unsupported_encoding<FUNCT6>, "Unsupported operation in crypto_funct");
+}
+template <typename T>
+std::add_pointer_t<void(vreg_view<T>&, vreg_view<T>&, vreg_view<T>&)> find_crypto_funct(unsigned int funct6) noexcept {
+    switch(funct6) {
+    case 0b101110: // VSHA2CH
+        return crypto_funct<0b101110, T>;
+    case 0b101111: // VSHA2CL
+        return crypto_funct<0b101111, T>;
+    case 0b101101: // VSHA2MS
+        return crypto_funct<0b101101, T>;
     default:
-        throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+        return nullptr;
     }
 }
-template <unsigned VLEN, unsigned EGS, typename elem_type_t>
-void vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
-                   unsigned vs1) {
-    auto fn = get_crypto_funct<elem_type_t>(funct6);
+template <typename T>
+std::add_pointer_t<void(vreg_view<T>&, vreg_view<T>&, vreg_view<T>&)> get_crypto_funct_ptr(unsigned int funct6) {
+    if(auto fn = find_crypto_funct<T>(funct6))
+        return fn;
+    throw new std::runtime_error("Unsupported operation in get_crypto_funct");
+}
+template <typename T>
+std::function<void(vreg_view<T>&, vreg_view<T>&, vreg_view<T>&)> get_crypto_funct(unsigned int funct6) {
+    return get_crypto_funct_ptr<T>(funct6);
+}
+template <unsigned VLEN, unsigned EGS, typename elem_type_t, typename funct_t>
+void vector_crypto_loop(uint8_t* V, funct_t fn, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                        unsigned vs1) {
     auto vd_view = get_vreg<VLEN, elem_type_t>(V, vd, EGS);
     auto vs2_view = get_vreg<VLEN, elem_type_t>(V, vs2, EGS);
     auto vs1_view = get_vreg<VLEN, elem_type_t>(V, vs1, EGS);
@@ -2229,11 +4824,132 @@ void vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_sta
         vs1_view.start += EGS * sizeof(elem_type_t);
     }
     if(vtype.vta()) {
-        uint64_t vlmax = VLEN * vtype.lmul() / (vtype.sew());
+        uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
         auto vd_view = get_vreg<VLEN, elem_type_t>(V, vd, vlmax);
         for(size_t idx = eg_len * EGS; idx < vlmax; idx++)
             vd_view[idx] = agnostic_behavior(vd_view[idx]);
     }
 }
-
+template <unsigned VLEN, unsigned EGS, typename elem_type_t>
+void vector_crypto(uint8_t* V, unsigned funct6, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2,
+                   unsigned vs1) {
+    auto fn = get_crypto_funct_ptr<elem_type_t>(funct6);
+    vector_crypto_loop<VLEN, EGS, elem_type_t>(V, fn, eg_len, eg_start, vtype, vd, vs2, vs1);
+}
+template <unsigned VLEN, unsigned FUNCT6, unsigned EGS, typename elem_type_t>
+void vector_crypto(uint8_t* V, uint64_t eg_len, uint64_t eg_start, vtype_t vtype, unsigned vd, unsigned vs2, unsigned vs1) {
+    auto fn = [](vreg_view<elem_type_t>& vd_view, vreg_view<elem_type_t>& vs2_view, vreg_view<elem_type_t>& vs1_view) {
+        crypto_funct<FUNCT6, elem_type_t>(vd_view, vs2_view, vs1_view);
+    };
+    vector_crypto_loop<VLEN, EGS, elem_type_t>(V, fn, eg_len, eg_start, vtype, vd, vs2, vs1);
+}
+template <unsigned VLEN>
+vstatus_t execute_block(uint8_t* V, const prepared_op<VLEN>* ops, const uint64_t* scalars, size_t count, uint64_t vl, uint64_t vstart,
+                        uint8_t frm, uint8_t vxrm) noexcept {
+    bool vxsat = false;
+    uint8_t accrued_flags = 0;
+    for(size_t i = 0; i < count; i++) {
+        const prepared_op<VLEN>& op = ops[i];
+        assert(!op.exec || op.cfg.vtype.underlying == ops[0].cfg.vtype.underlying);
+        if(!op.exec) {
+            softfloat_exceptionFlags = accrued_flags;
+            return {vstatus_t::ILLEGAL_INSTRUCTION, vxsat, static_cast<uint16_t>(i), 0};
+        }
+        softfloat_exceptionFlags = 0;
+        vstatus_t status = op.exec(V, op, vl, i ? 0 : vstart, scalars ? scalars[i] : 0, op.fixed_point ? vxrm : frm);
+        accrued_flags |= softfloat_exceptionFlags;
+        vxsat |= status.vxsat;
+        if(status.code != vstatus_t::OK) {
+            softfloat_exceptionFlags = accrued_flags;
+            return {status.code, vxsat, static_cast<uint16_t>(i), status.fault_idx};
+        }
+    }
+    softfloat_exceptionFlags = accrued_flags;
+    return vstatus_t::ok(vxsat);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t, typename load_fn_t, typename store_fn_t>
+vstatus_t fused_load_fp_store(void* core, load_fn_t load_fn, store_fn_t store_fn, uint8_t* V, uint64_t vl, uint64_t vstart,
+                              const vconfig_t& cfg, bool vm, unsigned vd, unsigned vs2, uint64_t rs1_load, elem_t scalar,
+                              uint64_t rs1_store, uint8_t rm) {
+    // a masked vle or vf<op> must not overwrite v0
+    assert(cfg.sew == sizeof(elem_t) * 8 && vd != vs2 && (vm || (vd != 0 && vs2 != 0)));
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, cfg.vlmax);
+    auto vd_view = get_vreg<VLEN, elem_t>(V, vd, cfg.vlmax);
+    // results of the arithmetic are held back until the loads succeeded
+    elem_t result[VLEN / sizeof(elem_t)];
+    uint8_t accrued_flags = 0;
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool mask_active = vm ? 1 : mask_reg[idx];
+        if(mask_active) {
+            elem_t val;
+            if(!load_fn(core, rs1_load + idx * sizeof(elem_t), sizeof(elem_t), reinterpret_cast<uint8_t*>(&val)))
+                return vstatus_t::fault(idx, 0);
+            vs2_view[idx] = val;
+            result[idx] = fp_funct<FUNCT6, OPFVF, elem_t, elem_t, elem_t>(rm, accrued_flags, vd_view[idx], val, scalar);
+        } else if(cfg.vma)
+            vs2_view[idx] = agnostic_behavior(vs2_view[idx]);
+    }
+    softfloat_exceptionFlags = accrued_flags;
+    if(cfg.vta)
+        for(size_t idx = vl; idx < cfg.vlmax; idx++) {
+            vs2_view[idx] = agnostic_behavior(vs2_view[idx]);
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+        }
+    bool store_ok = true;
+    uint64_t fault_idx = 0;
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool mask_active = vm ? 1 : mask_reg[idx];
+        if(mask_active) {
+            vd_view[idx] = result[idx];
+            if(store_ok && !store_fn(core, rs1_store + idx * sizeof(elem_t), sizeof(elem_t), reinterpret_cast<uint8_t*>(&result[idx]))) {
+                store_ok = false;
+                fault_idx = idx;
+            }
+        } else if(cfg.vma)
+            vd_view[idx] = agnostic_behavior(vd_view[idx]);
+    }
+    return store_ok ? vstatus_t::ok() : vstatus_t::fault(fault_idx, 2);
+}
+template <unsigned VLEN, unsigned FUNCT6, typename elem_t, typename load_fn_t>
+vstatus_t fused_load_compare_first(void* core, load_fn_t load_fn, uint8_t* V, uint64_t& vl, uint64_t vstart, const vconfig_t& cfg, bool vm,
+                                   unsigned vd, unsigned vs2, uint64_t rs1, elem_t scalar, bool fault_only_first, uint64_t& first) {
+    // a masked vle or vms<cmp> must not overwrite v0
+    assert(cfg.sew == sizeof(elem_t) * 8 && vd != vs2 && (vm || (vd != 0 && vs2 != 0)));
+    vmask_view mask_reg = read_vmask<VLEN>(V, cfg.vlmax);
+    auto vs2_view = get_vreg<VLEN, elem_t>(V, vs2, cfg.vlmax);
+    // the compare results are collected in a copy of vd, which is written back once all loads succeeded
+    uint8_t vd_bytes[VLEN / 8];
+    memcpy(vd_bytes, V + VLEN / 8 * vd, VLEN / 8);
+    vmask_view vd_mask_view{vd_bytes, VLEN};
+    first = -1;
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool mask_active = vm ? 1 : mask_reg[idx];
+        if(mask_active) {
+            elem_t val;
+            if(!load_fn(core, rs1 + idx * sizeof(elem_t), sizeof(elem_t), reinterpret_cast<uint8_t*>(&val))) {
+                if(!fault_only_first || idx == 0)
+                    return vstatus_t::fault(idx, 0);
+                vl = idx;
+                break;
+            }
+            vs2_view[idx] = val;
+            bool res = mask_funct<FUNCT6, OPIVX, elem_t>(val, scalar);
+            vd_mask_view[idx] = res;
+            if(res && first == static_cast<uint64_t>(-1))
+                first = idx;
+        } else if(cfg.vma) {
+            vs2_view[idx] = agnostic_behavior(vs2_view[idx]);
+            vd_mask_view[idx] = agnostic_behavior<bool>(vd_mask_view[idx]);
+        }
+    }
+    if(cfg.vta) {
+        for(size_t idx = vl; idx < cfg.vlmax; idx++)
+            vs2_view[idx] = agnostic_behavior(vs2_view[idx]);
+        for(size_t idx = vl; idx < VLEN; idx++)
+            vd_mask_view[idx] = agnostic_behavior<bool>(vd_mask_view[idx]);
+    }
+    memcpy(V + VLEN / 8 * vd, vd_bytes, VLEN / 8);
+    return vstatus_t::ok();
+}
 } // namespace softvector
\ No newline at end of file
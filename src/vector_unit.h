@@ -0,0 +1,683 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECTOR_UNIT_H
+#define VECTOR_UNIT_H
+#include <cassert>
+#include <cstdint>
+#include <vector_functions.h>
+namespace softvector {
+// scalar register of a strip-mined loop advancing by vl << shift per strip, e.g. a pointer moving by vl * sizeof(elem)
+struct strip_update_t {
+    uint64_t* reg;
+    unsigned shift;
+};
+// architectural state of the vector unit of a single hart. It owns the register file and the vector CSRs and keeps the decoded
+// vtype (cfg) next to them, so the member functions only take the operands encoded in the instruction itself. Every member function
+// forwards to the free function of the same name, resets vstart on completion and accrues vxsat and fflags.
+template <unsigned VLEN> class vector_unit {
+public:
+    uint64_t vl = 0;
+    uint64_t vstart = 0;
+    // decoded vtype, only to be changed through vsetvl
+    vconfig_t cfg{vtype_t(uint64_t(1) << 63), VLEN};
+    uint8_t vxrm = 0;
+    bool vxsat = false;
+    // frm and fflags are shared with the scalar FPU, the owner of the hart has to keep them in sync
+    uint8_t frm = 0;
+    uint8_t fflags = 0;
+    alignas(64) uint8_t V[VLEN * RFS / 8]{};
+    // counts the writes to v0 done through this class, code writing V directly has to call invalidate_v0()
+    uint64_t v0_generation = 0;
+
+    vtype_t vtype() const { return cfg.vtype; }
+    uint8_t vcsr() const { return vxrm << 1 | vxsat; }
+    void invalidate_v0() { v0_generation++; }
+    // v0 expanded to one all-ones or all-zeros lane_t per element, only rebuilt if v0 or the lane width changed since the last call.
+    // Covers VLEN / sizeof(lane_t) elements, the largest vlmax with elements of that width
+    template <typename lane_t> const lane_t* v0_lanes() {
+        if(lanes_generation != v0_generation || lanes_width != sizeof(lane_t)) {
+            expand_vmask<VLEN>(V, VLEN / sizeof(lane_t), reinterpret_cast<lane_t*>(lanes));
+            lanes_generation = v0_generation;
+            lanes_width = sizeof(lane_t);
+        }
+        return reinterpret_cast<const lane_t*>(lanes);
+    }
+    // sets vtype and returns the new vl, vill is set for unsupported or reserved encodings
+    uint64_t vsetvl(uint64_t avl, vtype_t vtype) {
+        vconfig_t new_cfg(vtype, VLEN);
+        bool reserved_bits = (vtype.underlying & ~(uint64_t(1) << 63)) >> 8;
+        bool reserved = vtype.vill() || reserved_bits || vtype.sew() > 64 || (vtype.underlying & 0b111) == 0b100 || new_cfg.vlmax == 0;
+        if(reserved) {
+            cfg = vconfig_t(vtype_t(uint64_t(1) << 63), VLEN);
+            vl = 0;
+        } else {
+            cfg = new_cfg;
+            vl = avl < cfg.vlmax ? avl : cfg.vlmax;
+        }
+        vstart = 0;
+        return vl;
+    }
+    // executes an operation prepared for the current vtype, rm is taken from vxrm or frm as the operation requires
+    vstatus_t execute(const prepared_op<VLEN>& op, uint64_t scalar = 0) noexcept {
+        assert(!op.exec || op.cfg.vtype.underlying == cfg.vtype.underlying);
+        note_write(op.vd);
+        softfloat_exceptionFlags = 0;
+        return retire(op(V, vl, vstart, scalar, op.fixed_point ? vxrm : frm));
+    }
+    // executes the prepared operations of a basic block, vstart names the element to resume with in the failing operation
+    vstatus_t execute_block(const prepared_op<VLEN>* ops, const uint64_t* scalars, size_t count) noexcept {
+        for(size_t i = 0; i < count; i++)
+            note_write(ops[i].vd);
+        return retire(softvector::execute_block<VLEN>(V, ops, scalars, count, vl, vstart, frm, vxrm));
+    }
+    // runs a strip-mined loop: vsetvli with the remaining avl, the operations of the body, then the scalar updates, while avl is not 0.
+    // scalars[i] points to the register holding the scalar operand of ops[i] (nullptr if it has none), so it sees the updates of
+    // the previous strip. If an operation faults or is illegal the state is the one of the single-stepped loop at this point: avl
+    // and the updated registers reflect the completed strips, vl the current one and vstart the faulting element
+    vstatus_t strip_loop(uint64_t& avl, vtype_t vtype, const prepared_op<VLEN>* ops, const uint64_t* const* scalars, size_t count,
+                         const strip_update_t* updates, size_t update_count) noexcept {
+        while(avl) {
+            vsetvl(avl, vtype);
+            if(cfg.vtype.vill())
+                return vstatus_t::illegal(0);
+            for(size_t i = 0; i < count; i++) {
+                const prepared_op<VLEN>& op = ops[i];
+                assert(!op.exec || op.cfg.vtype.underlying == cfg.vtype.underlying);
+                note_write(op.vd);
+                softfloat_exceptionFlags = 0;
+                auto status = op(V, vl, vstart, scalars && scalars[i] ? *scalars[i] : 0, op.fixed_point ? vxrm : frm);
+                status.op_idx = i;
+                if(!retire(status))
+                    return status;
+            }
+            for(size_t i = 0; i < update_count; i++)
+                *updates[i].reg += vl << updates[i].shift;
+            avl -= vl;
+        }
+        return vstatus_t::ok();
+    }
+
+    template <typename eew_t, typename access_fn_t>
+    vstatus_t vector_load_store(void* core, access_fn_t load_store_fn, bool vm, uint8_t vd, uint64_t rs1, uint8_t segment_size,
+                                int64_t stride = 0, bool use_stride = false) {
+        note_write(vd);
+        return update_vstart(vector_load_store_loop<VLEN, eew_t>(core, load_store_fn, V, vl, vstart, cfg.vtype, vm, vd, rs1, segment_size,
+                                                                  stride, use_stride));
+    }
+    template <unsigned XLEN, typename eew_t, typename sew_t, typename access_fn_t>
+    vstatus_t vector_load_store_index(void* core, access_fn_t load_store_fn, bool vm, uint8_t vd, uint64_t rs1, uint8_t vs2,
+                                      uint8_t segment_size) {
+        note_write(vd);
+        return update_vstart(vector_load_store_index_loop<XLEN, VLEN, eew_t, sew_t>(core, load_store_fn, V, vl, vstart, cfg.vtype, vm, vd,
+                                                                                     rs1, vs2, segment_size));
+    }
+
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+    void vector_vector_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0,
+                      vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = src2_elem_t>
+    void vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        constexpr bool simd = has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3);
+        // for the other operations blending pays off where a mask byte covers many lanes, with wider elements the walk over the active
+        // elements is faster
+        if constexpr(simd) {
+            auto vs1_elems = reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1);
+            auto simd_loop = simd_vector_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>();
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, vs1_elems, 0, vm ? nullptr : v0_lanes<dest_elem_t>());
+        } else if(sizeof(dest_elem_t) <= 2 && !vm && vl > small_vl) {
+            auto fn = [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t vs1) {
+                return funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vd, vs2, vs1);
+            };
+            vector_vector_blend_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, v0_lanes<dest_elem_t>(), vd, vs2,
+                                                                                   vs1);
+        } else
+            softvector::vector_vector_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2,
+                                                                                                     vs1);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+    void vector_imm_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2,
+                       typename std::make_signed<src1_elem_t>::type imm) {
+        note_write(vd);
+        auto fn = get_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        if(auto simd_loop = find_simd_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, nullptr, imm, vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = src2_elem_t>
+    void vector_imm_op(bool vm, unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+        note_write(vd);
+        constexpr bool simd = has_simd_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3);
+        if constexpr(simd) {
+            auto simd_loop = simd_vector_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>();
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, nullptr, imm, vm ? nullptr : v0_lanes<dest_elem_t>());
+        } else if(sizeof(dest_elem_t) <= 2 && !vm && vl > small_vl) {
+            auto fn = [](dest_elem_t vd, src2_elem_t vs2, src1_elem_t imm) {
+                return funct<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vd, vs2, imm);
+            };
+            vector_imm_blend_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, v0_lanes<dest_elem_t>(), vd, vs2,
+                                                                                imm);
+        } else
+            softvector::vector_imm_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2,
+                                                                                                  imm);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void vector_vector_carry(unsigned funct6, unsigned funct3, unsigned vd, unsigned vs2, unsigned vs1, signed carry) {
+        note_write(vd);
+        softvector::vector_vector_carry<VLEN, elem_t>(V, funct6, funct3, vl, vstart, cfg.vtype, vd, vs2, vs1, carry);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+    void vector_vector_carry(unsigned vd, unsigned vs2, unsigned vs1, signed carry) {
+        note_write(vd);
+        softvector::vector_vector_carry<VLEN, FUNCT6, FUNCT3, elem_t>(V, vl, vstart, cfg.vtype, vd, vs2, vs1, carry);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void vector_imm_carry(unsigned funct6, unsigned funct3, unsigned vd, unsigned vs2, typename std::make_signed<elem_t>::type imm,
+                          signed carry) {
+        note_write(vd);
+        softvector::vector_imm_carry<VLEN, elem_t>(V, funct6, funct3, vl, vstart, cfg.vtype, vd, vs2, imm, carry);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+    void vector_imm_carry(unsigned vd, unsigned vs2, typename std::make_signed<elem_t>::type imm, signed carry) {
+        note_write(vd);
+        softvector::vector_imm_carry<VLEN, FUNCT6, FUNCT3, elem_t>(V, vl, vstart, cfg.vtype, vd, vs2, imm, carry);
+        vstart = 0;
+    }
+    template <typename scr_elem_t> void vector_vector_merge(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_vector_merge<VLEN, scr_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename scr_elem_t> void vector_imm_merge(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_imm_merge<VLEN, scr_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t>
+    void vector_unary_op(unsigned unary_op, bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        if(auto simd_loop = find_simd_unary_loop<VLEN, dest_elem_t, src2_elem_t>(unary_op))
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            softvector::vector_unary_op<VLEN, dest_elem_t, src2_elem_t>(V, unary_op, vl, vstart, cfg.vtype, vm, vd, vs2);
+        vstart = 0;
+    }
+    template <unsigned UNARY_OP, typename dest_elem_t, typename src2_elem_t = dest_elem_t>
+    void vector_unary_op(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        if(auto simd_loop = find_simd_unary_loop<VLEN, dest_elem_t, src2_elem_t>(UNARY_OP))
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            softvector::vector_unary_op<VLEN, UNARY_OP, dest_elem_t, src2_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void mask_vector_vector_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_mask_funct_ptr<elem_t>(funct6, funct3);
+        mask_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+    void mask_vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::mask_vector_vector_op<VLEN, FUNCT6, FUNCT3, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void mask_vector_imm_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2,
+                            typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        auto fn = get_mask_funct_ptr<elem_t>(funct6, funct3);
+        mask_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename elem_t>
+    void mask_vector_imm_op(bool vm, unsigned vd, unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        softvector::mask_vector_imm_op<VLEN, FUNCT6, FUNCT3, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename elem_t> void carry_vector_vector_op(unsigned funct6, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::carry_vector_vector_op<VLEN, elem_t>(V, funct6, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, typename elem_t> void carry_vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::carry_vector_vector_op<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void carry_vector_imm_op(unsigned funct6, bool vm, unsigned vd, unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        softvector::carry_vector_imm_op<VLEN, elem_t>(V, funct6, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, typename elem_t>
+    void carry_vector_imm_op(bool vm, unsigned vd, unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        softvector::carry_vector_imm_op<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void vector_vector_carry_chain(unsigned funct6, unsigned vd, unsigned vcarry, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        note_write(vcarry);
+        softvector::vector_vector_carry_chain<VLEN, elem_t>(V, funct6, vl, vstart, cfg.vtype, vd, vcarry, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, typename elem_t> void vector_vector_carry_chain(unsigned vd, unsigned vcarry, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        note_write(vcarry);
+        softvector::vector_vector_carry_chain<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vd, vcarry, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename elem_t>
+    void vector_imm_carry_chain(unsigned funct6, unsigned vd, unsigned vcarry, unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        note_write(vcarry);
+        softvector::vector_imm_carry_chain<VLEN, elem_t>(V, funct6, vl, vstart, cfg.vtype, vd, vcarry, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, typename elem_t>
+    void vector_imm_carry_chain(unsigned vd, unsigned vcarry, unsigned vs2, typename std::make_signed<elem_t>::type imm) {
+        note_write(vd);
+        note_write(vcarry);
+        softvector::vector_imm_carry_chain<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vd, vcarry, vs2, imm);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+    void sat_vector_vector_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_sat_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+            vxsat |= simd_loop(V, vl, vstart, cfg, vxrm, vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0,
+                               vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vxsat |= sat_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vxrm, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = dest_elem_t>
+    void sat_vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        if constexpr(has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+            vxsat |= simd_sat_vxrm_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(
+                V, vl, vstart, cfg, vxrm, vm, vd, vs2, reinterpret_cast<src1_elem_t*>(V + VLEN / 8 * vs1), 0,
+                vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vxsat |= softvector::sat_vector_vector_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(
+                V, vl, vstart, cfg.vtype, vxrm, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = dest_elem_t>
+    void sat_vector_imm_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2,
+                           typename std::make_signed<src1_elem_t>::type imm) {
+        note_write(vd);
+        auto fn = get_sat_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        if(auto simd_loop = find_simd_sat_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3))
+            vxsat |= simd_loop(V, vl, vstart, cfg, vxrm, vm, vd, vs2, nullptr, imm, vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vxsat |= sat_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vxrm, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = dest_elem_t>
+    void sat_vector_imm_op(bool vm, unsigned vd, unsigned vs2, typename std::make_signed<src1_elem_t>::type imm) {
+        note_write(vd);
+        if constexpr(has_simd_sat_funct<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3))
+            vxsat |= simd_sat_vxrm_loop<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(
+                V, vl, vstart, cfg, vxrm, vm, vd, vs2, nullptr, imm, vm ? nullptr : v0_lanes<dest_elem_t>());
+        else
+            vxsat |= softvector::sat_vector_imm_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg.vtype,
+                                                                                                              vxrm, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src_elem_t = dest_elem_t>
+    void vector_red_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+        if(auto simd_loop = find_simd_red_loop<VLEN, dest_elem_t, src_elem_t>(funct6, funct3))
+            simd_loop(V, vl, vstart, cfg, vm, vd, vs2, vs1, vm ? nullptr : v0_lanes<src_elem_t>());
+        else
+            vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+    void vector_red_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        if constexpr(has_simd_red_funct<dest_elem_t, src_elem_t>(FUNCT6, FUNCT3))
+            simd_red_loop_for<VLEN, FUNCT6, FUNCT3, dest_elem_t, src_elem_t>()(V, vl, vstart, cfg, vm, vd, vs2, vs1,
+                                                                               vm ? nullptr : v0_lanes<src_elem_t>());
+        else
+            softvector::vector_red_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    void mask_mask_op(unsigned funct6, unsigned funct3, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::mask_mask_op<VLEN>(V, funct6, funct3, vl, vstart, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3> void mask_mask_op(unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::mask_mask_op<VLEN, FUNCT6, FUNCT3>(V, vl, vstart, vd, vs2, vs1);
+        vstart = 0;
+    }
+    uint64_t vcpop(bool vm, unsigned vs2) {
+        auto res = softvector::vcpop<VLEN>(V, vl, vstart, vm, vs2);
+        vstart = 0;
+        return res;
+    }
+    uint64_t vfirst(bool vm, unsigned vs2) {
+        auto res = softvector::vfirst<VLEN>(V, vl, vstart, vm, vs2);
+        vstart = 0;
+        return res;
+    }
+    void mask_set_op(unsigned enc, bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::mask_set_op<VLEN>(V, enc, vl, vstart, vm, vd, vs2);
+        vstart = 0;
+    }
+    template <unsigned ENC> void mask_set_op(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::mask_set_op<VLEN, ENC>(V, vl, vstart, vm, vd, vs2);
+        vstart = 0;
+    }
+    template <typename src_elem_t> void viota(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::viota<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2);
+        vstart = 0;
+    }
+    template <typename src_elem_t> void vid(bool vm, unsigned vd) {
+        note_write(vd);
+        softvector::vid<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd);
+        vstart = 0;
+    }
+    // vmv.s.x/vfmv.s.f only write vd if vstart < vl, the element 0 is returned either way
+    template <typename src_elem_t> uint64_t scalar_move(unsigned vd, uint64_t val, bool to_vector) {
+        note_write(vd);
+        auto res = softvector::scalar_move<VLEN, src_elem_t>(V, cfg.vtype, vd, val, to_vector && vstart < vl);
+        vstart = 0;
+        return res;
+    }
+    template <typename src_elem_t> void vector_slideup(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_slideup<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename src_elem_t> void vector_slidedown(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_slidedown<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename src_elem_t> void vector_slide1up(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_slide1up<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename src_elem_t> void vector_slide1down(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_slide1down<VLEN, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename scr_elem_t = dest_elem_t>
+    void vector_vector_gather(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_vector_gather<VLEN, dest_elem_t, scr_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <typename scr_elem_t> void vector_imm_gather(bool vm, unsigned vd, unsigned vs2, uint64_t imm) {
+        note_write(vd);
+        softvector::vector_imm_gather<VLEN, scr_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <typename scr_elem_t> void vector_compress(unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_compress<VLEN, scr_elem_t>(V, vl, vstart, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    void vector_whole_move(unsigned vd, unsigned vs2, unsigned count) {
+        note_write(vd);
+        softvector::vector_whole_move<VLEN>(V, vd, vs2, count);
+        vstart = 0;
+    }
+    template <typename dest_elem_t, typename src_elem_t = dest_elem_t>
+    void fp_vector_red_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_fp_red_funct_ptr<dest_elem_t, src_elem_t>(funct6, funct3);
+        fp_vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1, frm);
+        finish_fp();
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src_elem_t = dest_elem_t>
+    void fp_vector_red_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::fp_vector_red_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1, frm);
+        finish_fp();
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+    void fp_vector_vector_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_fp_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        fp_vector_vector_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1, frm);
+        finish_fp();
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = src2_elem_t>
+    void fp_vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::fp_vector_vector_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2,
+                                                                                                    vs1, frm);
+        finish_fp();
+    }
+    template <typename dest_elem_t, typename src2_elem_t = dest_elem_t, typename src1_elem_t = src2_elem_t>
+    void fp_vector_imm_op(unsigned funct6, unsigned funct3, bool vm, unsigned vd, unsigned vs2, src1_elem_t imm) {
+        note_write(vd);
+        auto fn = get_fp_funct_ptr<dest_elem_t, src2_elem_t, src1_elem_t>(funct6, funct3);
+        fp_vector_imm_loop<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, imm, frm);
+        finish_fp();
+    }
+    template <unsigned FUNCT6, unsigned FUNCT3, typename dest_elem_t, typename src2_elem_t = dest_elem_t,
+              typename src1_elem_t = src2_elem_t>
+    void fp_vector_imm_op(bool vm, unsigned vd, unsigned vs2, src1_elem_t imm) {
+        note_write(vd);
+        softvector::fp_vector_imm_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2,
+                                                                                                 imm, frm);
+        finish_fp();
+    }
+    template <typename elem_t> void fp_vector_unary_op(unsigned encoding_space, unsigned unary_op, bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_op<VLEN, elem_t>(V, encoding_space, unary_op, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <unsigned ENCODING_SPACE, unsigned UNARY_OP, typename elem_t> void fp_vector_unary_op(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_op<VLEN, ENCODING_SPACE, UNARY_OP, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <typename dest_elem_t, typename src_elem_t> void fp_vector_unary_w(unsigned unary_op, bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_w<VLEN, dest_elem_t, src_elem_t>(V, unary_op, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t> void fp_vector_unary_w(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_w<VLEN, UNARY_OP, dest_elem_t, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <typename dest_elem_t, typename src_elem_t> void fp_vector_unary_n(unsigned unary_op, bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_n<VLEN, dest_elem_t, src_elem_t>(V, unary_op, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <unsigned UNARY_OP, typename dest_elem_t, typename src_elem_t> void fp_vector_unary_n(bool vm, unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::fp_vector_unary_n<VLEN, UNARY_OP, dest_elem_t, src_elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, frm);
+        finish_fp();
+    }
+    template <typename elem_t> void mask_fp_vector_vector_op(unsigned funct6, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        auto fn = get_fp_mask_funct_ptr<elem_t>(funct6);
+        mask_fp_vector_vector_loop<VLEN, elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, vs1, frm);
+        finish_fp();
+    }
+    template <unsigned FUNCT6, typename elem_t> void mask_fp_vector_vector_op(bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::mask_fp_vector_vector_op<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, vs1, frm);
+        finish_fp();
+    }
+    template <typename elem_t> void mask_fp_vector_imm_op(unsigned funct6, bool vm, unsigned vd, unsigned vs2, elem_t imm) {
+        note_write(vd);
+        auto fn = get_fp_mask_funct_ptr<elem_t>(funct6);
+        mask_fp_vector_imm_loop<VLEN, elem_t>(V, fn, vl, vstart, cfg, vm, vd, vs2, imm, frm);
+        finish_fp();
+    }
+    template <unsigned FUNCT6, typename elem_t> void mask_fp_vector_imm_op(bool vm, unsigned vd, unsigned vs2, elem_t imm) {
+        note_write(vd);
+        softvector::mask_fp_vector_imm_op<VLEN, FUNCT6, elem_t>(V, vl, vstart, cfg.vtype, vm, vd, vs2, imm, frm);
+        finish_fp();
+    }
+    // the crypto operations work on element groups of EGS elements, vl and vstart are multiples of EGS
+    template <unsigned EGS> void vector_vector_crypto(unsigned funct6, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_vector_crypto<VLEN, EGS>(V, funct6, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned VS1, unsigned EGS> void vector_vector_crypto(unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_vector_crypto<VLEN, FUNCT6, VS1, EGS>(V, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned EGS> void vector_scalar_crypto(unsigned funct6, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_scalar_crypto<VLEN, EGS>(V, funct6, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned VS1, unsigned EGS> void vector_scalar_crypto(unsigned vd, unsigned vs2) {
+        note_write(vd);
+        softvector::vector_scalar_crypto<VLEN, FUNCT6, VS1, EGS>(V, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2);
+        vstart = 0;
+    }
+    template <unsigned EGS> void vector_imm_crypto(unsigned funct6, unsigned vd, unsigned vs2, uint8_t imm) {
+        note_write(vd);
+        softvector::vector_imm_crypto<VLEN, EGS>(V, funct6, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned EGS> void vector_imm_crypto(unsigned vd, unsigned vs2, uint8_t imm) {
+        note_write(vd);
+        softvector::vector_imm_crypto<VLEN, FUNCT6, EGS>(V, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, imm);
+        vstart = 0;
+    }
+    template <unsigned EGS, typename elem_type_t> void vector_crypto(unsigned funct6, unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_crypto<VLEN, EGS, elem_type_t>(V, funct6, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, unsigned EGS, typename elem_type_t> void vector_crypto(unsigned vd, unsigned vs2, unsigned vs1) {
+        note_write(vd);
+        softvector::vector_crypto<VLEN, FUNCT6, EGS, elem_type_t>(V, vl / EGS, vstart / EGS, cfg.vtype, vd, vs2, vs1);
+        vstart = 0;
+    }
+    template <unsigned FUNCT6, typename elem_t, typename load_fn_t, typename store_fn_t>
+    vstatus_t fused_load_fp_store(void* core, load_fn_t load_fn, store_fn_t store_fn, bool vm, unsigned vd, unsigned vs2, uint64_t rs1_load,
+                                  elem_t scalar, uint64_t rs1_store) {
+        note_write(vd);
+        note_write(vs2);
+        auto status = softvector::fused_load_fp_store<VLEN, FUNCT6, elem_t>(core, load_fn, store_fn, V, vl, vstart, cfg, vm, vd, vs2,
+                                                                            rs1_load, scalar, rs1_store, frm);
+        // the arithmetic has not been executed if the load faulted
+        if(status.code != vstatus_t::FAULT || status.op_idx > 0)
+            accrue_fflags();
+        return update_vstart(status);
+    }
+    // the fault-only-first form updates vl
+    template <unsigned FUNCT6, typename elem_t, typename load_fn_t>
+    vstatus_t fused_load_compare_first(void* core, load_fn_t load_fn, bool vm, unsigned vd, unsigned vs2, uint64_t rs1, elem_t scalar,
+                                       bool fault_only_first, uint64_t& first) {
+        note_write(vd);
+        note_write(vs2);
+        return update_vstart(softvector::fused_load_compare_first<VLEN, FUNCT6, elem_t>(core, load_fn, V, vl, vstart, cfg, vm, vd, vs2, rs1,
+                                                                                        scalar, fault_only_first, first));
+    }
+
+private:
+    alignas(64) uint8_t lanes[VLEN];
+    uint64_t lanes_generation = ~uint64_t(0);
+    unsigned lanes_width = 0;
+
+    void note_write(unsigned vd) {
+        if(vd == 0)
+            invalidate_v0();
+    }
+    void accrue_fflags() { fflags |= softfloat_exceptionFlags & 0x1f; }
+    void finish_fp() {
+        accrue_fflags();
+        vstart = 0;
+    }
+    // vstart after an operation or a block of them: the element to resume with after a fault, 0 once an operation completed. An
+    // illegal first operation did not start and leaves it to the trap handler
+    vstatus_t update_vstart(vstatus_t status) {
+        if(status.code == vstatus_t::FAULT)
+            vstart = status.fault_idx;
+        else if(status.code == vstatus_t::OK || status.op_idx > 0)
+            vstart = 0;
+        return status;
+    }
+    // the CSR updates shared by execute, execute_block and strip_loop, vxsat and fflags accrue also if the operation failed
+    vstatus_t retire(vstatus_t status) {
+        vxsat |= status.vxsat;
+        accrue_fflags();
+        return update_vstart(status);
+    }
+};
+} // namespace softvector
+#endif /* VECTOR_UNIT_H */
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the bit and byte reversals and the bit counts: the scalar helpers and the vector kernels against bit by bit loops
+#include "funct_test.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+template <typename T> T loop_brev(T v) {
+    T res = 0;
+    for(size_t i = 0; i < sizeof(T) * 8; i++, v >>= 1)
+        res = static_cast<T>(res << 1 | (v & 1));
+    return res;
+}
+template <typename T> T loop_brev8(T v) {
+    T res = 0;
+    for(size_t i = 0; i < sizeof(T); i++)
+        res |= static_cast<T>(loop_brev<uint8_t>(static_cast<uint8_t>(v >> i * 8))) << i * 8;
+    return res;
+}
+template <typename T> T loop_rev8(T v) {
+    T res = 0;
+    for(size_t i = 0; i < sizeof(T); i++, v >>= 8)
+        res = static_cast<T>(res << 8 | (v & 0xff));
+    return res;
+}
+template <typename T> T loop_clz(T v) {
+    T res = 0;
+    for(T bit = static_cast<T>(T(1) << (sizeof(T) * 8 - 1)); bit && !(v & bit); bit >>= 1)
+        res++;
+    return res;
+}
+template <typename T> T loop_ctz(T v) {
+    T res = 0;
+    for(T bit = 1; bit && !(v & bit); bit <<= 1)
+        res++;
+    return res;
+}
+template <typename T> T loop_cpop(T v) {
+    T res = 0;
+    for(; v; v >>= 1)
+        res += v & 1;
+    return res;
+}
+template <typename T> T random_scalar() {
+    if constexpr(sizeof(T) == 16)
+        return static_cast<T>(edge_value<uint64_t>()) << 64 | edge_value<uint64_t>();
+    else
+        return edge_value<T>();
+}
+// brev, brev8 and byte_swap of crypto_util.h, 128 bit as used by the GHASH helpers
+template <typename T> void check_scalar() {
+    T v = random_scalar<T>();
+    auto hex = [](T x) { return static_cast<uint64_t>(x); };
+    check(brev<T>(v) == loop_brev(v), "brev SEW %zu of 0x%" PRIx64, sizeof(T) * 8, hex(v));
+    check(brev8<T>(v) == loop_brev8(v), "brev8 SEW %zu of 0x%" PRIx64, sizeof(T) * 8, hex(v));
+    check(byte_swap(v) == loop_rev8(v), "byte_swap SEW %zu of 0x%" PRIx64, sizeof(T) * 8, hex(v));
+}
+// the element functions of VCLZ, VCTZ and VCPOP, 0 in a tenth of the runs
+template <typename T> void check_counts() {
+    T v = edge_value<T>();
+    check(unary_fn<0b01100, T, T>(v) == loop_clz(v), "clz SEW %zu of 0x%" PRIx64, sizeof(T) * 8, static_cast<uint64_t>(v));
+    check(unary_fn<0b01101, T, T>(v) == loop_ctz(v), "ctz SEW %zu of 0x%" PRIx64, sizeof(T) * 8, static_cast<uint64_t>(v));
+    check(unary_fn<0b01110, T, T>(v) == loop_cpop(v), "cpop SEW %zu of 0x%" PRIx64, sizeof(T) * 8, static_cast<uint64_t>(v));
+}
+template <unsigned VLEN, typename T> void run_all() {
+    check_unary<VLEN, T, T, 0b01000>(loop_brev8<T>); // VBREV8
+    check_unary<VLEN, T, T, 0b01001>(loop_rev8<T>);  // VREV8
+    check_unary<VLEN, T, T, 0b01010>(loop_brev<T>);  // VBREV
+    check_unary<VLEN, T, T, 0b01100>(loop_clz<T>);   // VCLZ
+    check_unary<VLEN, T, T, 0b01101>(loop_ctz<T>);   // VCTZ
+    check_unary<VLEN, T, T, 0b01110>(loop_cpop<T>);  // VCPOP
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 500);
+    for(unsigned i = 0; i < count; i++) {
+        check_scalar<uint8_t>();
+        check_scalar<uint16_t>();
+        check_scalar<uint32_t>();
+        check_scalar<uint64_t>();
+        check_scalar<uint128_t>();
+        check_counts<uint8_t>();
+        check_counts<uint16_t>();
+        check_counts<uint32_t>();
+        check_counts<uint64_t>();
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("bit_unary");
+}
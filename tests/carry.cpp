@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// vadc/vsbc, vmadc/vmsbc and the combined carry chain against an element-wise reference of the specification
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned VADC = 0b010000, VMADC = 0b010001, VSBC = 0b010010, VMSBC = 0b010011;
+
+enum class form { sum, carry_out, chain };
+
+// the element-wise reference: all sources are read before anything is written, the sums go to vd if sum is set, the carry (borrow)
+// outs to vcarry if carry_out is set. The carry ins are the bits of v0 if use_carry_in is set. The sums and carries are computed in
+// 128 bit, the carry out is the bit above SEW of the sum, the borrow out the sign of the difference
+template <unsigned VLEN, typename T, typename src1_t>
+void reference(uint8_t* V, bool subtract, bool sum, bool carry_out, bool use_carry_in, vtype_t vtype, uint64_t vl, uint64_t vstart,
+               unsigned vd, unsigned vcarry, unsigned vs2, src1_t src1) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    alignas(64) static uint8_t src[reg_file_size(VLEN)];
+    memcpy(src, V, sizeof(src));
+    for(size_t idx = vstart; idx < vl; idx++) {
+        __int128 a = elem<VLEN, T>(src, vs2, idx), b = src1(src, idx), carry_in = use_carry_in && mask_bit<VLEN>(src, 0, idx);
+        __int128 wide = subtract ? a - b - carry_in : a + b + carry_in;
+        if(sum)
+            elem<VLEN, T>(V, vd, idx) = static_cast<T>(wide);
+        if(carry_out)
+            set_mask_bit<VLEN>(V, vcarry, idx, subtract ? wide < 0 : wide >> sizeof(T) * 8 != 0);
+    }
+    if(agnostic_ones) {
+        if(sum && vtype.vta())
+            for(size_t idx = vl; idx < vlmax; idx++)
+                elem<VLEN, T>(V, vd, idx) = static_cast<T>(~T(0));
+        // the tail of a mask result is always agnostic and spans the whole register
+        if(carry_out)
+            for(size_t idx = vl; idx < VLEN; idx++)
+                set_mask_bit<VLEN>(V, vcarry, idx, true);
+    }
+}
+
+template <unsigned VLEN, typename T, unsigned FUNCT6> void run(form f, bool vv) {
+    typedef typename std::make_signed<T>::type imm_t;
+    constexpr bool subtract = FUNCT6 == VSBC;
+    constexpr unsigned MASK_FUNCT6 = subtract ? VMSBC : VMADC;
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    randomize<VLEN, T>(V, 8, 24);
+    vtype_t vtype = random_vtype<VLEN, T>();
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    // vd may be one of the sources, a mask result goes to v4 or, for the chain, to v0 to feed the next limb
+    unsigned vs2 = 16, vs1 = 24, vd = one_in(4) ? vs2 : 8, vcarry = f == form::chain && one_in(2) ? 0 : 4;
+    bool vm = one_in(2);
+    imm_t imm = one_in(2) ? static_cast<imm_t>(random(32)) - 16 : static_cast<imm_t>(edge_value<T>());
+    memcpy(ref, V, sizeof(ref));
+    auto src1 = [&](const uint8_t* src, size_t idx) { return vv ? elem<VLEN, T>(src, vs1, idx) : static_cast<T>(imm); };
+    if(f == form::sum)
+        reference<VLEN, T>(ref, subtract, true, false, true, vtype, vl, vstart, vd, 0, vs2, src1);
+    else if(f == form::carry_out)
+        reference<VLEN, T>(ref, subtract, false, true, !vm, vtype, vl, vstart, 0, 4, vs2, src1);
+    else
+        reference<VLEN, T>(ref, subtract, true, true, true, vtype, vl, vstart, vd, vcarry, vs2, src1);
+
+    auto e = static_cast<entry>(random(3));
+    if(e == entry::prepared) // there are no prepared carry operations
+        e = entry::unit;
+    signed carry = subtract ? -1 : 1;
+    switch(f) {
+    case form::sum:
+        if(e == entry::runtime && vv)
+            vector_vector_carry<VLEN, T>(V, FUNCT6, OPIVV, vl, vstart, vtype, vd, vs2, vs1, carry);
+        else if(e == entry::runtime)
+            vector_imm_carry<VLEN, T>(V, FUNCT6, OPIVX, vl, vstart, vtype, vd, vs2, imm, carry);
+        else if(e == entry::compile_time && vv)
+            vector_vector_carry<VLEN, FUNCT6, OPIVV, T>(V, vl, vstart, vtype, vd, vs2, vs1, carry);
+        else if(e == entry::compile_time)
+            vector_imm_carry<VLEN, FUNCT6, OPIVX, T>(V, vl, vstart, vtype, vd, vs2, imm, carry);
+        else
+            on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+                if(vv)
+                    unit.template vector_vector_carry<T>(FUNCT6, OPIVV, vd, vs2, vs1, carry);
+                else
+                    unit.template vector_imm_carry<FUNCT6, OPIVX, T>(vd, vs2, imm, carry);
+            });
+        break;
+    case form::carry_out:
+        if(e == entry::runtime && vv)
+            carry_vector_vector_op<VLEN, T>(V, MASK_FUNCT6, vl, vstart, vtype, vm, 4, vs2, vs1);
+        else if(e == entry::runtime)
+            carry_vector_imm_op<VLEN, T>(V, MASK_FUNCT6, vl, vstart, vtype, vm, 4, vs2, imm);
+        else if(e == entry::compile_time && vv)
+            carry_vector_vector_op<VLEN, MASK_FUNCT6, T>(V, vl, vstart, vtype, vm, 4, vs2, vs1);
+        else if(e == entry::compile_time)
+            carry_vector_imm_op<VLEN, MASK_FUNCT6, T>(V, vl, vstart, vtype, vm, 4, vs2, imm);
+        else
+            on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+                if(vv)
+                    unit.template carry_vector_vector_op<T>(MASK_FUNCT6, vm, 4, vs2, vs1);
+                else
+                    unit.template carry_vector_imm_op<MASK_FUNCT6, T>(vm, 4, vs2, imm);
+            });
+        break;
+    case form::chain:
+        if(e == entry::runtime && vv)
+            vector_vector_carry_chain<VLEN, T>(V, FUNCT6, vl, vstart, vtype, vd, vcarry, vs2, vs1);
+        else if(e == entry::runtime)
+            vector_imm_carry_chain<VLEN, T>(V, FUNCT6, vl, vstart, vtype, vd, vcarry, vs2, imm);
+        else if(e == entry::compile_time && vv)
+            vector_vector_carry_chain<VLEN, FUNCT6, T>(V, vl, vstart, vtype, vd, vcarry, vs2, vs1);
+        else if(e == entry::compile_time)
+            vector_imm_carry_chain<VLEN, FUNCT6, T>(V, vl, vstart, vtype, vd, vcarry, vs2, imm);
+        else
+            on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+                if(vv)
+                    unit.template vector_vector_carry_chain<T>(FUNCT6, vd, vcarry, vs2, vs1);
+                else
+                    unit.template vector_imm_carry_chain<FUNCT6, T>(vd, vcarry, vs2, imm);
+            });
+        break;
+    }
+    static const char* form_names[] = {"vadc/vsbc", "vmadc/vmsbc", "carry chain"};
+    check(same_regs<VLEN>(V, ref), "%s %s.%s SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u vcarry v%u via %s",
+          form_names[static_cast<int>(f)], subtract ? "sub" : "add", vv ? "vv" : "vx", sizeof(T) * 8, VLEN,
+          static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd, vcarry, entry_name(e));
+}
+
+template <unsigned VLEN, typename T> void run_all() {
+    for(auto f : {form::sum, form::carry_out, form::chain})
+        for(bool vv : {true, false}) {
+            run<VLEN, T, VADC>(f, vv);
+            run<VLEN, T, VSBC>(f, vv);
+        }
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 200);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("carry");
+}
@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the integer and FP compares against an element-wise reference of the specification. The kernels pack the results of 64 elements
+// into a mask word and merge it into vd, so vl and vstart fall anywhere in a word, and vd is v0 now and then for unmasked compares
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned vs2 = 16, vs1 = 24;
+
+template <typename T> bool fp_eq(T a, T b) {
+    if constexpr(sizeof(T) == 4)
+        return f32_eq(float32_t{a}, float32_t{b});
+    else
+        return f64_eq(float64_t{a}, float64_t{b});
+}
+template <typename T> bool fp_le(T a, T b) {
+    if constexpr(sizeof(T) == 4)
+        return f32_le(float32_t{a}, float32_t{b});
+    else
+        return f64_le(float64_t{a}, float64_t{b});
+}
+template <typename T> bool fp_lt(T a, T b) {
+    if constexpr(sizeof(T) == 4)
+        return f32_lt(float32_t{a}, float32_t{b});
+    else
+        return f64_lt(float64_t{a}, float64_t{b});
+}
+
+// runs the compare FUNCT6 in its .vv or .vx/.vf form through a random entry point and through reference_mask_loop with op(vs2, vs1).
+// vs1 and the scalar repeat elements of vs2 in part of the runs, so the compares for equality hit
+template <unsigned VLEN, typename T, unsigned FUNCT6, bool FP, typename op_t> void check_compare(bool vv, op_t op) {
+    typedef typename std::make_signed<T>::type imm_t;
+    constexpr unsigned FUNCT3_VV = FP ? OPFVV : OPIVV, FUNCT3_VX = FP ? OPFVF : OPIVX;
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    randomize<VLEN, T>(V, vs2, 16);
+    vtype_t vtype = random_vtype<VLEN, T>();
+    if(vtype.vill())
+        return;
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    uint64_t vl = random_vl(vlmax);
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vd = vm && one_in(4) ? 0 : 8;
+    if(one_in(2))
+        for(size_t idx = 0; idx < vlmax; idx++)
+            if(one_in(2))
+                elem<VLEN, T>(V, vs1, idx) = elem<VLEN, T>(V, vs2, idx);
+    T scalar = one_in(2) ? elem<VLEN, T>(V, vs2, random(vlmax)) : edge_value<T>();
+    imm_t imm = static_cast<imm_t>(scalar);
+    memcpy(ref, V, sizeof(ref));
+    reference_mask_loop<VLEN>(ref, vtype, vl, vstart, vm, vd, VLEN, [&](const uint8_t* src, size_t idx) {
+        return op(elem<VLEN, T>(src, vs2, idx), vv ? elem<VLEN, T>(src, vs1, idx) : scalar);
+    });
+
+    auto e = static_cast<entry>(random(static_cast<unsigned>(entry::count)));
+    if constexpr(FP)
+        switch(e) {
+        case entry::runtime:
+            if(vv)
+                mask_fp_vector_vector_op<VLEN, T>(V, FUNCT6, vl, vstart, vtype, vm, vd, vs2, vs1, 0);
+            else
+                mask_fp_vector_imm_op<VLEN, T>(V, FUNCT6, vl, vstart, vtype, vm, vd, vs2, scalar, 0);
+            break;
+        case entry::compile_time:
+            if(vv)
+                mask_fp_vector_vector_op<VLEN, FUNCT6, T>(V, vl, vstart, vtype, vm, vd, vs2, vs1, 0);
+            else
+                mask_fp_vector_imm_op<VLEN, FUNCT6, T>(V, vl, vstart, vtype, vm, vd, vs2, scalar, 0);
+            break;
+        case entry::prepared:
+            if(vv)
+                prepare_mask_fp_vector_vector_op<VLEN, T>(FUNCT6, vtype, vm, vd, vs2, vs1)(V, vl, vstart);
+            else
+                prepare_mask_fp_vector_imm_op<VLEN, T>(FUNCT6, vtype, vm, vd, vs2)(V, vl, vstart, scalar);
+            break;
+        default:
+            on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+                if(vv && one_in(2))
+                    unit.template mask_fp_vector_vector_op<T>(FUNCT6, vm, vd, vs2, vs1);
+                else if(vv)
+                    unit.template mask_fp_vector_vector_op<FUNCT6, T>(vm, vd, vs2, vs1);
+                else if(one_in(2))
+                    unit.template mask_fp_vector_imm_op<T>(FUNCT6, vm, vd, vs2, scalar);
+                else
+                    unit.template mask_fp_vector_imm_op<FUNCT6, T>(vm, vd, vs2, scalar);
+            });
+            break;
+        }
+    else
+        switch(e) {
+        case entry::runtime:
+            if(vv)
+                mask_vector_vector_op<VLEN, T>(V, FUNCT6, FUNCT3_VV, vl, vstart, vtype, vm, vd, vs2, vs1);
+            else
+                mask_vector_imm_op<VLEN, T>(V, FUNCT6, FUNCT3_VX, vl, vstart, vtype, vm, vd, vs2, imm);
+            break;
+        case entry::compile_time:
+            if(vv)
+                mask_vector_vector_op<VLEN, FUNCT6, FUNCT3_VV, T>(V, vl, vstart, vtype, vm, vd, vs2, vs1);
+            else
+                mask_vector_imm_op<VLEN, FUNCT6, FUNCT3_VX, T>(V, vl, vstart, vtype, vm, vd, vs2, imm);
+            break;
+        case entry::prepared:
+            if(vv)
+                prepare_mask_vector_vector_op<VLEN, T>(FUNCT6, FUNCT3_VV, vtype, vm, vd, vs2, vs1)(V, vl, vstart);
+            else
+                prepare_mask_vector_imm_op<VLEN, T>(FUNCT6, FUNCT3_VX, vtype, vm, vd, vs2)(
+                    V, vl, vstart, static_cast<uint64_t>(static_cast<int64_t>(imm)));
+            break;
+        default:
+            on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+                if(vv && one_in(2))
+                    unit.template mask_vector_vector_op<T>(FUNCT6, FUNCT3_VV, vm, vd, vs2, vs1);
+                else if(vv)
+                    unit.template mask_vector_vector_op<FUNCT6, FUNCT3_VV, T>(vm, vd, vs2, vs1);
+                else if(one_in(2))
+                    unit.template mask_vector_imm_op<T>(FUNCT6, FUNCT3_VX, vm, vd, vs2, imm);
+                else
+                    unit.template mask_vector_imm_op<FUNCT6, FUNCT3_VX, T>(vm, vd, vs2, imm);
+            });
+            break;
+        }
+    check(same_regs<VLEN>(V, ref),
+          "%s compare 0x%02x.%s SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u via %s", FP ? "fp" : "int",
+          FUNCT6, vv ? "vv" : FP ? "vf" : "vx", sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd,
+          entry_name(e));
+}
+// the .vv and .vx/.vf forms, the greater-than compares only have the latter
+template <unsigned VLEN, typename T, unsigned FUNCT6, bool FP, typename op_t> void check_compare(op_t op) {
+    constexpr bool vx_only = FP ? FUNCT6 == 0b011101 || FUNCT6 == 0b011111 : FUNCT6 >= 0b011110;
+    if constexpr(!vx_only)
+        check_compare<VLEN, T, FUNCT6, FP>(true, op);
+    check_compare<VLEN, T, FUNCT6, FP>(false, op);
+}
+
+template <unsigned VLEN, typename T> void run_int() {
+    typedef typename std::make_signed<T>::type S;
+    check_compare<VLEN, T, 0b011000, false>([](T a, T b) { return a == b; });                                      // VMSEQ
+    check_compare<VLEN, T, 0b011001, false>([](T a, T b) { return a != b; });                                      // VMSNE
+    check_compare<VLEN, T, 0b011010, false>([](T a, T b) { return a < b; });                                       // VMSLTU
+    check_compare<VLEN, T, 0b011011, false>([](T a, T b) { return static_cast<S>(a) < static_cast<S>(b); });       // VMSLT
+    check_compare<VLEN, T, 0b011100, false>([](T a, T b) { return a <= b; });                                      // VMSLEU
+    check_compare<VLEN, T, 0b011101, false>([](T a, T b) { return static_cast<S>(a) <= static_cast<S>(b); });      // VMSLE
+    check_compare<VLEN, T, 0b011110, false>([](T a, T b) { return a > b; });                                       // VMSGTU
+    check_compare<VLEN, T, 0b011111, false>([](T a, T b) { return static_cast<S>(a) > static_cast<S>(b); });       // VMSGT
+}
+template <unsigned VLEN, typename T> void run_fp() {
+    check_compare<VLEN, T, 0b011000, true>([](T a, T b) { return fp_eq(a, b); });  // VMFEQ
+    check_compare<VLEN, T, 0b011001, true>([](T a, T b) { return fp_le(a, b); });  // VMFLE
+    check_compare<VLEN, T, 0b011011, true>([](T a, T b) { return fp_lt(a, b); });  // VMFLT
+    check_compare<VLEN, T, 0b011100, true>([](T a, T b) { return !fp_eq(a, b); }); // VMFNE
+    check_compare<VLEN, T, 0b011101, true>([](T a, T b) { return fp_lt(b, a); });  // VMFGT
+    check_compare<VLEN, T, 0b011111, true>([](T a, T b) { return fp_le(b, a); });  // VMFGE
+}
+template <unsigned VLEN> void run_all() {
+    run_int<VLEN, uint8_t>();
+    run_int<VLEN, uint16_t>();
+    run_int<VLEN, uint32_t>();
+    run_int<VLEN, uint64_t>();
+    run_fp<VLEN, uint32_t>();
+    run_fp<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 200);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<32>();
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("compare");
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the division kernels: the invariant divisor constants and the vector kernels against the division of the specification, and the
+// RISC-V results of a zero divisor and of MIN / -1
+#include "funct_test.h"
+#include <algorithm>
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+// the quotient or remainder of the specification, in 128 bit so MIN / -1 wraps to MIN without overflowing. A zero divisor gives all
+// ones and leaves the dividend as remainder
+template <typename T, bool SIGNED, bool REMAINDER> T divide(T n, T d, T = 0) {
+    if(d == 0)
+        return REMAINDER ? n : static_cast<T>(~T(0));
+    if(SIGNED)
+        return static_cast<T>(REMAINDER ? as_signed(n) % as_signed(d) : as_signed(n) / as_signed(d));
+    return static_cast<T>(REMAINDER ? n % d : n / d);
+}
+// 0, 1, -1, MIN, MAX, powers of two and their neighbours in half of the draws, a random value otherwise
+template <typename T> T random_divisor() {
+    T power = static_cast<T>(T(1) << random(sizeof(T) * 8));
+    switch(random(8)) {
+    case 0:
+        return edge_value<T>();
+    case 1:
+        return static_cast<T>(~T(0));
+    case 2:
+        return power;
+    case 3:
+        return static_cast<T>(power + random(3) - 1);
+    default:
+        return static_cast<T>(rng()());
+    }
+}
+// the quotients of invariant_divisor, all divisors and dividends for SEW 8, all divisors for SEW 16
+template <typename T, bool SIGNED> void check_invariant_divisor() {
+    constexpr uint64_t divisors = sizeof(T) <= 2 ? uint64_t(1) << (sizeof(T) * 8) : 4096;
+    constexpr uint64_t dividends = sizeof(T) == 1 ? 256 : 64;
+    for(uint64_t i = 0; i < divisors; i++) {
+        T d = sizeof(T) <= 2 ? static_cast<T>(i) : random_divisor<T>();
+        invariant_divisor<T, SIGNED> divisor(d);
+        T n = 0, quotient = 0, expected = 0;
+        for(uint64_t j = 0; j < dividends && quotient == expected; j++) {
+            n = sizeof(T) == 1 ? static_cast<T>(j) : j < 8 ? random_divisor<T>() : edge_value<T>();
+            quotient = divisor.quotient(n);
+            expected = divide<T, SIGNED, false>(n, d);
+        }
+        check(quotient == expected, "invariant_divisor SEW %zu %s: 0x%" PRIx64 " / 0x%" PRIx64 " = 0x%" PRIx64 ", expected 0x%" PRIx64,
+              sizeof(T) * 8, SIGNED ? "signed" : "unsigned", static_cast<uint64_t>(n), static_cast<uint64_t>(d),
+              static_cast<uint64_t>(quotient), static_cast<uint64_t>(expected));
+    }
+}
+// a zero divisor gives all ones and leaves the dividend as remainder, MIN / -1 gives MIN and a zero remainder, vv divides by a vs1
+// holding the divisor in all elements
+template <unsigned VLEN, typename T> void check_division_edges(bool vv) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    constexpr T min = static_cast<T>(T(1) << (sizeof(T) * 8 - 1));
+    constexpr T minus_one = static_cast<T>(~T(0));
+    constexpr uint64_t vlmax = VLEN / 8 / sizeof(T);
+    vtype_t vtype(static_cast<uint64_t>(__builtin_ctz(sizeof(T)) << 3));
+    struct {
+        unsigned funct6;
+        T divisor;
+        T quotient_of_min;
+    } cases[] = {{0b100000, 0, minus_one}, {0b100001, 0, minus_one}, {0b100010, 0, min},
+                 {0b100011, 0, min},       {0b100001, minus_one, min}, {0b100011, minus_one, 0}};
+    for(auto& c : cases) {
+        randomize<VLEN, T>(V, 16, 1);
+        auto vs2_elems = reinterpret_cast<T*>(V + VLEN / 8 * 16);
+        vs2_elems[0] = min;
+        T vs2_copy[vlmax];
+        memcpy(vs2_copy, vs2_elems, sizeof(vs2_copy));
+        auto vs1_elems = reinterpret_cast<T*>(V + VLEN / 8 * 24);
+        std::fill(vs1_elems, vs1_elems + vlmax, c.divisor);
+        if(vv)
+            vector_vector_op<VLEN, T, T, T>(V, c.funct6, OPMVV, vlmax, 0, vtype, true, 8, 16, 24);
+        else
+            vector_imm_op<VLEN, T, T, T>(V, c.funct6, OPMVX, vlmax, 0, vtype, true, 8, 16,
+                                         static_cast<std::make_signed_t<T>>(c.divisor));
+        auto vd_elems = reinterpret_cast<const T*>(V + VLEN / 8 * 8);
+        bool ok = vd_elems[0] == c.quotient_of_min;
+        for(size_t idx = 1; idx < vlmax; idx++) {
+            bool remainder = c.funct6 & 0b10;
+            T expected = c.divisor == 0 ? remainder ? vs2_copy[idx] : minus_one : remainder ? 0 : static_cast<T>(-vs2_copy[idx]);
+            ok &= vd_elems[idx] == expected;
+        }
+        check(ok, "funct6 0x%02x.%s SEW %zu VLEN %u divisor 0x%" PRIx64, c.funct6, vv ? "vv" : "vx", sizeof(T) * 8, VLEN,
+              static_cast<uint64_t>(c.divisor));
+    }
+}
+template <unsigned VLEN, typename T> void run_all() {
+    auto prepare = [](uint8_t* V, std::make_signed_t<T>& imm) {
+        randomize<VLEN, T>(V, 16, 8);
+        imm = static_cast<std::make_signed_t<T>>(random_divisor<T>());
+    };
+    check_funct<VLEN, T, T, T, 0b100000, OPMVV>(false, divide<T, false, false>, prepare); // VDIVU
+    check_funct<VLEN, T, T, T, 0b100001, OPMVV>(false, divide<T, true, false>, prepare);  // VDIV
+    check_funct<VLEN, T, T, T, 0b100010, OPMVV>(false, divide<T, false, true>, prepare);  // VREMU
+    check_funct<VLEN, T, T, T, 0b100011, OPMVV>(false, divide<T, true, true>, prepare);   // VREM
+    // the .vv forms with the divisors in vs1, MIN in vs2 now and then
+    auto prepare_vv = [](uint8_t* V, std::make_signed_t<T>&) {
+        randomize<VLEN, T>(V, 16, 8);
+        for(size_t idx = 0; idx < VLEN / 8 * 8 / sizeof(T); idx++)
+            elem<VLEN, T>(V, 24, idx) = random_divisor<T>();
+    };
+    check_funct<VLEN, T, T, T, 0b100000, OPMVV>(true, divide<T, false, false>, prepare_vv); // VDIVU
+    check_funct<VLEN, T, T, T, 0b100001, OPMVV>(true, divide<T, true, false>, prepare_vv);  // VDIV
+    check_funct<VLEN, T, T, T, 0b100010, OPMVV>(true, divide<T, false, true>, prepare_vv);  // VREMU
+    check_funct<VLEN, T, T, T, 0b100011, OPMVV>(true, divide<T, true, true>, prepare_vv);   // VREM
+    check_division_edges<VLEN, T>(false);
+    check_division_edges<VLEN, T>(true);
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    check_invariant_divisor<uint8_t, false>();
+    check_invariant_divisor<uint8_t, true>();
+    check_invariant_divisor<uint16_t, false>();
+    check_invariant_divisor<uint16_t, true>();
+    check_invariant_divisor<uint32_t, false>();
+    check_invariant_divisor<uint32_t, true>();
+    check_invariant_divisor<uint64_t, false>();
+    check_invariant_divisor<uint64_t, true>();
+    unsigned count = iterations(argc, argv, 200);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("divide");
+}
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the fixed-point kernels against the element operations of the specification for every vxrm, comparing the returned vxsat as well
+#include "funct_test.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+// v shifted right by d and rounded as vxrm tells: to nearest up, to nearest even, down (truncated) or to odd
+__int128 roundoff(__int128 v, unsigned d, unsigned vxrm) {
+    if(d == 0)
+        return v;
+    bool lsb = v >> d & 1, half = v >> (d - 1) & 1;
+    bool below_half = v & ((__int128(1) << (d - 1)) - 1);
+    bool inexact = v & ((__int128(1) << d) - 1);
+    bool increment = vxrm == 0 ? half : vxrm == 1 ? half && (below_half || lsb) : vxrm == 3 && !lsb && inexact;
+    return (v >> d) + increment;
+}
+// v clamped to the range of T, signed or unsigned, sat is set if it is outside
+template <typename T, bool SIGNED> T saturate(__int128 v, bool& sat) {
+    __int128 min = SIGNED ? as_signed(static_cast<T>(T(1) << (sizeof(T) * 8 - 1))) : 0;
+    __int128 max = SIGNED ? as_signed(static_cast<T>(static_cast<T>(~T(0)) >> 1)) : as_unsigned(static_cast<T>(~T(0)));
+    sat |= v < min || v > max;
+    return static_cast<T>(v < min ? min : v > max ? max : v);
+}
+// runs FUNCT6 in its .vv (FUNCT3) or .vx form with rounding mode vxrm through a random entry point and through reference_loop with
+// op(vs2, vs1, vxrm, vxsat), the element operation of the specification. prepare fills the operands before a run
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t,
+          typename prepare_t>
+void check_sat(bool vv, unsigned vxrm, op_t op, prepare_t prepare) {
+    typedef std::conditional_t<(sizeof(dest_elem_t) < sizeof(src2_elem_t)), dest_elem_t, src2_elem_t> sew_t;
+    typedef typename std::make_signed<src1_elem_t>::type imm_t;
+    constexpr unsigned FUNCT3_VX = FUNCT3 == OPIVV ? OPIVX : OPMVX;
+    constexpr bool single_width = sizeof(dest_elem_t) == sizeof(src2_elem_t);
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype = random_vtype<VLEN, sew_t>(single_width ? 3 : 2);
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vs2 = 16, vs1 = 24, vd = random_vd<dest_elem_t, src2_elem_t, src1_elem_t>(vs2, vs1, vv);
+    imm_t imm = static_cast<imm_t>(edge_value<src1_elem_t>());
+    prepare(V, imm);
+    memcpy(ref, V, sizeof(ref));
+    bool expected = false;
+    reference_loop<VLEN, dest_elem_t>(ref, vtype, vl, vstart, vm, vd, [&](const uint8_t* src, size_t idx) {
+        src1_elem_t src1 = vv ? elem<VLEN, src1_elem_t>(src, vs1, idx) : static_cast<src1_elem_t>(imm);
+        return static_cast<dest_elem_t>(op(elem<VLEN, src2_elem_t>(src, vs2, idx), src1, vxrm, expected));
+    });
+    bool vxsat = false;
+    auto e = static_cast<entry>(random(static_cast<unsigned>(entry::count)));
+    switch(e) {
+    case entry::runtime:
+        if(vv)
+            vxsat = sat_vector_vector_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, FUNCT6, FUNCT3, vl, vstart, vtype, vxrm, vm, vd,
+                                                                                      vs2, vs1);
+        else
+            vxsat = sat_vector_imm_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, FUNCT6, FUNCT3_VX, vl, vstart, vtype, vxrm, vm, vd,
+                                                                                   vs2, imm);
+        break;
+    case entry::compile_time:
+        if(vv)
+            vxsat = sat_vector_vector_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, vtype, vxrm, vm, vd,
+                                                                                                      vs2, vs1);
+        else
+            vxsat = sat_vector_imm_op<VLEN, FUNCT6, FUNCT3_VX, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, vtype, vxrm, vm, vd,
+                                                                                                      vs2, imm);
+        break;
+    case entry::prepared:
+        if(vv)
+            vxsat = prepare_sat_vector_vector_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3, vtype, vm, vd, vs2, vs1)(
+                        V, vl, vstart, 0, vxrm)
+                        .vxsat;
+        else
+            vxsat = prepare_sat_vector_imm_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3_VX, vtype, vm, vd, vs2)(
+                        V, vl, vstart, static_cast<uint64_t>(static_cast<int64_t>(imm)), vxrm)
+                        .vxsat;
+        break;
+    default:
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            unit.vxrm = vxrm;
+            unit.vxsat = false;
+            if(vv && one_in(2))
+                unit.template sat_vector_vector_op<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3, vm, vd, vs2, vs1);
+            else if(vv)
+                unit.template sat_vector_vector_op<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vm, vd, vs2, vs1);
+            else if(one_in(2))
+                unit.template sat_vector_imm_op<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3_VX, vm, vd, vs2, imm);
+            else
+                unit.template sat_vector_imm_op<FUNCT6, FUNCT3_VX, dest_elem_t, src2_elem_t, src1_elem_t>(vm, vd, vs2, imm);
+            vxsat = unit.vxsat;
+        });
+        break;
+    }
+    check(same_regs<VLEN>(V, ref) && vxsat == expected,
+          "funct6 0x%02x.%s SEW %zu/%zu VLEN %u vxrm %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u imm %" PRId64
+          " vxsat %d, expected %d via %s",
+          FUNCT6, vv ? "vv" : "vx", sizeof(dest_elem_t) * 8, sizeof(src2_elem_t) * 8, VLEN, vxrm, static_cast<unsigned>(vtype.underlying),
+          vl, vstart, vm, vd, static_cast<int64_t>(imm), vxsat, expected, entry_name(e));
+}
+// edge values in all vector operands, the .vv and .vx forms for every vxrm
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t>
+void check_sat(op_t op) {
+    auto prepare = [](uint8_t* V, typename std::make_signed<src1_elem_t>::type&) {
+        randomize<VLEN, src2_elem_t>(V, 16, 8);
+        for(size_t idx = 0; idx < VLEN / 8 * 8 / sizeof(src1_elem_t); idx++)
+            elem<VLEN, src1_elem_t>(V, 24, idx) = edge_value<src1_elem_t>();
+    };
+    for(unsigned vxrm = 0; vxrm < 4; vxrm++) {
+        check_sat<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, FUNCT6, FUNCT3>(true, vxrm, op, prepare);
+        check_sat<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, FUNCT6, FUNCT3>(false, vxrm, op, prepare);
+    }
+}
+// the shifts by counts around the middle and the top of a 64 bit source, where the rounding increment is taken from bit 31 and
+// above and any 32 bit intermediate would lose it
+template <unsigned VLEN, typename dest_elem_t, unsigned FUNCT6, typename op_t> void check_wide_shifts(op_t op) {
+    for(unsigned shift : {0, 1, 31, 32, 33, 63})
+        for(unsigned vxrm = 0; vxrm < 4; vxrm++) {
+            auto prepare = [shift](uint8_t* V, typename std::make_signed<dest_elem_t>::type& imm) {
+                randomize<VLEN, uint64_t>(V, 16, 8);
+                for(size_t idx = 0; idx < VLEN / 8 * 8 / sizeof(dest_elem_t); idx++)
+                    elem<VLEN, dest_elem_t>(V, 24, idx) = shift;
+                imm = shift;
+            };
+            check_sat<VLEN, dest_elem_t, uint64_t, dest_elem_t, FUNCT6, OPIVV>(true, vxrm, op, prepare);
+            check_sat<VLEN, dest_elem_t, uint64_t, dest_elem_t, FUNCT6, OPIVV>(false, vxrm, op, prepare);
+        }
+}
+// the narrowing clips of a 2 * SEW source
+template <typename N, bool SIGNED> auto nclip() {
+    return [](twice_t<N> a, N b, unsigned vxrm, bool& sat) {
+        return saturate<N, SIGNED>(roundoff(SIGNED ? as_signed(a) : as_unsigned(a), b % (sizeof(N) * 16), vxrm), sat);
+    };
+}
+template <unsigned VLEN, typename T> void run_all() {
+    constexpr unsigned sew = sizeof(T) * 8;
+    check_sat<VLEN, T, T, T, 0b100000, OPIVV>(
+        [](T a, T b, unsigned, bool& sat) { return saturate<T, false>(as_unsigned(a) + b, sat); }); // VSADDU
+    check_sat<VLEN, T, T, T, 0b100001, OPIVV>(
+        [](T a, T b, unsigned, bool& sat) { return saturate<T, true>(as_signed(a) + as_signed(b), sat); }); // VSADD
+    check_sat<VLEN, T, T, T, 0b100010, OPIVV>(
+        [](T a, T b, unsigned, bool& sat) { return saturate<T, false>(__int128(a) - b, sat); }); // VSSUBU
+    check_sat<VLEN, T, T, T, 0b100011, OPIVV>(
+        [](T a, T b, unsigned, bool& sat) { return saturate<T, true>(as_signed(a) - as_signed(b), sat); }); // VSSUB
+    check_sat<VLEN, T, T, T, 0b100111, OPIVV>([](T a, T b, unsigned vxrm, bool& sat) {
+        return saturate<T, true>(roundoff(as_signed(a) * as_signed(b), sew - 1, vxrm), sat);
+    }); // VSMUL
+    check_sat<VLEN, T, T, T, 0b101010, OPIVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(as_unsigned(a), b % sew, vxrm); }); // VSSRL
+    check_sat<VLEN, T, T, T, 0b101011, OPIVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(as_signed(a), b % sew, vxrm); }); // VSSRA
+    check_sat<VLEN, T, T, T, 0b001000, OPMVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(as_unsigned(a) + as_unsigned(b), 1, vxrm); }); // VAADDU
+    check_sat<VLEN, T, T, T, 0b001001, OPMVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(as_signed(a) + as_signed(b), 1, vxrm); }); // VAADD
+    check_sat<VLEN, T, T, T, 0b001010, OPMVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(__int128(a) - b, 1, vxrm); }); // VASUBU
+    check_sat<VLEN, T, T, T, 0b001011, OPMVV>(
+        [](T a, T b, unsigned vxrm, bool&) { return roundoff(as_signed(a) - as_signed(b), 1, vxrm); }); // VASUB
+    if constexpr(sizeof(T) < 8) {
+        check_sat<VLEN, T, twice_t<T>, T, 0b101110, OPIVV>(nclip<T, false>()); // VNCLIPU
+        check_sat<VLEN, T, twice_t<T>, T, 0b101111, OPIVV>(nclip<T, true>());  // VNCLIP
+    }
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+    check_wide_shifts<VLEN, uint64_t, 0b101010>(
+        [](uint64_t a, uint64_t b, unsigned vxrm, bool&) { return roundoff(as_unsigned(a), b % 64, vxrm); }); // VSSRL
+    check_wide_shifts<VLEN, uint64_t, 0b101011>(
+        [](uint64_t a, uint64_t b, unsigned vxrm, bool&) { return roundoff(as_signed(a), b % 64, vxrm); }); // VSSRA
+    check_wide_shifts<VLEN, uint32_t, 0b101110>(nclip<uint32_t, false>()); // VNCLIPU
+    check_wide_shifts<VLEN, uint32_t, 0b101111>(nclip<uint32_t, true>());  // VNCLIP
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 25);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("fixed_point");
+}
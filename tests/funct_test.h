@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FUNCT_TEST_H
+#define FUNCT_TEST_H
+#include "test_util.h"
+namespace softvector {
+namespace test {
+// vd of a random legal overlap: any source of the same EEW, the lowest part of a wider source (narrowing), none for a narrower one
+template <typename dest_elem_t, typename src2_elem_t, typename src1_elem_t> unsigned random_vd(unsigned vs2, unsigned vs1, bool vv) {
+    unsigned choice = random(4);
+    if(choice == 1 && sizeof(dest_elem_t) <= sizeof(src2_elem_t))
+        return vs2;
+    if(choice == 2 && vv && sizeof(dest_elem_t) == sizeof(src1_elem_t))
+        return vs1;
+    return 8;
+}
+// runs FUNCT6 in its .vv (FUNCT3) or .vx form through a random entry point and through reference_loop with op(vs2, vs1, vd), the
+// element operation of the specification. For .vx vs1 is the scalar truncated to src1_elem_t. SEW is the narrower of dest_elem_t and
+// src2_elem_t, prepare fills the operands before a run
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t,
+          typename prepare_t>
+void check_funct(bool vv, op_t op, prepare_t prepare) {
+    typedef std::conditional_t<(sizeof(dest_elem_t) < sizeof(src2_elem_t)), dest_elem_t, src2_elem_t> sew_t;
+    typedef typename std::make_signed<src1_elem_t>::type imm_t;
+    constexpr unsigned FUNCT3_VX = FUNCT3 == OPIVV ? OPIVX : OPMVX;
+    constexpr bool single_width = sizeof(dest_elem_t) == sizeof(sew_t) && sizeof(src2_elem_t) == sizeof(sew_t);
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype = random_vtype<VLEN, sew_t>(single_width ? 3 : 2);
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vs2 = 16, vs1 = 24, vd = random_vd<dest_elem_t, src2_elem_t, src1_elem_t>(vs2, vs1, vv);
+    imm_t imm = static_cast<imm_t>(edge_value<src1_elem_t>());
+    prepare(V, imm);
+    memcpy(ref, V, sizeof(ref));
+    reference_loop<VLEN, dest_elem_t>(ref, vtype, vl, vstart, vm, vd, [&](const uint8_t* src, size_t idx) {
+        src1_elem_t src1 = vv ? elem<VLEN, src1_elem_t>(src, vs1, idx) : static_cast<src1_elem_t>(imm);
+        return static_cast<dest_elem_t>(op(elem<VLEN, src2_elem_t>(src, vs2, idx), src1, elem<VLEN, dest_elem_t>(src, vd, idx)));
+    });
+    auto e = static_cast<entry>(random(static_cast<unsigned>(entry::count)));
+    switch(e) {
+    case entry::runtime:
+        if(vv)
+            vector_vector_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, FUNCT6, FUNCT3, vl, vstart, vtype, vm, vd, vs2, vs1);
+        else
+            vector_imm_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(V, FUNCT6, FUNCT3_VX, vl, vstart, vtype, vm, vd, vs2, imm);
+        break;
+    case entry::compile_time:
+        if(vv)
+            vector_vector_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, vtype, vm, vd, vs2, vs1);
+        else
+            vector_imm_op<VLEN, FUNCT6, FUNCT3_VX, dest_elem_t, src2_elem_t, src1_elem_t>(V, vl, vstart, vtype, vm, vd, vs2, imm);
+        break;
+    case entry::prepared:
+        if(vv)
+            prepare_vector_vector_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3, vtype, vm, vd, vs2, vs1)(V, vl, vstart);
+        else
+            prepare_vector_imm_op<VLEN, dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3_VX, vtype, vm, vd, vs2)(
+                V, vl, vstart, static_cast<uint64_t>(static_cast<int64_t>(imm)));
+        break;
+    default:
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            if(vv && one_in(2))
+                unit.template vector_vector_op<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3, vm, vd, vs2, vs1);
+            else if(vv)
+                unit.template vector_vector_op<FUNCT6, FUNCT3, dest_elem_t, src2_elem_t, src1_elem_t>(vm, vd, vs2, vs1);
+            else if(one_in(2))
+                unit.template vector_imm_op<dest_elem_t, src2_elem_t, src1_elem_t>(FUNCT6, FUNCT3_VX, vm, vd, vs2, imm);
+            else
+                unit.template vector_imm_op<FUNCT6, FUNCT3_VX, dest_elem_t, src2_elem_t, src1_elem_t>(vm, vd, vs2, imm);
+        });
+        break;
+    }
+    check(same_regs<VLEN>(V, ref),
+          "funct6 0x%02x.%s SEW %zu/%zu/%zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u imm %" PRId64 " via %s",
+          FUNCT6, vv ? "vv" : "vx", sizeof(dest_elem_t) * 8, sizeof(src2_elem_t) * 8, sizeof(src1_elem_t) * 8, VLEN,
+          static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd, static_cast<int64_t>(imm), entry_name(e));
+}
+// with edge values in all vector operands
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t>
+void check_funct(bool vv, op_t op) {
+    auto prepare = [](uint8_t* V, typename std::make_signed<src1_elem_t>::type&) {
+        randomize<VLEN, src2_elem_t>(V, 16, 8);
+        for(size_t idx = 0; idx < VLEN / 8 * 8 / sizeof(src1_elem_t); idx++)
+            elem<VLEN, src1_elem_t>(V, 24, idx) = edge_value<src1_elem_t>();
+    };
+    check_funct<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, FUNCT6, FUNCT3>(vv, op, prepare);
+}
+// the .vv and .vx forms
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, typename src1_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t>
+void check_funct(op_t op) {
+    check_funct<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, FUNCT6, FUNCT3>(true, op);
+    check_funct<VLEN, dest_elem_t, src2_elem_t, src1_elem_t, FUNCT6, FUNCT3>(false, op);
+}
+// runs the vector unary operation UNARY_OP (vxunary0 encoding) through a random entry point and through reference_loop with op(vs2).
+// vs2 holds edge values, vd equals it for single width operations now and then
+template <unsigned VLEN, typename dest_elem_t, typename src2_elem_t, unsigned UNARY_OP, typename op_t> void check_unary(op_t op) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype = random_vtype<VLEN, dest_elem_t>();
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vs2 = 24, vd = sizeof(dest_elem_t) == sizeof(src2_elem_t) && one_in(3) ? vs2 : 8;
+    randomize<VLEN, src2_elem_t>(V, vs2, 8);
+    memcpy(ref, V, sizeof(ref));
+    reference_loop<VLEN, dest_elem_t>(ref, vtype, vl, vstart, vm, vd, [&](const uint8_t* src, size_t idx) {
+        return static_cast<dest_elem_t>(op(elem<VLEN, src2_elem_t>(src, vs2, idx)));
+    });
+    auto e = static_cast<entry>(random(3));
+    if(e == entry::prepared) // there are no prepared unary operations
+        e = entry::unit;
+    if(e == entry::runtime)
+        vector_unary_op<VLEN, dest_elem_t, src2_elem_t>(V, UNARY_OP, vl, vstart, vtype, vm, vd, vs2);
+    else if(e == entry::compile_time)
+        vector_unary_op<VLEN, UNARY_OP, dest_elem_t, src2_elem_t>(V, vl, vstart, vtype, vm, vd, vs2);
+    else
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            if(one_in(2))
+                unit.template vector_unary_op<dest_elem_t, src2_elem_t>(UNARY_OP, vm, vd, vs2);
+            else
+                unit.template vector_unary_op<UNARY_OP, dest_elem_t, src2_elem_t>(vm, vd, vs2);
+        });
+    check(same_regs<VLEN>(V, ref), "unary op 0x%02x SEW %zu/%zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u via %s",
+          UNARY_OP, sizeof(dest_elem_t) * 8, sizeof(src2_elem_t) * 8, VLEN, static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd,
+          entry_name(e));
+}
+} // namespace test
+} // namespace softvector
+#endif /* FUNCT_TEST_H */
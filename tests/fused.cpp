@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the fused sequences against their single instructions: the state after an access fault has to be the one of the single instructions
+// up to the faulting access, and resuming with the single instructions from there has to give the state of a run without fault
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned VFADD = 0b000000, VMSEQ = 0b011000;
+constexpr unsigned vd = 8, vs2 = 16;
+constexpr uint64_t load_base = 0x1000, store_base = 0x4000;
+
+template <typename T> T fadd(T a, T b) {
+    softfloat_roundingMode = softfloat_round_near_even;
+    if constexpr(sizeof(T) == 4)
+        return f32_add(float32_t{a}, float32_t{b}).v;
+    else
+        return f64_add(float64_t{a}, float64_t{b}).v;
+}
+
+// vle<EEW> vs2 from base, the loop of the specification up to the faulting element
+template <unsigned VLEN, typename T>
+bool reference_load(uint8_t* V, memory& mem, vtype_t vtype, uint64_t vl, uint64_t vstart, bool vm, uint64_t& fault_idx) {
+    for(size_t idx = vstart; idx < vl; idx++)
+        if(vm || mask_bit<VLEN>(V, 0, idx)) {
+            if(!load(&mem, load_base + idx * sizeof(T), sizeof(T), reinterpret_cast<uint8_t*>(&elem<VLEN, T>(V, vs2, idx)))) {
+                fault_idx = idx;
+                return false;
+            }
+        } else if(agnostic_ones && vtype.vma())
+            elem<VLEN, T>(V, vs2, idx) = static_cast<T>(~T(0));
+    return true;
+}
+template <unsigned VLEN, typename T> void reference_load_tail(uint8_t* V, vtype_t vtype, uint64_t vl) {
+    if(agnostic_ones && vtype.vta())
+        for(size_t idx = vl; idx < vtype.vlmax(VLEN, vtype.sew()); idx++)
+            elem<VLEN, T>(V, vs2, idx) = static_cast<T>(~T(0));
+}
+
+// vle<EEW> vs2; vfadd.vf vd, vs2, scalar; vse<EEW> vd, each instruction starting at its own vstart as after resuming a fault
+template <unsigned VLEN, typename T>
+vstatus_t reference_fp_store(uint8_t* V, memory& mem, vtype_t vtype, uint64_t vl, const uint64_t (&vstart)[3], bool vm, T scalar) {
+    uint64_t fault_idx;
+    if(!reference_load<VLEN, T>(V, mem, vtype, vl, vstart[0], vm, fault_idx))
+        return vstatus_t::fault(fault_idx, 0);
+    reference_load_tail<VLEN, T>(V, vtype, vl);
+    reference_loop<VLEN, T>(V, vtype, vl, vstart[1], vm, vd,
+                            [&](const uint8_t* src, size_t idx) { return fadd(elem<VLEN, T>(src, vs2, idx), scalar); });
+    for(size_t idx = vstart[2]; idx < vl; idx++)
+        if((vm || mask_bit<VLEN>(V, 0, idx)) &&
+           !store(&mem, store_base + idx * sizeof(T), sizeof(T), reinterpret_cast<uint8_t*>(&elem<VLEN, T>(V, vd, idx))))
+            return vstatus_t::fault(idx, 2);
+    return vstatus_t::ok();
+}
+// vle<EEW>[ff] vs2; vmseq.vx vd, vs2, scalar; vfirst.m rd, vd with the load starting at vstart[0] and the others at vstart[1]
+template <unsigned VLEN, typename T>
+vstatus_t reference_compare_first(uint8_t* V, memory& mem, vtype_t vtype, uint64_t& vl, const uint64_t (&vstart)[2], bool vm, T scalar,
+                                  bool fault_only_first, uint64_t& first) {
+    uint64_t fault_idx;
+    if(!reference_load<VLEN, T>(V, mem, vtype, vl, vstart[0], vm, fault_idx)) {
+        if(!fault_only_first || fault_idx == 0)
+            return vstatus_t::fault(fault_idx, 0);
+        vl = fault_idx;
+    }
+    reference_load_tail<VLEN, T>(V, vtype, vl);
+    reference_mask_loop<VLEN>(V, vtype, vl, vstart[1], vm, vd, VLEN,
+                              [&](const uint8_t* src, size_t idx) { return elem<VLEN, T>(src, vs2, idx) == scalar; });
+    first = -1;
+    for(size_t idx = vstart[1]; idx < vl && first == static_cast<uint64_t>(-1); idx++)
+        if((vm || mask_bit<VLEN>(V, 0, idx)) && mask_bit<VLEN>(V, vd, idx))
+            first = idx;
+    return vstatus_t::ok();
+}
+
+// the state of a run, V and mem are run through the fused sequence, ref through the reference
+template <unsigned VLEN, typename T> struct state {
+    alignas(64) uint8_t V[reg_file_size(VLEN)];
+    alignas(64) uint8_t ref[reg_file_size(VLEN)];
+    alignas(64) uint8_t initial[reg_file_size(VLEN)];
+    memory mem, ref_mem, initial_mem;
+    vtype_t vtype{uint64_t(0)};
+    uint64_t vl, vstart;
+    bool vm;
+    T scalar;
+    // fills everything randomly, the fault is injected into the load (source 0) or the store (source 1) of a random body element if any
+    bool init(unsigned fault_source) {
+        randomize<VLEN, T>(initial, vs2, 8);
+        for(size_t i = 0; i < sizeof(initial_mem.data) / sizeof(T); i++)
+            reinterpret_cast<T*>(initial_mem.data)[i] = edge_value<T>();
+        vtype = random_vtype<VLEN, T>();
+        if(vtype.vill())
+            return false;
+        vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+        vstart = random_vstart(vl);
+        vm = one_in(2);
+        scalar = edge_value<T>();
+        initial_mem.fault_addr = ~uint64_t(0);
+        if(fault_source < 2 && vl > vstart) {
+            uint64_t fault_idx = vstart + random(vl - vstart);
+            initial_mem.fault_addr = (fault_source ? store_base : load_base) + fault_idx * sizeof(T) + random(sizeof(T));
+        }
+        reset();
+        return true;
+    }
+    void reset() {
+        memcpy(V, initial, sizeof(V));
+        memcpy(ref, initial, sizeof(ref));
+        mem = initial_mem;
+        ref_mem = initial_mem;
+    }
+    // the fault is fixed up before resuming
+    void clear_fault() {
+        mem.fault_addr = ~uint64_t(0);
+        memcpy(ref, initial, sizeof(ref));
+        ref_mem = initial_mem;
+        ref_mem.fault_addr = ~uint64_t(0);
+    }
+};
+
+template <unsigned VLEN, typename T> void run_fp_store(unsigned fault_source) {
+    static state<VLEN, T> s;
+    if(!s.init(fault_source))
+        return;
+    vtype_t vtype = s.vtype;
+    vstatus_t status = fused_load_fp_store<VLEN, VFADD, T>(&s.mem, load, store, s.V, s.vl, s.vstart, vconfig_t(vtype, VLEN), s.vm, vd, vs2,
+                                                           load_base, s.scalar, store_base, 0);
+    vstatus_t ref_status = reference_fp_store<VLEN, T>(s.ref, s.ref_mem, vtype, s.vl, {s.vstart, s.vstart, s.vstart}, s.vm, s.scalar);
+    check(same_status(status, ref_status) && same_regs<VLEN>(s.V, s.ref) && same_memory(s.mem, s.ref_mem),
+          "fused vfadd SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d status %d/%u/%" PRIu64
+          ", expected %d/%u/%" PRIu64,
+          sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), s.vl, s.vstart, s.vm, status.code, status.op_idx, status.fault_idx,
+          ref_status.code, ref_status.op_idx, ref_status.fault_idx);
+    if(status.code != vstatus_t::FAULT)
+        return;
+    // the trap handler resumes the faulting instruction at fault_idx, the following ones start at 0
+    s.clear_fault();
+    uint64_t op_vstart = status.op_idx == 0 ? 0 : s.vstart;
+    if(status.op_idx == 0) {
+        try_vector_load_store<VLEN, T>(&s.mem, load, s.V, s.vl, status.fault_idx, vtype, s.vm, vs2, load_base, 1);
+        fp_vector_imm_op<VLEN, VFADD, OPFVF, T>(s.V, s.vl, 0, vtype, s.vm, vd, vs2, s.scalar, 0);
+    }
+    try_vector_load_store<VLEN, T>(&s.mem, store, s.V, s.vl, status.op_idx == 0 ? 0 : status.fault_idx, vtype, s.vm, vd, store_base, 1);
+    reference_fp_store<VLEN, T>(s.ref, s.ref_mem, vtype, s.vl, {s.vstart, op_vstart, op_vstart}, s.vm, s.scalar);
+    check(same_regs<VLEN>(s.V, s.ref) && same_memory(s.mem, s.ref_mem),
+          "fused vfadd resumed at op %u element %" PRIu64 " SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d",
+          status.op_idx, status.fault_idx, sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), s.vl, s.vstart, s.vm);
+}
+
+template <unsigned VLEN, typename T> void run_compare_first(bool fault) {
+    static state<VLEN, T> s;
+    if(!s.init(fault ? 0 : 2))
+        return;
+    vtype_t vtype = s.vtype;
+    bool fault_only_first = one_in(2);
+    uint64_t vl = s.vl, ref_vl = s.vl, first = 0, ref_first = 0;
+    vstatus_t status = fused_load_compare_first<VLEN, VMSEQ, T>(&s.mem, load, s.V, vl, s.vstart, vconfig_t(vtype, VLEN), s.vm, vd, vs2,
+                                                                load_base, s.scalar, fault_only_first, first);
+    vstatus_t ref_status = reference_compare_first<VLEN, T>(s.ref, s.ref_mem, vtype, ref_vl, {s.vstart, s.vstart}, s.vm, s.scalar,
+                                                            fault_only_first, ref_first);
+    check(same_status(status, ref_status) && same_regs<VLEN>(s.V, s.ref) && vl == ref_vl &&
+              (status.code != vstatus_t::OK || first == ref_first),
+          "fused vmseq/vfirst%s SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d status %d, expected %d, vl %" PRIu64
+          ", expected %" PRIu64 ", first %" PRId64 ", expected %" PRId64,
+          fault_only_first ? " ff" : "", sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), s.vl, s.vstart, s.vm, status.code,
+          ref_status.code, vl, ref_vl, static_cast<int64_t>(first), static_cast<int64_t>(ref_first));
+    if(status.code != vstatus_t::FAULT)
+        return;
+    s.clear_fault();
+    try_vector_load_store<VLEN, T>(&s.mem, load, s.V, s.vl, status.fault_idx, vtype, s.vm, vs2, load_base, 1);
+    mask_vector_imm_op<VLEN, VMSEQ, OPIVX, T>(s.V, s.vl, 0, vtype, s.vm, vd, vs2, static_cast<std::make_signed_t<T>>(s.scalar));
+    first = vfirst<VLEN>(s.V, s.vl, 0, s.vm, vd);
+    ref_vl = s.vl;
+    reference_compare_first<VLEN, T>(s.ref, s.ref_mem, vtype, ref_vl, {s.vstart, 0}, s.vm, s.scalar, false, ref_first);
+    check(same_regs<VLEN>(s.V, s.ref) && first == ref_first,
+          "fused vmseq/vfirst resumed at element %" PRIu64 " SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64
+          " vm %d first %" PRId64 ", expected %" PRId64,
+          status.fault_idx, sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), s.vl, s.vstart, s.vm, static_cast<int64_t>(first),
+          static_cast<int64_t>(ref_first));
+}
+
+template <unsigned VLEN> void run_all() {
+    for(unsigned fault_source : {0, 1, 2}) {
+        run_fp_store<VLEN, uint32_t>(fault_source);
+        run_fp_store<VLEN, uint64_t>(fault_source);
+    }
+    for(bool fault : {false, true}) {
+        run_compare_first<VLEN, uint8_t>(fault);
+        run_compare_first<VLEN, uint16_t>(fault);
+        run_compare_first<VLEN, uint32_t>(fault);
+        run_compare_first<VLEN, uint64_t>(fault);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 100);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("fused");
+}
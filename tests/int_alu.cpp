@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the single width integer ALU kernels (vadd, vsub, vrsub, logic, min/max, shifts) against the element operations of the specification
+#include "funct_test.h"
+#include <algorithm>
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+template <unsigned VLEN, typename T> void run_all() {
+    constexpr unsigned sew = sizeof(T) * 8;
+    check_funct<VLEN, T, T, T, 0b000000, OPIVV>([](T a, T b, T) { return as_unsigned(a) + b; });                   // VADD
+    check_funct<VLEN, T, T, T, 0b000001, OPIVV>([](T a, T b, T) { return a & ~b; });                               // VANDN
+    check_funct<VLEN, T, T, T, 0b000010, OPIVV>([](T a, T b, T) { return as_unsigned(a) - b; });                   // VSUB
+    check_funct<VLEN, T, T, T, 0b000011, OPIVV>(false, [](T a, T b, T) { return as_unsigned(b) - a; });            // VRSUB
+    check_funct<VLEN, T, T, T, 0b000100, OPIVV>([](T a, T b, T) { return std::min(a, b); });                       // VMINU
+    check_funct<VLEN, T, T, T, 0b000101, OPIVV>([](T a, T b, T) { return std::min(as_signed(a), as_signed(b)); }); // VMIN
+    check_funct<VLEN, T, T, T, 0b000110, OPIVV>([](T a, T b, T) { return std::max(a, b); });                       // VMAXU
+    check_funct<VLEN, T, T, T, 0b000111, OPIVV>([](T a, T b, T) { return std::max(as_signed(a), as_signed(b)); }); // VMAX
+    check_funct<VLEN, T, T, T, 0b001001, OPIVV>([](T a, T b, T) { return a & b; });                                // VAND
+    check_funct<VLEN, T, T, T, 0b001010, OPIVV>([](T a, T b, T) { return a | b; });                                // VOR
+    check_funct<VLEN, T, T, T, 0b001011, OPIVV>([](T a, T b, T) { return a ^ b; });                                // VXOR
+    check_funct<VLEN, T, T, T, 0b100101, OPIVV>([](T a, T b, T) { return as_unsigned(a) << (b % sew); });          // VSLL
+    check_funct<VLEN, T, T, T, 0b101000, OPIVV>([](T a, T b, T) { return as_unsigned(a) >> (b % sew); });          // VSRL
+    check_funct<VLEN, T, T, T, 0b101001, OPIVV>([](T a, T b, T) { return as_signed(a) >> (b % sew); });            // VSRA
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 100);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("int_alu");
+}
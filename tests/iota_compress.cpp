@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// viota.m, vid.v and vcompress.vm against an element-wise reference of the specification, and compress_mask_word against the plain
+// set-bit walk. The BMI2 and AVX-512 forms of compress_mask_word are only compiled in with the matching extensions enabled, so this
+// test is also built with -mbmi2 and with -mavx512f where the build host runs them
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned vd = 8, vs2 = 16, vs1 = 24;
+
+enum class op { viota, vid, vcompress };
+
+template <unsigned VLEN, typename T> void run(op o) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    randomize<VLEN, T>(V, vs2, 8);
+    // a sparse source mask now and then, so the running count of viota stays low
+    if(o == op::viota && one_in(2))
+        for(size_t i = 0; i < VLEN / 8; i++)
+            V[VLEN / 8 * vs2 + i] &= rng()();
+    vtype_t vtype = random_vtype<VLEN, T>();
+    if(vtype.vill())
+        return;
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    uint64_t vl = random_vl(vlmax);
+    // vcompress.vm requires vstart 0
+    uint64_t vstart = o == op::vcompress ? 0 : random_vstart(vl);
+    bool vm = o == op::vcompress || one_in(2);
+    memcpy(ref, V, sizeof(ref));
+    // viota and vid leave inactive and tail elements undisturbed, vcompress the elements between the packed ones and vl
+    uint64_t count = 0;
+    for(size_t idx = vstart; idx < vl; idx++) {
+        bool active = vm || mask_bit<VLEN>(V, 0, idx);
+        if(o == op::viota && active) {
+            elem<VLEN, T>(ref, vd, idx) = static_cast<T>(count);
+            count += mask_bit<VLEN>(V, vs2, idx);
+        } else if(o == op::vid && active)
+            elem<VLEN, T>(ref, vd, idx) = static_cast<T>(idx);
+        else if(o == op::vcompress && mask_bit<VLEN>(V, vs1, idx))
+            elem<VLEN, T>(ref, vd, count++) = elem<VLEN, T>(V, vs2, idx);
+    }
+    if(o == op::vcompress && agnostic_ones && vtype.vta())
+        for(size_t idx = vl; idx < vlmax; idx++)
+            elem<VLEN, T>(ref, vd, idx) = static_cast<T>(~T(0));
+
+    bool on_unit_entry = one_in(2);
+    if(on_unit_entry)
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            if(o == op::viota)
+                unit.template viota<T>(vm, vd, vs2);
+            else if(o == op::vid)
+                unit.template vid<T>(vm, vd);
+            else
+                unit.template vector_compress<T>(vd, vs2, vs1);
+        });
+    else if(o == op::viota)
+        viota<VLEN, T>(V, vl, vstart, vtype, vm, vd, vs2);
+    else if(o == op::vid)
+        vid<VLEN, T>(V, vl, vstart, vtype, vm, vd);
+    else
+        vector_compress<VLEN, T>(V, vl, vstart, vtype, vd, vs2, vs1);
+    static const char* names[] = {"viota", "vid", "vcompress"};
+    check(same_regs<VLEN>(V, ref), "%s SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d via %s",
+          names[static_cast<int>(o)], sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), vl, vstart, vm,
+          on_unit_entry ? "vector_unit" : "runtime");
+}
+
+// one block of 64 elements with all, no or random elements selected, the destination keeps its values beyond the packed ones
+template <unsigned VLEN, typename T> void run_compress_word() {
+    T src[64], dest[64], ref[64];
+    for(auto& val : src)
+        val = edge_value<T>();
+    for(auto& val : dest)
+        val = edge_value<T>();
+    memcpy(ref, dest, sizeof(ref));
+    uint64_t active = one_in(8) ? ~uint64_t(0) : one_in(8) ? 0 : rng()() & (one_in(2) ? rng()() : ~uint64_t(0));
+    size_t ref_count = 0;
+    for(unsigned bit = 0; bit < 64; bit++)
+        if(active >> bit & 1)
+            ref[ref_count++] = src[bit];
+    size_t count = compress_mask_word<VLEN>(dest, src, active);
+    check(count == ref_count && memcmp(dest, ref, sizeof(ref)) == 0, "compress_mask_word SEW %zu VLEN %u active 0x%016" PRIx64,
+          sizeof(T) * 8, VLEN, active);
+}
+
+template <unsigned VLEN, typename T> void run_all_ops() {
+    for(op o : {op::viota, op::vid, op::vcompress})
+        run<VLEN, T>(o);
+    run_compress_word<VLEN, T>();
+}
+template <unsigned VLEN> void run_all() {
+    run_all_ops<VLEN, uint8_t>();
+    run_all_ops<VLEN, uint16_t>();
+    run_all_ops<VLEN, uint32_t>();
+    run_all_ops<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 1000);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<32>();
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+#if defined(__AVX512F__)
+    return summary("iota_compress (AVX-512F)");
+#elif defined(__BMI2__)
+    return summary("iota_compress (BMI2)");
+#else
+    return summary("iota_compress");
+#endif
+}
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the mask logical operations, vcpop.m, vfirst.m and vmsbf/vmsif/vmsof.m against a bit-wise reference of the specification. They
+// work on 64 bit words of the mask registers, so vl and vstart fall anywhere in a word and VLEN 32 leaves the last word partial
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned vd = 8, vs2 = 16, vs1 = 24;
+constexpr unsigned VMSBF = 0b00001, VMSOF = 0b00010, VMSIF = 0b00011;
+
+// calls fn with funct6 of a mask logical operation as template argument
+template <typename fn_t> void with_mask_funct6(unsigned funct6, fn_t fn) {
+    switch(funct6) {
+    case 0b011000:
+        return fn(std::integral_constant<unsigned, 0b011000>());
+    case 0b011001:
+        return fn(std::integral_constant<unsigned, 0b011001>());
+    case 0b011010:
+        return fn(std::integral_constant<unsigned, 0b011010>());
+    case 0b011011:
+        return fn(std::integral_constant<unsigned, 0b011011>());
+    case 0b011100:
+        return fn(std::integral_constant<unsigned, 0b011100>());
+    case 0b011101:
+        return fn(std::integral_constant<unsigned, 0b011101>());
+    case 0b011110:
+        return fn(std::integral_constant<unsigned, 0b011110>());
+    default:
+        return fn(std::integral_constant<unsigned, 0b011111>());
+    }
+}
+template <typename fn_t> void with_mask_set_enc(unsigned enc, fn_t fn) {
+    switch(enc) {
+    case VMSBF:
+        return fn(std::integral_constant<unsigned, VMSBF>());
+    case VMSOF:
+        return fn(std::integral_constant<unsigned, VMSOF>());
+    default:
+        return fn(std::integral_constant<unsigned, VMSIF>());
+    }
+}
+bool mask_logical(unsigned funct6, bool a, bool b) {
+    switch(funct6) {
+    case 0b011000: // VMANDN
+        return a && !b;
+    case 0b011001: // VMAND
+        return a && b;
+    case 0b011010: // VMOR
+        return a || b;
+    case 0b011011: // VMXOR
+        return a != b;
+    case 0b011100: // VMORN
+        return a || !b;
+    case 0b011101: // VMNAND
+        return !(a && b);
+    case 0b011110: // VMNOR
+        return !(a || b);
+    default: // VMXNOR
+        return a == b;
+    }
+}
+// the tail of a mask result is all bits beyond vl and always agnostic
+template <unsigned VLEN> void reference_mask_tail(uint8_t* V, unsigned reg, uint64_t vl) {
+    if(agnostic_ones)
+        for(size_t idx = vl; idx < VLEN; idx++)
+            set_mask_bit<VLEN>(V, reg, idx, true);
+}
+
+// random registers, vs2 is sparse in half of the runs so vfirst and the set-before-first operations see their first hit anywhere.
+// vl is bounded by the vlmax of SEW 8 and random LMUL, which reaches VLEN
+template <unsigned VLEN> bool init(uint8_t* V, vtype_t& vtype, uint64_t& vl, uint64_t& vstart) {
+    randomize<VLEN, uint8_t>(V, vs2, 1);
+    if(one_in(2)) {
+        memset(V + VLEN / 8 * vs2, 0, VLEN / 8);
+        for(unsigned i = random(3); i > 0; i--)
+            set_mask_bit<VLEN>(V, vs2, random(VLEN), true);
+    }
+    vtype = random_vtype<VLEN, uint8_t>();
+    if(vtype.vill())
+        return false;
+    vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    vstart = random_vstart(vl);
+    return true;
+}
+
+template <unsigned VLEN> void run_logical(unsigned funct6) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype(uint64_t(0));
+    uint64_t vl, vstart;
+    if(!init<VLEN>(V, vtype, vl, vstart))
+        return;
+    // the destination may be one of the sources
+    unsigned dest = one_in(4) ? vs2 : one_in(3) ? vs1 : vd;
+    memcpy(ref, V, sizeof(ref));
+    for(size_t idx = vstart; idx < vl; idx++)
+        set_mask_bit<VLEN>(ref, dest, idx, mask_logical(funct6, mask_bit<VLEN>(V, vs2, idx), mask_bit<VLEN>(V, vs1, idx)));
+    reference_mask_tail<VLEN>(ref, dest, vl);
+
+    auto e = static_cast<entry>(random(3));
+    if(e == entry::prepared) // mask logical operations have no prepared form
+        e = entry::unit;
+    if(e == entry::runtime)
+        mask_mask_op<VLEN>(V, funct6, OPMVV, vl, vstart, dest, vs2, vs1);
+    else if(e == entry::compile_time)
+        with_mask_funct6(funct6, [&](auto f) { mask_mask_op<VLEN, decltype(f)::value, OPMVV>(V, vl, vstart, dest, vs2, vs1); });
+    else
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) { unit.mask_mask_op(funct6, OPMVV, dest, vs2, vs1); });
+    check(same_regs<VLEN>(V, ref), "mask logical 0x%02x VLEN %u vl %" PRIu64 " vstart %" PRIu64 " vd v%u via %s", funct6, VLEN, vl, vstart,
+          dest, entry_name(e));
+}
+
+template <unsigned VLEN> void run_count() {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    vtype_t vtype(uint64_t(0));
+    uint64_t vl, vstart;
+    if(!init<VLEN>(V, vtype, vl, vstart))
+        return;
+    bool vm = one_in(2);
+    uint64_t ref_count = 0, ref_first = -1;
+    for(size_t idx = vstart; idx < vl; idx++)
+        if((vm || mask_bit<VLEN>(V, 0, idx)) && mask_bit<VLEN>(V, vs2, idx)) {
+            ref_count++;
+            if(ref_first == static_cast<uint64_t>(-1))
+                ref_first = idx;
+        }
+    bool on_unit_entry = one_in(2);
+    uint64_t count, first;
+    if(on_unit_entry)
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            count = unit.vcpop(vm, vs2);
+            unit.vstart = vstart;
+            first = unit.vfirst(vm, vs2);
+        });
+    else {
+        count = vcpop<VLEN>(V, vl, vstart, vm, vs2);
+        first = vfirst<VLEN>(V, vl, vstart, vm, vs2);
+    }
+    check(count == ref_count && first == ref_first,
+          "vcpop/vfirst VLEN %u vl %" PRIu64 " vstart %" PRIu64 " vm %d: %" PRIu64 "/%" PRId64 ", expected %" PRIu64 "/%" PRId64
+          " via %s",
+          VLEN, vl, vstart, vm, count, static_cast<int64_t>(first), ref_count, static_cast<int64_t>(ref_first),
+          on_unit_entry ? "vector_unit" : "runtime");
+}
+
+template <unsigned VLEN> void run_set(unsigned enc) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype(uint64_t(0));
+    uint64_t vl, vstart;
+    if(!init<VLEN>(V, vtype, vl, vstart))
+        return;
+    bool vm = one_in(2);
+    memcpy(ref, V, sizeof(ref));
+    // the first active set bit of vs2 from vstart on, the inactive bits of vd are left undisturbed
+    bool found = false;
+    for(size_t idx = vstart; idx < vl; idx++) {
+        if(!vm && !mask_bit<VLEN>(V, 0, idx))
+            continue;
+        bool hit = !found && mask_bit<VLEN>(V, vs2, idx);
+        bool before = !found && !hit;
+        set_mask_bit<VLEN>(ref, vd, idx, enc == VMSBF ? before : enc == VMSOF ? hit : before || hit);
+        found = found || hit;
+    }
+    reference_mask_tail<VLEN>(ref, vd, vl);
+
+    auto e = static_cast<entry>(random(3));
+    if(e == entry::prepared)
+        e = entry::unit;
+    if(e == entry::runtime)
+        mask_set_op<VLEN>(V, enc, vl, vstart, vm, vd, vs2);
+    else if(e == entry::compile_time)
+        with_mask_set_enc(enc, [&](auto f) { mask_set_op<VLEN, decltype(f)::value>(V, vl, vstart, vm, vd, vs2); });
+    else
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) { unit.mask_set_op(enc, vm, vd, vs2); });
+    static const char* names[] = {"", "vmsbf", "vmsof", "vmsif"};
+    check(same_regs<VLEN>(V, ref), "%s VLEN %u vl %" PRIu64 " vstart %" PRIu64 " vm %d via %s", names[enc], VLEN, vl, vstart, vm,
+          entry_name(e));
+}
+
+template <unsigned VLEN> void run_all() {
+    for(unsigned funct6 = 0b011000; funct6 <= 0b011111; funct6++)
+        run_logical<VLEN>(funct6);
+    run_count<VLEN>();
+    for(unsigned enc : {VMSBF, VMSOF, VMSIF})
+        run_set<VLEN>(enc);
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 1000);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<32>();
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("mask");
+}
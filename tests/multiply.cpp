@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the single width and widening multiply and multiply-add kernels against the element operations of the specification, computed
+// in 128 bit
+#include "funct_test.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+template <unsigned VLEN, typename T> void run_all() {
+    constexpr unsigned sew = sizeof(T) * 8;
+    check_funct<VLEN, T, T, T, 0b100100, OPMVV>([](T a, T b, T) { return as_unsigned(a) * b >> sew; });          // VMULHU
+    check_funct<VLEN, T, T, T, 0b100101, OPMVV>([](T a, T b, T) { return as_unsigned(a) * b; });                 // VMUL
+    check_funct<VLEN, T, T, T, 0b100110, OPMVV>([](T a, T b, T) { return as_signed(a) * b >> sew; });            // VMULHSU
+    check_funct<VLEN, T, T, T, 0b100111, OPMVV>([](T a, T b, T) { return as_signed(a) * as_signed(b) >> sew; }); // VMULH
+    check_funct<VLEN, T, T, T, 0b101001, OPMVV>([](T a, T b, T d) { return as_unsigned(b) * d + a; });           // VMADD
+    check_funct<VLEN, T, T, T, 0b101011, OPMVV>([](T a, T b, T d) { return a - as_unsigned(b) * d; });           // VNMSUB
+    check_funct<VLEN, T, T, T, 0b101101, OPMVV>([](T a, T b, T d) { return as_unsigned(b) * a + d; });           // VMACC
+    check_funct<VLEN, T, T, T, 0b101111, OPMVV>([](T a, T b, T d) { return d - as_unsigned(b) * a; });           // VNMSAC
+    if constexpr(sizeof(T) < 8) {
+        typedef twice_t<T> W;
+        check_funct<VLEN, W, T, T, 0b111000, OPMVV>([](T a, T b, W) { return as_unsigned(a) * b; });                // VWMULU
+        check_funct<VLEN, W, T, T, 0b111010, OPMVV>([](T a, T b, W) { return as_signed(a) * b; });                  // VWMULSU
+        check_funct<VLEN, W, T, T, 0b111011, OPMVV>([](T a, T b, W) { return as_signed(a) * as_signed(b); });       // VWMUL
+        check_funct<VLEN, W, T, T, 0b111100, OPMVV>([](T a, T b, W d) { return as_unsigned(b) * a + d; });          // VWMACCU
+        check_funct<VLEN, W, T, T, 0b111101, OPMVV>([](T a, T b, W d) { return as_signed(b) * as_signed(a) + d; }); // VWMACC
+        check_funct<VLEN, W, T, T, 0b111110, OPMVV>(false, [](T a, T b, W d) { return as_signed(a) * b + d; });     // VWMACCUS
+        check_funct<VLEN, W, T, T, 0b111111, OPMVV>([](T a, T b, W d) { return as_signed(b) * a + d; });            // VWMACCSU
+    }
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 100);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("multiply");
+}
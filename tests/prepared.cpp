@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the prepared operations against the unprepared entry points: every funct6 of every family is prepared and executed on one copy of
+// a register file and run through the runtime entry point on another. An encoding without kernel has to give an empty prepared_op
+// that returns illegal and leaves the registers alone
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+// the random state of a run, the same for both paths
+struct run_t {
+    vtype_t vtype;
+    uint64_t vl;
+    uint64_t vstart;
+    bool vm;
+    uint64_t scalar;
+    uint8_t rm;
+};
+constexpr unsigned vd = 8, vs2 = 16, vs1 = 24;
+// prepare(run) gives the prepared_op, direct(V, run) runs the unprepared entry point and returns vxsat
+template <unsigned VLEN, typename sew_t, typename prepare_t, typename direct_t>
+void check_prepared(const char* family, unsigned funct6, prepare_t prepare, direct_t direct) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    // LMUL up to 4, so a widening destination stays within v8 to v15
+    run_t run{random_vtype<VLEN, sew_t>(2), 0, 0, one_in(2), rng()(), static_cast<uint8_t>(random(4))};
+    if(run.vtype.vill())
+        return;
+    run.vl = random_vl(run.vtype.vlmax(VLEN, run.vtype.sew()));
+    run.vstart = random_vstart(run.vl);
+    randomize<VLEN, sew_t>(V, vd, 24);
+    memcpy(ref, V, sizeof(ref));
+    prepared_op<VLEN> op = prepare(run);
+    vstatus_t status = op(V, run.vl, run.vstart, run.scalar, run.rm);
+    if(!op.exec) {
+        check(status.code == vstatus_t::ILLEGAL_INSTRUCTION && !op.elem_fn && !op.vm && !op.vd && !op.vs2 && !op.vs1 && !op.core &&
+                  same_regs<VLEN>(V, ref),
+              "%s funct6 0x%02x SEW %zu VLEN %u: unsupported encoding", family, funct6, sizeof(sew_t) * 8, VLEN);
+        return;
+    }
+    bool vxsat = direct(ref, run);
+    check(status.code == vstatus_t::OK && status.vxsat == vxsat && same_regs<VLEN>(V, ref),
+          "%s funct6 0x%02x SEW %zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d rm %u", family, funct6,
+          sizeof(sew_t) * 8, VLEN, static_cast<unsigned>(run.vtype.underlying), run.vl, run.vstart, run.vm, run.rm);
+}
+// the integer families of element type T, dest_t is T or the widened type
+template <unsigned VLEN, typename dest_t, typename T> void run_int(unsigned funct6) {
+    typedef std::make_signed_t<T> imm_t;
+    for(unsigned funct3 : {OPIVV, OPMVV}) {
+        check_prepared<VLEN, T>(
+            "vector_vector", funct6,
+            [&](const run_t& r) { return prepare_vector_vector_op<VLEN, dest_t, T, T>(funct6, funct3, r.vtype, r.vm, vd, vs2, vs1); },
+            [&](uint8_t* V, const run_t& r) {
+                vector_vector_op<VLEN, dest_t, T, T>(V, funct6, funct3, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1);
+                return false;
+            });
+        check_prepared<VLEN, T>(
+            "sat_vector_vector", funct6,
+            [&](const run_t& r) { return prepare_sat_vector_vector_op<VLEN, dest_t, T, T>(funct6, funct3, r.vtype, r.vm, vd, vs2, vs1); },
+            [&](uint8_t* V, const run_t& r) {
+                return sat_vector_vector_op<VLEN, dest_t, T, T>(V, funct6, funct3, r.vl, r.vstart, r.vtype, r.rm, r.vm, vd, vs2, vs1);
+            });
+        check_prepared<VLEN, T>(
+            "vector_red", funct6,
+            [&](const run_t& r) { return prepare_vector_red_op<VLEN, dest_t, T>(funct6, funct3, r.vtype, r.vm, vd, vs2, vs1); },
+            [&](uint8_t* V, const run_t& r) {
+                vector_red_op<VLEN, dest_t, T>(V, funct6, funct3, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1);
+                return false;
+            });
+    }
+    for(unsigned funct3 : {OPIVX, OPIVI, OPMVX}) {
+        check_prepared<VLEN, T>(
+            "vector_imm", funct6,
+            [&](const run_t& r) { return prepare_vector_imm_op<VLEN, dest_t, T, T>(funct6, funct3, r.vtype, r.vm, vd, vs2); },
+            [&](uint8_t* V, const run_t& r) {
+                vector_imm_op<VLEN, dest_t, T, T>(V, funct6, funct3, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, static_cast<imm_t>(r.scalar));
+                return false;
+            });
+        check_prepared<VLEN, T>(
+            "sat_vector_imm", funct6,
+            [&](const run_t& r) { return prepare_sat_vector_imm_op<VLEN, dest_t, T, T>(funct6, funct3, r.vtype, r.vm, vd, vs2); },
+            [&](uint8_t* V, const run_t& r) {
+                return sat_vector_imm_op<VLEN, dest_t, T, T>(V, funct6, funct3, r.vl, r.vstart, r.vtype, r.rm, r.vm, vd, vs2,
+                                                             static_cast<imm_t>(r.scalar));
+            });
+    }
+    if constexpr(std::is_same_v<dest_t, T>) {
+        check_prepared<VLEN, T>(
+            "mask_vector_vector", funct6,
+            [&](const run_t& r) { return prepare_mask_vector_vector_op<VLEN, T>(funct6, OPIVV, r.vtype, r.vm, vd, vs2, vs1); },
+            [&](uint8_t* V, const run_t& r) {
+                mask_vector_vector_op<VLEN, T>(V, funct6, OPIVV, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1);
+                return false;
+            });
+        check_prepared<VLEN, T>(
+            "mask_vector_imm", funct6,
+            [&](const run_t& r) { return prepare_mask_vector_imm_op<VLEN, T>(funct6, OPIVX, r.vtype, r.vm, vd, vs2); },
+            [&](uint8_t* V, const run_t& r) {
+                mask_vector_imm_op<VLEN, T>(V, funct6, OPIVX, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, static_cast<imm_t>(r.scalar));
+                return false;
+            });
+    }
+}
+// the floating-point families of element type T, dest_t is T or the widened type. The element functions throw for a widening
+// encoding of single width types, so the caller picks the types from funct6. The rounding mode is one of the four vxrm values, all of
+// them valid frm values
+template <unsigned VLEN, typename dest_t, typename T> void run_fp(unsigned funct6) {
+    check_prepared<VLEN, T>(
+        "fp_vector_vector", funct6,
+        [&](const run_t& r) { return prepare_fp_vector_vector_op<VLEN, dest_t, T, T>(funct6, OPFVV, r.vtype, r.vm, vd, vs2, vs1); },
+        [&](uint8_t* V, const run_t& r) {
+            fp_vector_vector_op<VLEN, dest_t, T, T>(V, funct6, OPFVV, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1, r.rm);
+            return false;
+        });
+    check_prepared<VLEN, T>(
+        "fp_vector_imm", funct6,
+        [&](const run_t& r) { return prepare_fp_vector_imm_op<VLEN, dest_t, T, T>(funct6, OPFVF, r.vtype, r.vm, vd, vs2); },
+        [&](uint8_t* V, const run_t& r) {
+            fp_vector_imm_op<VLEN, dest_t, T, T>(V, funct6, OPFVF, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, static_cast<T>(r.scalar), r.rm);
+            return false;
+        });
+    check_prepared<VLEN, T>(
+        "fp_vector_red", funct6,
+        [&](const run_t& r) { return prepare_fp_vector_red_op<VLEN, dest_t, T>(funct6, OPFVV, r.vtype, r.vm, vd, vs2, vs1); },
+        [&](uint8_t* V, const run_t& r) {
+            fp_vector_red_op<VLEN, dest_t, T>(V, funct6, OPFVV, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1, r.rm);
+            return false;
+        });
+    if constexpr(std::is_same_v<dest_t, T>) {
+        check_prepared<VLEN, T>(
+            "mask_fp_vector_vector", funct6,
+            [&](const run_t& r) { return prepare_mask_fp_vector_vector_op<VLEN, T>(funct6, r.vtype, r.vm, vd, vs2, vs1); },
+            [&](uint8_t* V, const run_t& r) {
+                mask_fp_vector_vector_op<VLEN, T>(V, funct6, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, vs1, r.rm);
+                return false;
+            });
+        check_prepared<VLEN, T>(
+            "mask_fp_vector_imm", funct6,
+            [&](const run_t& r) { return prepare_mask_fp_vector_imm_op<VLEN, T>(funct6, r.vtype, r.vm, vd, vs2); },
+            [&](uint8_t* V, const run_t& r) {
+                mask_fp_vector_imm_op<VLEN, T>(V, funct6, r.vl, r.vstart, r.vtype, r.vm, vd, vs2, static_cast<T>(r.scalar), r.rm);
+                return false;
+            });
+    }
+}
+template <unsigned VLEN> void run_all() {
+    for(unsigned funct6 = 0; funct6 < 64; funct6++) {
+        run_int<VLEN, uint8_t, uint8_t>(funct6);
+        run_int<VLEN, uint16_t, uint16_t>(funct6);
+        run_int<VLEN, uint32_t, uint32_t>(funct6);
+        run_int<VLEN, uint64_t, uint64_t>(funct6);
+        run_int<VLEN, uint16_t, uint8_t>(funct6);
+        run_int<VLEN, uint32_t, uint16_t>(funct6);
+        run_int<VLEN, uint64_t, uint32_t>(funct6);
+        if(funct6 < 0b110000) {
+            run_fp<VLEN, uint32_t, uint32_t>(funct6);
+            run_fp<VLEN, uint64_t, uint64_t>(funct6);
+        } else
+            run_fp<VLEN, uint64_t, uint32_t>(funct6);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 3);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("prepared");
+}
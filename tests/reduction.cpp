@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the integer reduction kernels against a reference fold of the specification, including vd overlapping vs2 or vs1 and the tail of a
+// widening destination
+#include "test_util.h"
+#include <algorithm>
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+// edge values in vs2 or, now and then, all ones or all zeros with a rare other value so VREDAND and VREDOR stop early
+template <unsigned VLEN, typename src_elem_t> void randomize_red(uint8_t* V, unsigned vs2) {
+    randomize<VLEN, src_elem_t>(V, vs2, 8);
+    unsigned kind = random(4);
+    if(kind < 2)
+        for(size_t idx = 0; idx < VLEN / 8 * 8 / sizeof(src_elem_t); idx++)
+            elem<VLEN, src_elem_t>(V, vs2, idx) =
+                one_in(64) ? static_cast<src_elem_t>(rng()()) : kind ? static_cast<src_elem_t>(~src_elem_t(0)) : 0;
+}
+// the reduction of the specification: element 0 of vd is vs1[0] folded with op(total, vs2[idx]) over the active elements, both read
+// before vd is written. The tail is the rest of the vd register in the destination EEW. Element 0 is written for vl 0 as well, as
+// the element loops always did
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename op_t>
+void reference_red(uint8_t* V, op_t op, vtype_t vtype, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, unsigned vs2, unsigned vs1) {
+    dest_elem_t total = elem<VLEN, dest_elem_t>(V, vs1, 0);
+    for(size_t idx = vstart; idx < vl; idx++)
+        if(vm || mask_bit<VLEN>(V, 0, idx))
+            total = static_cast<dest_elem_t>(op(total, elem<VLEN, src_elem_t>(V, vs2, idx)));
+    elem<VLEN, dest_elem_t>(V, vd, 0) = total;
+    if(agnostic_ones && vtype.vta())
+        for(size_t idx = 1; idx < VLEN / 8 / sizeof(dest_elem_t); idx++)
+            elem<VLEN, dest_elem_t>(V, vd, idx) = static_cast<dest_elem_t>(~dest_elem_t(0));
+}
+// runs the reduction FUNCT6 through a random entry point and through reference_red, vd is one of the sources in half of the runs for
+// single width reductions
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, unsigned FUNCT6, unsigned FUNCT3, typename op_t>
+void check_red(op_t op) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype = random_vtype<VLEN, src_elem_t>(sizeof(dest_elem_t) == sizeof(src_elem_t) ? 3 : 2);
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vs2 = 16, vs1 = 24, vd = 8;
+    if(sizeof(dest_elem_t) == sizeof(src_elem_t) && one_in(2))
+        vd = one_in(2) ? vs2 : vs1;
+    randomize_red<VLEN, src_elem_t>(V, vs2);
+    memcpy(ref, V, sizeof(ref));
+    reference_red<VLEN, dest_elem_t, src_elem_t>(ref, op, vtype, vl, vstart, vm, vd, vs2, vs1);
+    auto e = static_cast<entry>(random(static_cast<unsigned>(entry::count)));
+    switch(e) {
+    case entry::runtime:
+        vector_red_op<VLEN, dest_elem_t, src_elem_t>(V, FUNCT6, FUNCT3, vl, vstart, vtype, vm, vd, vs2, vs1);
+        break;
+    case entry::compile_time:
+        vector_red_op<VLEN, FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(V, vl, vstart, vtype, vm, vd, vs2, vs1);
+        break;
+    case entry::prepared:
+        prepare_vector_red_op<VLEN, dest_elem_t, src_elem_t>(FUNCT6, FUNCT3, vtype, vm, vd, vs2, vs1)(V, vl, vstart);
+        break;
+    default:
+        on_unit<VLEN>(V, vtype, vl, vstart, [&](vector_unit<VLEN>& unit) {
+            if(one_in(2))
+                unit.template vector_red_op<dest_elem_t, src_elem_t>(FUNCT6, FUNCT3, vm, vd, vs2, vs1);
+            else
+                unit.template vector_red_op<FUNCT6, FUNCT3, dest_elem_t, src_elem_t>(vm, vd, vs2, vs1);
+        });
+        break;
+    }
+    check(same_regs<VLEN>(V, ref),
+          "reduction 0x%02x SEW %zu/%zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u vs1 v%u via %s", FUNCT6,
+          sizeof(dest_elem_t) * 8, sizeof(src_elem_t) * 8, VLEN, static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd, vs1,
+          entry_name(e));
+}
+// runs vector_red_loop, the element loop behind the reductions without a SIMD kernel, with the element function op and compares it
+// to reference_red. vd is one of the sources in half of the runs for single width reductions
+template <unsigned VLEN, typename dest_elem_t, typename src_elem_t, typename op_t> void check_red_loop(op_t op) {
+    alignas(64) static uint8_t V[reg_file_size(VLEN)];
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    vtype_t vtype = random_vtype<VLEN, src_elem_t>(sizeof(dest_elem_t) == sizeof(src_elem_t) ? 3 : 2);
+    if(vtype.vill())
+        return;
+    uint64_t vl = random_vl(vtype.vlmax(VLEN, vtype.sew()));
+    uint64_t vstart = random_vstart(vl);
+    bool vm = one_in(2);
+    unsigned vs2 = 16, vs1 = 24, vd = 8;
+    if(sizeof(dest_elem_t) == sizeof(src_elem_t) && one_in(2))
+        vd = one_in(2) ? vs2 : vs1;
+    randomize_red<VLEN, src_elem_t>(V, vs2);
+    memcpy(ref, V, sizeof(ref));
+    reference_red<VLEN, dest_elem_t, src_elem_t>(ref, op, vtype, vl, vstart, vm, vd, vs2, vs1);
+    auto fn = [&op](dest_elem_t& total, src_elem_t a) { total = static_cast<dest_elem_t>(op(total, a)); };
+    vector_red_loop<VLEN, dest_elem_t, src_elem_t>(V, fn, vl, vstart, vconfig_t(vtype, VLEN), vm, vd, vs2, vs1);
+    check(same_regs<VLEN>(V, ref), "vector_red_loop SEW %zu/%zu VLEN %u vtype 0x%02x vl %" PRIu64 " vstart %" PRIu64 " vm %d vd v%u",
+          sizeof(dest_elem_t) * 8, sizeof(src_elem_t) * 8, VLEN, static_cast<unsigned>(vtype.underlying), vl, vstart, vm, vd);
+}
+template <unsigned VLEN, typename T> void run_all() {
+    check_red<VLEN, T, T, 0b000000, OPMVV>([](T total, T a) { return as_unsigned(total) + a; });                   // VREDSUM
+    check_red<VLEN, T, T, 0b000001, OPMVV>([](T total, T a) { return total & a; });                                // VREDAND
+    check_red<VLEN, T, T, 0b000010, OPMVV>([](T total, T a) { return total | a; });                                // VREDOR
+    check_red<VLEN, T, T, 0b000011, OPMVV>([](T total, T a) { return total ^ a; });                                // VREDXOR
+    check_red<VLEN, T, T, 0b000100, OPMVV>([](T total, T a) { return std::min(total, a); });                       // VREDMINU
+    check_red<VLEN, T, T, 0b000101, OPMVV>([](T total, T a) { return std::min(as_signed(total), as_signed(a)); }); // VREDMIN
+    check_red<VLEN, T, T, 0b000110, OPMVV>([](T total, T a) { return std::max(total, a); });                       // VREDMAXU
+    check_red<VLEN, T, T, 0b000111, OPMVV>([](T total, T a) { return std::max(as_signed(total), as_signed(a)); }); // VREDMAX
+    if constexpr(sizeof(T) < 8) {
+        typedef twice_t<T> W;
+        check_red<VLEN, W, T, 0b110000, OPIVV>([](W total, T a) { return as_unsigned(total) + a; });            // VWREDSUMU
+        check_red<VLEN, W, T, 0b110001, OPIVV>([](W total, T a) { return as_unsigned(total) + as_signed(a); }); // VWREDSUM
+        check_red_loop<VLEN, W, T>([](W total, T a) { return as_unsigned(total) + a; });
+    }
+    check_red_loop<VLEN, T, T>([](T total, T a) { return as_unsigned(total) + a; });
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    run_all<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 200);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("reduction");
+}
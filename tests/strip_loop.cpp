@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// vector_unit::strip_loop against the single-stepped loop it replaces. The body adds a scalar to an array in memory, vle<EEW> vs2,
+// (src); vadd.vx vd, vs2, x; vse<EEW> vd, (dst), and the pointers are bumped by vl elements per strip. A load or store of one
+// element may fault, then the loop has to stop with avl, the pointers, vl and vstart of the single-stepped loop
+#include "test_util.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned VADD = 0b000000;
+constexpr unsigned vd = 8, vs2 = 16;
+constexpr uint64_t src_base = 0x1000, dst_base = 0x4000;
+
+// the loop state next to the register file and memory
+struct loop_state {
+    uint64_t avl, src, dst, vl, vstart;
+};
+
+template <unsigned VLEN, typename T>
+vstatus_t reference(uint8_t* V, memory& mem, loop_state& s, vtype_t vtype, T x) {
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    while(s.avl) {
+        s.vl = std::min(s.avl, vlmax);
+        s.vstart = 0;
+        for(size_t idx = 0; idx < s.vl; idx++)
+            if(!load(&mem, s.src + idx * sizeof(T), sizeof(T), reinterpret_cast<uint8_t*>(&elem<VLEN, T>(V, vs2, idx)))) {
+                s.vstart = idx;
+                return vstatus_t::fault(idx, 0);
+            }
+        if(agnostic_ones && vtype.vta())
+            for(size_t idx = s.vl; idx < vlmax; idx++)
+                elem<VLEN, T>(V, vs2, idx) = static_cast<T>(~T(0));
+        reference_loop<VLEN, T>(V, vtype, s.vl, 0, true, vd,
+                                [&](const uint8_t* src, size_t idx) { return static_cast<T>(elem<VLEN, T>(src, vs2, idx) + x); });
+        for(size_t idx = 0; idx < s.vl; idx++)
+            if(!store(&mem, s.dst + idx * sizeof(T), sizeof(T), reinterpret_cast<uint8_t*>(&elem<VLEN, T>(V, vd, idx)))) {
+                s.vstart = idx;
+                return vstatus_t::fault(idx, 2);
+            }
+        s.src += s.vl * sizeof(T);
+        s.dst += s.vl * sizeof(T);
+        s.avl -= s.vl;
+    }
+    return vstatus_t::ok();
+}
+
+template <unsigned VLEN, typename T> void run() {
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    static memory mem, ref_mem;
+    static vector_unit<VLEN> unit;
+    // LMUL up to 1, so four strips of the largest group stay within the source and destination arrays
+    vtype_t vtype = random_vtype<VLEN, T>(0);
+    if(vtype.vill())
+        return;
+    uint64_t vlmax = vtype.vlmax(VLEN, vtype.sew());
+    randomize<VLEN, T>(unit.V, vs2, 1);
+    for(size_t i = 0; i < sizeof(mem.data) / sizeof(T); i++)
+        reinterpret_cast<T*>(mem.data)[i] = edge_value<T>();
+    unit.invalidate_v0();
+    // vl and vstart of an earlier instruction, an empty loop keeps them
+    unit.vsetvl(random(vlmax + 1), vtype);
+    unit.vstart = random_vstart(unit.vl);
+    uint64_t avl = one_in(8) ? 0 : random(4 * vlmax) + 1;
+    mem.fault_addr = ~uint64_t(0);
+    if(avl && one_in(2))
+        mem.fault_addr = (one_in(2) ? src_base : dst_base) + random(avl * sizeof(T));
+    memcpy(ref, unit.V, sizeof(ref));
+    ref_mem = mem;
+    loop_state s{avl, src_base, dst_base, unit.vl, unit.vstart}, ref_s = s;
+    T x = edge_value<T>();
+    uint64_t scalar = static_cast<uint64_t>(x);
+
+    prepared_op<VLEN> ops[] = {prepare_load_store_op<VLEN, T>(&mem, load, vtype, true, vs2),
+                               prepare_vector_imm_op<VLEN, T>(VADD, OPIVX, vtype, true, vd, vs2),
+                               prepare_load_store_op<VLEN, T>(&mem, store, vtype, true, vd)};
+    const uint64_t* scalars[] = {&s.src, &scalar, &s.dst};
+    unsigned shift = __builtin_ctz(sizeof(T));
+    strip_update_t updates[] = {{&s.src, shift}, {&s.dst, shift}};
+    vstatus_t status = unit.strip_loop(s.avl, vtype, ops, scalars, 3, updates, 2);
+    s.vl = unit.vl;
+    s.vstart = unit.vstart;
+    vstatus_t ref_status = reference<VLEN, T>(ref, ref_mem, ref_s, vtype, x);
+    check(same_status(status, ref_status) && same_regs<VLEN>(unit.V, ref) && same_memory(mem, ref_mem) && s.avl == ref_s.avl &&
+              s.src == ref_s.src && s.dst == ref_s.dst && s.vl == ref_s.vl && s.vstart == ref_s.vstart,
+          "strip_loop SEW %zu VLEN %u vtype 0x%02x avl %" PRIu64 " fault at 0x%" PRIx64 ": status %d op %u, expected %d op %u, avl %" PRIu64
+          ", expected %" PRIu64 ", vl %" PRIu64 ", expected %" PRIu64 ", vstart %" PRIu64 ", expected %" PRIu64,
+          sizeof(T) * 8, VLEN, static_cast<unsigned>(vtype.underlying), avl, mem.fault_addr, status.code, status.op_idx, ref_status.code,
+          ref_status.op_idx, s.avl, ref_s.avl, s.vl, ref_s.vl, s.vstart, ref_s.vstart);
+}
+
+template <unsigned VLEN> void run_all() {
+    run<VLEN, uint8_t>();
+    run<VLEN, uint16_t>();
+    run<VLEN, uint32_t>();
+    run<VLEN, uint64_t>();
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 200);
+    for(unsigned i = 0; i < count; i++) {
+        run_all<64>();
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("strip_loop");
+}
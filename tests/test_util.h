@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector_unit.h>
+namespace softvector {
+namespace test {
+// Every test runs an operation through one of its entry points and through a reference model written from the specification in the
+// test itself, starting from the same register file, and compares the register files and any returned status afterwards. The operands
+// are random with a bias towards the edge values of their type, vtype, vl, vstart and the mask are random as well.
+constexpr size_t reg_file_size(unsigned vlen) { return vlen * RFS / 8; }
+#ifdef AGNOSTIC_ONES
+constexpr bool agnostic_ones = true;
+#else
+constexpr bool agnostic_ones = false;
+#endif
+
+// the entry points an operation can be reached through, all of them have to select the same kernel
+enum class entry { runtime, compile_time, prepared, unit, count };
+inline const char* entry_name(entry e) {
+    switch(e) {
+    case entry::runtime:
+        return "runtime";
+    case entry::compile_time:
+        return "compile-time";
+    case entry::prepared:
+        return "prepared";
+    case entry::unit:
+        return "vector_unit";
+    default:
+        return "?";
+    }
+}
+
+inline std::mt19937_64& rng() {
+    static std::mt19937_64 gen(0x5eed);
+    return gen;
+}
+// uniform in [0, bound)
+inline uint64_t random(uint64_t bound) { return rng()() % bound; }
+inline bool one_in(uint64_t n) { return random(n) == 0; }
+
+// 0, 1, all ones, the signed minimum or maximum in half of the draws, a random value otherwise
+template <typename T> T edge_value() {
+    switch(random(10)) {
+    case 0:
+        return 0;
+    case 1:
+        return 1;
+    case 2:
+        return static_cast<T>(~T(0));
+    case 3:
+        return static_cast<T>(T(1) << (sizeof(T) * 8 - 1));
+    case 4:
+        return static_cast<T>(~T(0)) >> 1;
+    default:
+        return static_cast<T>(rng()());
+    }
+}
+// random bytes, count registers from reg on hold edge values of T. v0 is all ones or all zeros now and then, so the kernels see fully
+// active and fully inactive mask words as well
+template <unsigned VLEN, typename T> void randomize(uint8_t* V, unsigned reg, unsigned count) {
+    for(size_t i = 0; i < reg_file_size(VLEN); i++)
+        V[i] = rng()();
+    auto elems = reinterpret_cast<T*>(V + VLEN / 8 * reg);
+    for(size_t idx = 0; idx < VLEN / 8 * count / sizeof(T); idx++)
+        elems[idx] = edge_value<T>();
+    if(one_in(5))
+        memset(V, 0xff, VLEN / 8);
+    else if(one_in(5))
+        memset(V, 0, VLEN / 8);
+}
+// vtype with SEW of sew_t and LMUL from 1/8 up to 2^max_lmul_log2, vta and vma are random. Returns vill if vlmax would be 0
+template <unsigned VLEN, typename sew_t> vtype_t random_vtype(int max_lmul_log2 = 3) {
+    int lmul_log2 = static_cast<int>(random(4 + max_lmul_log2)) - 3;
+    uint64_t sew_bits = __builtin_ctz(sizeof(sew_t)) << 3;
+    vtype_t vtype(sew_bits | (static_cast<uint64_t>(lmul_log2) & 0b111) | random(4) << 6);
+    return vconfig_t(vtype, VLEN).vlmax ? vtype : vtype_t(uint64_t(1) << 63);
+}
+// vl == vlmax in most runs, which the full-block kernels need
+inline uint64_t random_vl(uint64_t vlmax) { return one_in(3) ? random(vlmax + 1) : vlmax; }
+// vstart > 0 in a quarter of the runs
+inline uint64_t random_vstart(uint64_t vl) { return vl && one_in(4) ? random(vl) : 0; }
+
+// element idx of EEW T in the register group starting at reg
+template <unsigned VLEN, typename T> T& elem(uint8_t* V, unsigned reg, size_t idx) {
+    return reinterpret_cast<T*>(V + VLEN / 8 * reg)[idx];
+}
+template <unsigned VLEN, typename T> T elem(const uint8_t* V, unsigned reg, size_t idx) {
+    return reinterpret_cast<const T*>(V + VLEN / 8 * reg)[idx];
+}
+template <unsigned VLEN> bool mask_bit(const uint8_t* V, unsigned reg, size_t idx) { return V[VLEN / 8 * reg + idx / 8] >> idx % 8 & 1; }
+template <unsigned VLEN> void set_mask_bit(uint8_t* V, unsigned reg, size_t idx, bool bit) {
+    uint8_t& byte = V[VLEN / 8 * reg + idx / 8];
+    byte = static_cast<uint8_t>((byte & ~(1 << idx % 8)) | bit << idx % 8);
+}
+// the operands sign or zero extended to 128 bit, wide enough for every product and sum of two elements of up to 64 bit
+template <typename T> __int128 as_signed(T val) { return static_cast<std::make_signed_t<T>>(val); }
+template <typename T> unsigned __int128 as_unsigned(T val) { return val; }
+
+// the element loop of the specification for an operation writing elements of dest_elem_t to vd. result(src, idx) gives element idx,
+// src is a copy of the register file taken before anything is written. Active body elements from vstart to vl get their result,
+// inactive ones are set to all ones if vma and the tail up to vlmax is if vta when agnostic elements are filled with ones, all others
+// keep their value
+template <unsigned VLEN, typename dest_elem_t, typename result_t>
+void reference_loop(uint8_t* V, vtype_t vtype, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, result_t result) {
+    alignas(64) static uint8_t src[reg_file_size(VLEN)];
+    memcpy(src, V, sizeof(src));
+    for(size_t idx = vstart; idx < vl; idx++)
+        if(vm || mask_bit<VLEN>(src, 0, idx))
+            elem<VLEN, dest_elem_t>(V, vd, idx) = result(src, idx);
+        else if(agnostic_ones && vtype.vma())
+            elem<VLEN, dest_elem_t>(V, vd, idx) = static_cast<dest_elem_t>(~dest_elem_t(0));
+    if(agnostic_ones && vtype.vta())
+        for(size_t idx = vl; idx < vtype.vlmax(VLEN, vtype.sew()); idx++)
+            elem<VLEN, dest_elem_t>(V, vd, idx) = static_cast<dest_elem_t>(~dest_elem_t(0));
+}
+// the same for an operation writing the bits of the mask register vd, the tail ends with bit tail_end
+template <unsigned VLEN, typename result_t>
+void reference_mask_loop(uint8_t* V, vtype_t vtype, uint64_t vl, uint64_t vstart, bool vm, unsigned vd, uint64_t tail_end,
+                         result_t result) {
+    alignas(64) static uint8_t src[reg_file_size(VLEN)];
+    memcpy(src, V, sizeof(src));
+    for(size_t idx = vstart; idx < vl; idx++)
+        if(vm || mask_bit<VLEN>(src, 0, idx))
+            set_mask_bit<VLEN>(V, vd, idx, result(src, idx));
+        else if(agnostic_ones && vtype.vma())
+            set_mask_bit<VLEN>(V, vd, idx, true);
+    if(agnostic_ones && vtype.vta())
+        for(size_t idx = vl; idx < tail_end; idx++)
+            set_mask_bit<VLEN>(V, vd, idx, true);
+}
+
+struct stats {
+    unsigned runs = 0;
+    unsigned failures = 0;
+};
+inline stats& totals() {
+    static stats s;
+    return s;
+}
+// counts a run, reports the first failures with a description printed like printf
+inline bool check(bool ok, const char* format, ...) __attribute__((format(printf, 2, 3)));
+inline bool check(bool ok, const char* format, ...) {
+    totals().runs++;
+    if(!ok && totals().failures++ < 10) {
+        va_list args;
+        va_start(args, format);
+        printf("FAIL: ");
+        vprintf(format, args);
+        printf("\n");
+        va_end(args);
+    }
+    return ok;
+}
+// true if both register files are equal, prints the first differing byte otherwise
+template <unsigned VLEN> bool same_regs(const uint8_t* V, const uint8_t* ref) {
+    for(size_t i = 0; i < reg_file_size(VLEN); i++)
+        if(V[i] != ref[i]) {
+            printf("  v%zu byte %zu: 0x%02x, expected 0x%02x\n", i / (VLEN / 8), i % (VLEN / 8), V[i], ref[i]);
+            return false;
+        }
+    return true;
+}
+
+// runs fn on a vector_unit holding V with the given vtype, vl and vstart, and copies its registers back to V
+template <unsigned VLEN, typename fn_t> void on_unit(uint8_t* V, vtype_t vtype, uint64_t vl, uint64_t vstart, fn_t fn) {
+    static vector_unit<VLEN> unit;
+    memcpy(unit.V, V, reg_file_size(VLEN));
+    unit.invalidate_v0();
+    unit.vsetvl(vl, vtype);
+    unit.vstart = vstart;
+    fn(unit);
+    memcpy(V, unit.V, reg_file_size(VLEN));
+}
+
+// a flat guest memory with at most one faulting byte, passed as core to the access callbacks load and store
+struct memory {
+    uint8_t data[0x8000];
+    uint64_t fault_addr = ~uint64_t(0);
+    bool faults(uint64_t addr, uint64_t length) const { return addr <= fault_addr && fault_addr < addr + length; }
+};
+inline bool load(void* core, uint64_t addr, uint64_t length, uint8_t* data) noexcept {
+    auto mem = static_cast<memory*>(core);
+    if(mem->faults(addr, length))
+        return false;
+    memcpy(data, mem->data + addr, length);
+    return true;
+}
+inline bool store(void* core, uint64_t addr, uint64_t length, uint8_t* data) noexcept {
+    auto mem = static_cast<memory*>(core);
+    if(mem->faults(addr, length))
+        return false;
+    memcpy(mem->data + addr, data, length);
+    return true;
+}
+inline bool same_memory(const memory& a, const memory& b) { return memcmp(a.data, b.data, sizeof(a.data)) == 0; }
+inline bool same_status(vstatus_t a, vstatus_t b) {
+    return a.code == b.code && (a.code != vstatus_t::FAULT || (a.op_idx == b.op_idx && a.fault_idx == b.fault_idx));
+}
+
+// iterations from the first argument if given
+inline unsigned iterations(int argc, char* argv[], unsigned default_count) {
+    return argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 0)) : default_count;
+}
+inline int summary(const char* name) {
+    printf("%s: %u runs, %u failures%s\n", name, totals().runs, totals().failures, agnostic_ones ? " (AGNOSTIC_ONES)" : "");
+    return totals().failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+} // namespace test
+} // namespace softvector
+#endif /* TEST_UTIL_H */
@@ -0,0 +1,482 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+// the masked loops of vector_unit read v0 expanded to lanes, cached until v0 is written again. Every member writing a register has to
+// drop the cache if that register is v0: a masked operation fills the cache, v0 is written through one of the members, and the next
+// masked operation has to see the new v0
+#include "test_util.h"
+#include <vector>
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+constexpr unsigned VADD = 0b000000, VSADDU = 0b100000, VMSEQ = 0b011000, VMADC = 0b010001, VADC = 0b010000, VMAND = 0b011001;
+constexpr unsigned VREDSUM = 0b000000, VFADD = 0b000000, VFREDUSUM = 0b000001, VMFEQ = 0b011000, VFUNARY1 = 0b010011;
+constexpr unsigned VBREV8 = 0b01000, VMSBF = 0b00001, VFSQRT = 0b00000, VFWCVT_XU_F = 0b01000, VFNCVT_XU_F = 0b10000;
+constexpr unsigned VAES_VS = 0b101001, VAESZ = 0b00111, VAESKF1 = 0b100010, VGHSH = 0b101100, VSHA2MS = 0b101101;
+constexpr unsigned vd = 8, vs2 = 16, vs1 = 24;
+constexpr uint64_t load_base = 0x100, store_base = 0x1000;
+
+memory mem;
+
+// vsetvli with avl above vlmax, LMUL 2^lmul_log2
+template <unsigned VLEN, typename T> void set_vtype(vector_unit<VLEN>& unit, unsigned lmul_log2 = 0) {
+    unit.vsetvl(~uint64_t(0), vtype_t(uint64_t(__builtin_ctz(sizeof(T)) << 3 | lmul_log2)));
+}
+
+// a member of vector_unit writing v0 (as data, mask or carry-out register), after setting the vtype it needs. vadc/vsbc and the
+// masked forms can not write v0, the crypto operations need element groups of 128 bits
+template <unsigned VLEN> struct writer {
+    const char* name;
+    void (*write)(vector_unit<VLEN>& unit);
+};
+template <unsigned VLEN> const std::vector<writer<VLEN>>& writers() {
+    using unit_t = vector_unit<VLEN>;
+    static const std::vector<writer<VLEN>> list = {
+        {"execute",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.execute(prepare_vector_vector_op<VLEN, uint8_t>(VADD, OPIVV, u.vtype(), true, 0, vs2, vs1));
+         }},
+        {"execute_block",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             auto op = prepare_vector_imm_op<VLEN, uint8_t>(VADD, OPIVX, u.vtype(), true, 0, vs2);
+             uint64_t scalar = 3;
+             u.execute_block(&op, &scalar, 1);
+         }},
+        {"strip_loop",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             auto op = prepare_vector_imm_op<VLEN, uint8_t>(VADD, OPIVX, u.vtype(), true, 0, vs2);
+             uint64_t avl = VLEN / 8;
+             u.strip_loop(avl, u.vtype(), &op, nullptr, 1, nullptr, 0);
+         }},
+        {"vector_load_store",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_load_store<uint8_t>(&mem, load, true, 0, load_base, 1);
+         }},
+        {"vector_load_store_index",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_load_store_index<64, uint8_t, uint8_t>(&mem, load, true, 0, load_base, vs2, 1);
+         }},
+        {"vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_op<uint8_t>(VADD, OPIVV, true, 0, vs2, vs1);
+         }},
+        {"vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_op<VADD, OPIVV, uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_op<uint8_t>(VADD, OPIVX, true, 0, vs2, 5);
+         }},
+        {"vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_op<VADD, OPIVX, uint8_t>(true, 0, vs2, 5);
+         }},
+        {"vector_vector_merge",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_merge<uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"vector_imm_merge",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_merge<uint8_t>(true, 0, vs2, 0x5a);
+         }},
+        {"vector_unary_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_unary_op<uint8_t>(VBREV8, true, 0, vs2);
+         }},
+        {"vector_unary_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_unary_op<VBREV8, uint8_t>(true, 0, vs2);
+         }},
+        {"mask_vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_vector_vector_op<uint8_t>(VMSEQ, OPIVV, true, 0, vs2, vs1);
+         }},
+        {"mask_vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_vector_vector_op<VMSEQ, OPIVV, uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"mask_vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_vector_imm_op<uint8_t>(VMSEQ, OPIVX, true, 0, vs2, 0);
+         }},
+        {"mask_vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_vector_imm_op<VMSEQ, OPIVX, uint8_t>(true, 0, vs2, 0);
+         }},
+        {"carry_vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template carry_vector_vector_op<uint8_t>(VMADC, true, 0, vs2, vs1);
+         }},
+        {"carry_vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template carry_vector_vector_op<VMADC, uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"carry_vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template carry_vector_imm_op<uint8_t>(VMADC, true, 0, vs2, -1);
+         }},
+        {"carry_vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template carry_vector_imm_op<VMADC, uint8_t>(true, 0, vs2, -1);
+         }},
+        {"vector_vector_carry_chain",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_carry_chain<uint8_t>(VADC, vd, 0, vs2, vs1);
+         }},
+        {"vector_vector_carry_chain<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_carry_chain<VADC, uint8_t>(vd, 0, vs2, vs1);
+         }},
+        {"vector_imm_carry_chain",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_carry_chain<uint8_t>(VADC, vd, 0, vs2, -1);
+         }},
+        {"vector_imm_carry_chain<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_carry_chain<VADC, uint8_t>(vd, 0, vs2, -1);
+         }},
+        {"sat_vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template sat_vector_vector_op<uint8_t>(VSADDU, OPIVV, true, 0, vs2, vs1);
+         }},
+        {"sat_vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template sat_vector_vector_op<VSADDU, OPIVV, uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"sat_vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template sat_vector_imm_op<uint8_t>(VSADDU, OPIVX, true, 0, vs2, 7);
+         }},
+        {"sat_vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template sat_vector_imm_op<VSADDU, OPIVX, uint8_t>(true, 0, vs2, 7);
+         }},
+        {"vector_red_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_red_op<uint8_t>(VREDSUM, OPMVV, true, 0, vs2, vs1);
+         }},
+        {"vector_red_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_red_op<VREDSUM, OPMVV, uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"mask_mask_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.mask_mask_op(VMAND, OPMVV, 0, vs2, vs1);
+         }},
+        {"mask_mask_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_mask_op<VMAND, OPMVV>(0, vs2, vs1);
+         }},
+        {"mask_set_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.mask_set_op(VMSBF, true, 0, vs2);
+         }},
+        {"mask_set_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             u.template mask_set_op<VMSBF>(true, 0, vs2);
+         }},
+        {"viota",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template viota<uint8_t>(true, 0, vs2);
+         }},
+        {"vid",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vid<uint8_t>(true, 0);
+         }},
+        {"scalar_move",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template scalar_move<uint8_t>(0, rng()(), true);
+         }},
+        {"vector_slideup",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_slideup<uint8_t>(true, 0, vs2, 3);
+         }},
+        {"vector_slidedown",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_slidedown<uint8_t>(true, 0, vs2, 3);
+         }},
+        {"vector_slide1up",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_slide1up<uint8_t>(true, 0, vs2, 0x5a);
+         }},
+        {"vector_slide1down",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_slide1down<uint8_t>(true, 0, vs2, 0x5a);
+         }},
+        {"vector_vector_gather",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_vector_gather<uint8_t>(true, 0, vs2, vs1);
+         }},
+        {"vector_imm_gather",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_imm_gather<uint8_t>(true, 0, vs2, 1);
+         }},
+        {"vector_compress",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.template vector_compress<uint8_t>(0, vs2, vs1);
+         }},
+        {"vector_whole_move",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             u.vector_whole_move(0, vs2, 1);
+         }},
+        {"fp_vector_red_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_red_op<uint32_t>(VFREDUSUM, OPFVV, true, 0, vs2, vs1);
+         }},
+        {"fp_vector_red_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_red_op<VFREDUSUM, OPFVV, uint32_t>(true, 0, vs2, vs1);
+         }},
+        {"fp_vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_vector_op<uint32_t>(VFADD, OPFVV, true, 0, vs2, vs1);
+         }},
+        {"fp_vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_vector_op<VFADD, OPFVV, uint32_t>(true, 0, vs2, vs1);
+         }},
+        {"fp_vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_imm_op<uint32_t>(VFADD, OPFVF, true, 0, vs2, 0x3f800000);
+         }},
+        {"fp_vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_imm_op<VFADD, OPFVF, uint32_t>(true, 0, vs2, 0x3f800000);
+         }},
+        {"fp_vector_unary_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_op<uint32_t>(VFUNARY1, VFSQRT, true, 0, vs2);
+         }},
+        {"fp_vector_unary_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_op<VFUNARY1, VFSQRT, uint32_t>(true, 0, vs2);
+         }},
+        {"fp_vector_unary_w",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_w<uint64_t, uint32_t>(VFWCVT_XU_F, true, 0, vs2);
+         }},
+        {"fp_vector_unary_w<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_w<VFWCVT_XU_F, uint64_t, uint32_t>(true, 0, vs2);
+         }},
+        {"fp_vector_unary_n",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_n<uint32_t, uint64_t>(VFNCVT_XU_F, true, 0, vs2);
+         }},
+        {"fp_vector_unary_n<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fp_vector_unary_n<VFNCVT_XU_F, uint32_t, uint64_t>(true, 0, vs2);
+         }},
+        {"mask_fp_vector_vector_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u, 3);
+             u.template mask_fp_vector_vector_op<uint32_t>(VMFEQ, true, 0, vs2, vs1);
+         }},
+        {"mask_fp_vector_vector_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u, 3);
+             u.template mask_fp_vector_vector_op<VMFEQ, uint32_t>(true, 0, vs2, vs1);
+         }},
+        {"mask_fp_vector_imm_op",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u, 3);
+             u.template mask_fp_vector_imm_op<uint32_t>(VMFEQ, true, 0, vs2, 0);
+         }},
+        {"mask_fp_vector_imm_op<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u, 3);
+             u.template mask_fp_vector_imm_op<VMFEQ, uint32_t>(true, 0, vs2, 0);
+         }},
+        {"vector_vector_crypto",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_vector_crypto<4>(VGHSH, 0, vs2, vs1);
+         }},
+        {"vector_vector_crypto<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_vector_crypto<VGHSH, 0, 4>(0, vs2, vs1);
+         }},
+        {"vector_scalar_crypto",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_scalar_crypto<4>(VAES_VS, 0, vs2, VAESZ);
+         }},
+        {"vector_scalar_crypto<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_scalar_crypto<VAES_VS, VAESZ, 4>(0, vs2);
+         }},
+        {"vector_imm_crypto",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_imm_crypto<4>(VAESKF1, 0, vs2, 1);
+         }},
+        {"vector_imm_crypto<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_imm_crypto<VAESKF1, 4>(0, vs2, 1);
+         }},
+        {"vector_crypto",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_crypto<4, uint32_t>(VSHA2MS, 0, vs2, vs1);
+         }},
+        {"vector_crypto<>",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template vector_crypto<VSHA2MS, 4, uint32_t>(0, vs2, vs1);
+         }},
+        // the loaded register is v0, the result goes elsewhere
+        {"fused_load_fp_store",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint32_t>(u);
+             u.template fused_load_fp_store<VFADD, uint32_t>(&mem, load, store, true, vd, 0, load_base, 0x3f800000, store_base);
+         }},
+        {"fused_load_compare_first",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u);
+             uint64_t first;
+             u.template fused_load_compare_first<VMSEQ, uint8_t>(&mem, load, true, vd, 0, load_base, 0, false, first);
+         }},
+        {"fused_load_compare_first to v0",
+         [](unit_t& u) {
+             set_vtype<VLEN, uint8_t>(u, 3);
+             uint64_t first;
+             u.template fused_load_compare_first<VMSEQ, uint8_t>(&mem, load, true, 0, vs2, load_base, 0, false, first);
+         }},
+    };
+    return list;
+}
+
+// vadd.vv vd, vs2, vs1, v0.t over a register group of 8, with the lanes of v0 cached by vector_unit
+template <unsigned VLEN, typename T> void masked_add(vector_unit<VLEN>& unit) {
+    set_vtype<VLEN, T>(unit, 3);
+    unit.template vector_vector_op<VADD, OPIVV, T>(false, vd, vs2, vs1);
+}
+
+template <unsigned VLEN, typename T> void run(const writer<VLEN>& w) {
+    static vector_unit<VLEN> unit;
+    alignas(64) static uint8_t ref[reg_file_size(VLEN)];
+    randomize<VLEN, T>(unit.V, vs2, 16);
+    unit.invalidate_v0();
+    masked_add<VLEN, T>(unit);
+    w.write(unit);
+    memcpy(ref, unit.V, sizeof(ref));
+    masked_add<VLEN, T>(unit);
+    reference_loop<VLEN, T>(ref, unit.vtype(), unit.vl, 0, false, vd, [](const uint8_t* src, size_t idx) {
+        return static_cast<T>(elem<VLEN, T>(src, vs2, idx) + elem<VLEN, T>(src, vs1, idx));
+    });
+    check(same_regs<VLEN>(unit.V, ref), "masked vadd SEW %zu VLEN %u after writing v0 with %s", sizeof(T) * 8, VLEN, w.name);
+}
+
+template <unsigned VLEN> void run_all() {
+    for(auto& w : writers<VLEN>()) {
+        run<VLEN, uint8_t>(w);
+        run<VLEN, uint16_t>(w);
+    }
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 100);
+    for(size_t i = 0; i < sizeof(mem.data); i++)
+        mem.data[i] = rng()();
+    for(unsigned i = 0; i < count; i++) {
+        run_all<128>();
+        run_all<256>();
+        run_all<1024>();
+    }
+    return summary("v0_cache");
+}
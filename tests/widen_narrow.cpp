@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025, MINRES Technologies GmbH
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+// Contributors:
+//       alex@minres.com - initial API and implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// the widening add/sub and shift, narrowing shift and extension kernels against the element operations of the specification
+#include "funct_test.h"
+
+using namespace softvector;
+using namespace softvector::test;
+
+namespace {
+template <unsigned VLEN, typename N> void run_all() {
+    typedef twice_t<N> W;
+    constexpr unsigned wide_sew = sizeof(W) * 8;
+    check_funct<VLEN, W, N, N, 0b110000, OPMVV>([](N a, N b, W) { return as_unsigned(a) + b; });               // VWADDU
+    check_funct<VLEN, W, N, N, 0b110001, OPMVV>([](N a, N b, W) { return as_signed(a) + as_signed(b); });      // VWADD
+    check_funct<VLEN, W, N, N, 0b110010, OPMVV>([](N a, N b, W) { return as_unsigned(a) - b; });               // VWSUBU
+    check_funct<VLEN, W, N, N, 0b110011, OPMVV>([](N a, N b, W) { return as_signed(a) - as_signed(b); });      // VWSUB
+    check_funct<VLEN, W, W, N, 0b110100, OPMVV>([](W a, N b, W) { return as_unsigned(a) + b; });               // VWADDU.W
+    check_funct<VLEN, W, W, N, 0b110101, OPMVV>([](W a, N b, W) { return as_signed(a) + as_signed(b); });      // VWADD.W
+    check_funct<VLEN, W, W, N, 0b110110, OPMVV>([](W a, N b, W) { return as_unsigned(a) - b; });               // VWSUBU.W
+    check_funct<VLEN, W, W, N, 0b110111, OPMVV>([](W a, N b, W) { return as_signed(a) - as_signed(b); });      // VWSUB.W
+    check_funct<VLEN, W, N, N, 0b110101, OPIVV>([](N a, N b, W) { return as_unsigned(a) << (b % wide_sew); }); // VWSLL
+    check_funct<VLEN, N, W, N, 0b101100, OPIVV>([](W a, N b, N) { return as_unsigned(a) >> (b % wide_sew); }); // VNSRL
+    check_funct<VLEN, N, W, N, 0b101101, OPIVV>([](W a, N b, N) { return as_signed(a) >> (b % wide_sew); });   // VNSRA
+    check_unary<VLEN, W, N, 0b00110>([](N a) { return as_unsigned(a); });                                      // VZEXT.VF2
+    check_unary<VLEN, W, N, 0b00111>([](N a) { return as_signed(a); });                                        // VSEXT.VF2
+}
+template <unsigned VLEN> void run_all_sew() {
+    run_all<VLEN, uint8_t>();
+    run_all<VLEN, uint16_t>();
+    run_all<VLEN, uint32_t>();
+    check_unary<VLEN, uint32_t, uint8_t, 0b00100>([](uint8_t a) { return as_unsigned(a); });   // VZEXT.VF4
+    check_unary<VLEN, uint32_t, uint8_t, 0b00101>([](uint8_t a) { return as_signed(a); });     // VSEXT.VF4
+    check_unary<VLEN, uint64_t, uint16_t, 0b00100>([](uint16_t a) { return as_unsigned(a); }); // VZEXT.VF4
+    check_unary<VLEN, uint64_t, uint16_t, 0b00101>([](uint16_t a) { return as_signed(a); });   // VSEXT.VF4
+    check_unary<VLEN, uint64_t, uint8_t, 0b00010>([](uint8_t a) { return as_unsigned(a); });   // VZEXT.VF8
+    check_unary<VLEN, uint64_t, uint8_t, 0b00011>([](uint8_t a) { return as_signed(a); });     // VSEXT.VF8
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned count = iterations(argc, argv, 150);
+    for(unsigned i = 0; i < count; i++) {
+        run_all_sew<64>();
+        run_all_sew<128>();
+        run_all_sew<256>();
+        run_all_sew<1024>();
+    }
+    return summary("widen_narrow");
+}